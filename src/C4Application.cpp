@@ -450,8 +450,10 @@ void C4Application::Execute()
 			// Save back time
 			iLastGameTick = iThisGameTick;
 		}
-		// Graphics
-		if (!Game.DoSkipFrame)
+		// Graphics; not while benchmarking
+		if (Game.Benchmark.IsRunning())
+			Game.DoSkipFrame = false;
+		else if (!Game.DoSkipFrame)
 		{
 			uint32_t iPreGfxTime = timeGetTime();
 			// Fullscreen mode
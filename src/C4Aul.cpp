@@ -468,6 +468,7 @@ void C4AulScriptEngine::Clear()
 	GlobalConsts.SetNameList(&GlobalConstNames);
 	GlobalNamed.Reset();
 	GlobalNamed.SetNameList(&GlobalNamedNames);
+	BytecodeCache.Clear();
 }
 
 void C4AulScriptEngine::UnLink()
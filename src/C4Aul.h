@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <C4AulBytecodeCache.h>
+#include <C4AulProfiler.h>
 #include <C4AulScriptStrict.h>
 #include <C4ValueList.h>
 #include <C4ValueMap.h>
@@ -217,6 +219,15 @@ enum C4AulBCCType
 	AB_CONDN,            // conditional jump (negated, pops stack)
 	AB_FOREACH_NEXT,     // foreach: next element in array
 	AB_FOREACH_MAP_NEXT, // foreach: next key-value pair in map
+	// superinstructions, see C4AulOptimizer
+	AB_INT_OP,                 // int constant and operator
+	AB_VARN_V_INT_OP,          // named var, int constant and operator
+	AB_LOCALN_V_INT_OP,        // named local, int constant and operator
+	AB_VARN_R_INC,             // ++/-- statement on a named var
+	AB_LessThan_CONDN,         // comparison and conditional jump
+	AB_LessThanEqual_CONDN,
+	AB_GreaterThan_CONDN,
+	AB_GreaterThanEqual_CONDN,
 	AB_RETURN,           // return statement
 	AB_ERR,              // parse error at this position
 	AB_EOFN,             // end of function
@@ -268,7 +279,7 @@ struct C4AulScriptContext : public C4AulContext
 	bool TemporaryScript;
 	C4ValueList NumVars;
 	C4AulBCC *CPos;
-	time_t tTime; // initialized only by profiler if active
+	C4AulProfiler::Frame ProfilerFrame; // set only if the profiler is active
 
 	size_t ParCnt() const { return Vars - Pars; }
 	void dump(std::string Dump = "");
@@ -281,6 +292,7 @@ class C4AulFunc
 	friend class C4AulScriptEngine;
 	friend class C4AulFuncMap;
 	friend class C4AulParseState;
+	friend class C4AulBytecodeCache;
 
 public:
 	C4AulFunc(C4AulScript *pOwner, const char *pName, bool bAtEnd = true);
@@ -347,7 +359,7 @@ public:
 
 	C4AulScriptFunc(C4AulScript *pOwner, const char *pName, bool bAtEnd = true) : C4AulFunc(pOwner, pName, bAtEnd),
 		idImage(C4ID_None), iImagePhase(0), Condition(nullptr), ControlMethod(C4AUL_ControlMethod_All), OwnerOverloaded(nullptr),
-		bReturnRef(false), tProfileTime(0)
+		bReturnRef(false)
 	{
 		for (int i = 0; i < C4AUL_MAX_Par; i++) ParType[i] = C4V_Any;
 	}
@@ -364,8 +376,6 @@ public:
 
 	std::string GetFullName(); // get a fully classified name (C4ID::Name) for debug output
 
-	time_t tProfileTime; // internally set by profiler
-
 	bool HasStrictNil() const noexcept;
 
 	friend class C4AulScript;
@@ -403,34 +413,6 @@ enum C4AulScriptState
 	ASS_PARSED     // byte code generated
 };
 
-// script profiler entry
-class C4AulProfiler
-{
-private:
-	// map entry
-	struct Entry
-	{
-		C4AulScriptFunc *pFunc;
-		time_t tProfileTime;
-
-		bool operator<(const Entry &e2) const { return tProfileTime < e2.tProfileTime; }
-	};
-
-	// items
-	std::vector<Entry> Times;
-	std::shared_ptr<spdlog::logger> logger;
-
-public:
-	C4AulProfiler(std::shared_ptr<spdlog::logger> logger) : logger{std::move(logger)} {}
-
-	void CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime);
-	void Show();
-
-	static void Abort();
-	static void StartProfiling(C4AulScript *pScript);
-	static void StopProfiling();
-};
-
 // script class
 class C4AulScript
 {
@@ -473,16 +455,18 @@ protected:
 
 	void AddBCC(C4AulBCCType eType, std::intptr_t = 0, const char *SPos = nullptr); // add byte code chunk and advance
 	bool Preparse(); // preparse script; return if successful
+	void LinkOverloads(C4AulScriptFunc *Fn); // find the function overloaded by Fn
 	void ParseFn(C4AulScriptFunc *Fn, bool fExprOnly = false); // parse single script function
 
 	bool Parse(); // parse preparsed script; return if successful
+	void Optimize(); // optimize the parsed byte code
 	void ParseDescs(); // parse function descs
 
 	bool ResolveIncludes(C4DefList *rDefs); // resolve includes
 	bool ResolveAppends(C4DefList *rDefs); // resolve appends
 	bool IncludesResolved;
 	void AppendTo(C4AulScript &Scr, bool bHighPrio); // append to given script
-	void UnLink(); // reset to unlinked state
+	virtual void UnLink(); // reset to unlinked state
 	virtual void AfterLink(); // called after linking is completed; presearch common funcs here & search same-named funcs
 	virtual bool ReloadScript(const char *szPath); // reload given script
 
@@ -511,8 +495,7 @@ public:
 
 public:
 	C4Value DirectExec(C4Object *pObj, const char *szScript, const char *szContext, bool fPassErrors = false, C4AulScriptStrict Strict = C4AulScriptStrict::MAXSTRICT); // directly parse uncompiled script (WARG! CYCLES!)
-	void ResetProfilerTimes(); // zero all profiler times of owned functions
-	void CollectProfilerTimes(class C4AulProfiler &rProfiler);
+	void CollectProfilerFuncs(C4AulProfiler &rProfiler); // list owned functions in the profiler report
 
 	bool IsReady() { return State == ASS_PARSED; } // whether script calls may be done
 
@@ -524,6 +507,7 @@ public:
 	friend class C4AulScriptFunc;
 	friend class C4AulScriptEngine;
 	friend class C4AulParseState;
+	friend class C4AulBytecodeCache;
 };
 
 // holds all C4AulScripts
@@ -543,6 +527,8 @@ public:
 
 	C4StringTable Strings;
 
+	C4AulBytecodeCache BytecodeCache;
+
 	// global constants (such as "static const C4D_Structure = 2;")
 	// cannot share var lists, because it's so closely tied to the data lists
 	// constants are used by the Parser only, anyway, so it's not
@@ -580,7 +566,7 @@ public:
 	bool GetGlobalConstant(const char *szName, C4Value *pTargetValue); // check if a constant exists; assign value to pTargetValue if not nullptr
 
 	bool DenumerateVariablePointers();
-	void UnLink(); // called when a script is being reloaded (clears string table)
+	void UnLink() override; // called when a script is being reloaded (clears string table)
 	// Compile scenario script data (without strings and constants)
 	void CompileFunc(StdCompiler *pComp);
 
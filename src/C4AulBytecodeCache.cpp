@@ -0,0 +1,477 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4AulBytecodeCache.h>
+
+#include <C4Application.h>
+#include <C4Aul.h>
+#include <C4AulOptimizer.h>
+#include <C4Components.h>
+#include <C4Config.h>
+#include <C4Game.h>
+#include <C4Version.h>
+#include <C4Wrappers.h>
+
+#include <algorithm>
+#include <format>
+#include <string_view>
+
+namespace
+{
+	// increase whenever the byte code or the cache format changes
+	constexpr std::int32_t FormatVersion = 2;
+	// number of cache files (one per set of scripts) kept in the user path
+	constexpr std::size_t MaxFiles = 8;
+
+	enum class ChunkRef
+	{
+		None,
+		Func,
+		String
+	};
+
+	ChunkRef GetChunkRef(std::int32_t type) noexcept
+	{
+		switch (type)
+		{
+		case AB_FUNC: case AB_CALL: case AB_CALLFS: case AB_CALLGLOBAL:
+			return ChunkRef::Func;
+		case AB_STRING: case AB_MAPA_R: case AB_MAPA_V:
+			return ChunkRef::String;
+		default:
+			return ChunkRef::None;
+		}
+	}
+
+	bool IsJumpType(std::int32_t type) noexcept
+	{
+		return type == AB_JUMP || type == AB_JUMPAND || type == AB_JUMPOR || type == AB_CONDN || type == AB_JUMPNIL || type == AB_JUMPNOTNIL || type == AB_NilCoalescingIt;
+	}
+
+	class Hasher
+	{
+	public:
+		template<typename T>
+		void Add(const T &value) { sha.Update(&value, sizeof(value)); }
+		void AddString(std::string_view str)
+		{
+			Add(static_cast<std::uint32_t>(str.size()));
+			sha.Update(str.data(), str.size());
+		}
+
+		void AddNames(const C4ValueMapNames &names)
+		{
+			Add(names.iSize);
+			for (std::int32_t i = 0; i < names.iSize; ++i)
+				AddString(names.pNames[i]);
+		}
+
+		template<typename T>
+		T GetHash()
+		{
+			T result;
+			sha.GetHash(result.data());
+			return result;
+		}
+
+	private:
+		StdSha1 sha;
+	};
+}
+
+void C4AulBytecodeCache::Chunk::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(Type, "Type"));
+	pComp->Value(mkNamingAdapt(X,    "X"));
+	pComp->Value(mkNamingAdapt(SPos, "SPos"));
+}
+
+void C4AulBytecodeCache::Entry::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(Key,                           "Key"));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(Code),     "Code"));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(FuncCode), "FuncCode"));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(Strings),  "Strings"));
+}
+
+void C4AulBytecodeCache::File::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(Version, "Version"));
+	// do not bother reading entries of other versions
+	if (Version != FormatVersion) return;
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(Entries), "Entries"));
+}
+
+void C4AulBytecodeCache::Begin(C4AulScriptEngine &engine)
+{
+	Clear();
+	if (!Logger) Logger = Application.LogSystem.GetOrCreate("C4AulBytecodeCache");
+	pEngine = &engine;
+	// all functions byte code may refer to
+	AddFuncs(engine);
+	HashNamespace();
+	// every set of scripts gets its own file, so switching scenarios does not drop the cache
+	Filename = std::format("{}" DirSep "{}.c4b", Config.AtUserPath(C4CFN_ScriptCache), HashToString(NamespaceHash));
+	StdBuf buf;
+	if (!buf.LoadFromFile(Filename.c_str())) return;
+	File file{};
+	try
+	{
+		CompileFromBuf<StdCompilerBinRead>(file, buf);
+	}
+	catch (const StdCompiler::Exception &e)
+	{
+		Logger->warn("Ignoring corrupt byte code cache {}: {}", Filename, e.what());
+		return;
+	}
+	if (file.Version != FormatVersion) return;
+	for (auto &entry : file.Entries)
+	{
+		std::string key{entry.Key};
+		Entries.emplace(std::move(key), std::move(entry));
+	}
+}
+
+void C4AulBytecodeCache::End()
+{
+	if (!pEngine) return;
+	// rewrite if anything was parsed or some entries were not used by this link
+	if (fChanged || !Entries.empty())
+	{
+		File file{FormatVersion, std::move(Stored)};
+		const char *path{Config.AtUserPath(C4CFN_ScriptCache)};
+		if (!DirectoryExists(path)) MakeDirectory(path, nullptr);
+		try
+		{
+			if (!DecompileToBuf<StdCompilerBinWrite>(file).SaveToFile(Filename.c_str()))
+				Logger->warn("Could not write byte code cache {}", Filename);
+		}
+		catch (const StdCompiler::Exception &e)
+		{
+			Logger->warn("Could not write byte code cache {}: {}", Filename, e.what());
+		}
+		Prune();
+	}
+	if (iRestored || iParsed)
+	{
+		using Ms = std::chrono::duration<double, std::milli>;
+		LogNTr(spdlog::level::info, "Script byte code: {} script{} loaded from cache in {:.1f} ms, {} parsed in {:.1f} ms",
+			iRestored, (iRestored != 1 ? "s" : ""), Ms{RestoreTime}.count(), iParsed, Ms{ParseTime}.count());
+	}
+	Clear();
+}
+
+void C4AulBytecodeCache::Clear()
+{
+	pEngine = nullptr;
+	Filename.clear();
+	Funcs.clear();
+	FuncIndices.clear();
+	TextHashes.clear();
+	Entries.clear();
+	Stored.clear();
+	fChanged = false;
+	iRestored = iParsed = 0;
+	RestoreTime = ParseTime = {};
+}
+
+bool C4AulBytecodeCache::Restore(C4AulScript &script)
+{
+	if (!pEngine) return false;
+	const auto funcs = GetParsedFuncs(script);
+	const auto it = Entries.find(GetKey(script, funcs));
+	if (it == Entries.end()) return false;
+	Entry &entry = it->second;
+	// check everything before touching the script, so a damaged entry just means parsing
+	const auto size = entry.Code.size();
+	if (!size || entry.FuncCode.size() != funcs.size()) return false;
+	for (std::size_t i = 0; i < funcs.size(); ++i)
+		if (entry.FuncCode[i] < (i ? entry.FuncCode[i - 1] : 0) || static_cast<std::size_t>(entry.FuncCode[i]) >= size)
+			return false;
+	std::size_t iFunc = 0;
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		const Chunk &chunk = entry.Code[i];
+		if (chunk.Type < 0 || chunk.Type > AB_EOF) return false;
+		switch (GetChunkRef(chunk.Type))
+		{
+		case ChunkRef::Func:
+			if (chunk.X < -1 || chunk.X >= static_cast<std::int64_t>(Funcs.size())) return false;
+			break;
+		case ChunkRef::String:
+			if (chunk.X < -1 || chunk.X >= static_cast<std::int64_t>(entry.Strings.size())) return false;
+			break;
+		case ChunkRef::None:
+			if (IsJumpType(chunk.Type) && (chunk.X + static_cast<std::int64_t>(i) < 0 || chunk.X + static_cast<std::int64_t>(i) >= static_cast<std::int64_t>(size)))
+				return false;
+			break;
+		}
+		// superinstructions read the chunks following them
+		if (const std::size_t operands{C4AulOptimizer::GetOperandCount(static_cast<C4AulBCCType>(chunk.Type))}; operands && i + operands + 1 >= size)
+			return false;
+		while (iFunc + 1 < funcs.size() && static_cast<std::size_t>(entry.FuncCode[iFunc + 1]) <= i) ++iFunc;
+		if (chunk.SPos != -1)
+			if (funcs.empty() || static_cast<std::size_t>(entry.FuncCode[iFunc]) > i || chunk.SPos < 0 || static_cast<std::size_t>(chunk.SPos) > funcs[iFunc]->pOrgScript->Script.getLength())
+				return false;
+	}
+
+	std::vector<C4String *> strings;
+	strings.reserve(entry.Strings.size());
+	for (const auto &str : entry.Strings)
+	{
+		C4String *string{pEngine->Strings.FindString(str.c_str())};
+		if (!string) string = pEngine->Strings.RegString(str.c_str());
+		string->Hold = true;
+		strings.push_back(string);
+	}
+
+	// the old code has already been deleted by Parse
+	script.Code = new C4AulBCC[size];
+	script.CodeSize = script.CodeBufSize = static_cast<int>(size);
+	script.CPos = script.Code + size;
+	iFunc = 0;
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		const Chunk &chunk = entry.Code[i];
+		C4AulBCC &bcc = script.Code[i];
+		bcc.bccType = static_cast<C4AulBCCType>(chunk.Type);
+		switch (GetChunkRef(chunk.Type))
+		{
+		case ChunkRef::Func:
+			bcc.bccX = chunk.X == -1 ? 0 : reinterpret_cast<std::intptr_t>(Funcs[chunk.X]);
+			break;
+		case ChunkRef::String:
+			bcc.bccX = chunk.X == -1 ? 0 : reinterpret_cast<std::intptr_t>(strings[chunk.X]);
+			break;
+		case ChunkRef::None:
+			bcc.bccX = static_cast<std::intptr_t>(chunk.X);
+			break;
+		}
+		while (iFunc + 1 < funcs.size() && static_cast<std::size_t>(entry.FuncCode[iFunc + 1]) <= i) ++iFunc;
+		bcc.SPos = chunk.SPos == -1 ? nullptr : funcs[iFunc]->pOrgScript->Script.getData() + chunk.SPos;
+	}
+
+	// same as ParseFn; Parse makes the code positions absolute
+	for (std::size_t i = 0; i < funcs.size(); ++i)
+	{
+		script.LinkOverloads(funcs[i]);
+		funcs[i]->Code = reinterpret_cast<C4AulBCC *>(static_cast<std::intptr_t>(entry.FuncCode[i]));
+	}
+
+	// keep the entry for the next link
+	Stored.push_back(std::move(entry));
+	Entries.erase(it);
+	return true;
+}
+
+void C4AulBytecodeCache::Store(C4AulScript &script)
+{
+	if (!pEngine) return;
+	const auto funcs = GetParsedFuncs(script);
+	Entry entry;
+	entry.Key = GetKey(script, funcs);
+	if (entry.Key.empty()) return;
+
+	for (C4AulScriptFunc *Fn : funcs)
+	{
+		const auto pos = Fn->Code - script.Code;
+		if (pos < (entry.FuncCode.empty() ? 0 : entry.FuncCode.back()) || pos >= script.CodeSize) return;
+		entry.FuncCode.push_back(static_cast<std::int32_t>(pos));
+	}
+
+	std::unordered_map<C4String *, std::int64_t> strings;
+	std::size_t iFunc = 0;
+	entry.Code.reserve(script.CodeSize);
+	for (int i = 0; i < script.CodeSize; ++i)
+	{
+		const C4AulBCC &bcc = script.Code[i];
+		Chunk chunk{bcc.bccType, bcc.bccX, -1};
+		switch (GetChunkRef(chunk.Type))
+		{
+		case ChunkRef::Func:
+			if (bcc.bccX)
+			{
+				const auto func = FuncIndices.find(reinterpret_cast<C4AulFunc *>(bcc.bccX));
+				// not in the function table (should not happen): cannot be restored
+				if (func == FuncIndices.end()) return;
+				chunk.X = func->second;
+			}
+			else
+				chunk.X = -1;
+			break;
+		case ChunkRef::String:
+			if (bcc.bccX)
+			{
+				auto *const string = reinterpret_cast<C4String *>(bcc.bccX);
+				const auto [str, inserted] = strings.emplace(string, static_cast<std::int64_t>(entry.Strings.size()));
+				if (inserted) entry.Strings.emplace_back(string->Data.getData(), string->Data.getLength());
+				chunk.X = str->second;
+			}
+			else
+				chunk.X = -1;
+			break;
+		case ChunkRef::None:
+			break;
+		}
+		while (iFunc + 1 < funcs.size() && entry.FuncCode[iFunc + 1] <= i) ++iFunc;
+		if (bcc.SPos)
+		{
+			if (funcs.empty()) return;
+			const StdStrBuf &text = funcs[iFunc]->pOrgScript->Script;
+			if (bcc.SPos < text.getData() || bcc.SPos > text.getData() + text.getLength()) return;
+			chunk.SPos = static_cast<std::int32_t>(bcc.SPos - text.getData());
+		}
+		entry.Code.push_back(chunk);
+	}
+
+	Stored.push_back(std::move(entry));
+	fChanged = true;
+}
+
+void C4AulBytecodeCache::AddTime(C4AulScript &script, bool fFromCache, Clock::duration time)
+{
+	if (!pEngine) return;
+	(fFromCache ? iRestored : iParsed)++;
+	(fFromCache ? RestoreTime : ParseTime) += time;
+	Logger->debug("{}: {} in {:.3f} ms", script.ScriptName, fFromCache ? "loaded from cache" : "parsed", std::chrono::duration<double, std::milli>{time}.count());
+}
+
+std::vector<C4AulScriptFunc *> C4AulBytecodeCache::GetParsedFuncs(C4AulScript &script)
+{
+	// same selection as in C4AulScript::Parse
+	std::vector<C4AulScriptFunc *> funcs;
+	for (C4AulFunc *f = script.Func0; f; f = f->Next)
+	{
+		C4AulScriptFunc *Fn;
+		if (!(Fn = f->SFunc()))
+		{
+			if (f->LinkedTo) Fn = f->LinkedTo->SFunc();
+			if (Fn) if (Fn->Owner != script.Engine) Fn = nullptr;
+		}
+		if (Fn) funcs.push_back(Fn);
+	}
+	return funcs;
+}
+
+std::string C4AulBytecodeCache::HashToString(const Hash &hash)
+{
+	std::string result;
+	for (const auto byte : hash)
+		result += std::format("{:02x}", byte);
+	return result;
+}
+
+void C4AulBytecodeCache::AddFuncs(C4AulScript &script)
+{
+	for (C4AulFunc *f = script.Func0; f; f = f->Next)
+	{
+		FuncIndices.emplace(f, static_cast<std::int32_t>(Funcs.size()));
+		Funcs.push_back(f);
+	}
+	for (C4AulScript *s = script.Child0; s; s = s->Next)
+		AddFuncs(*s);
+}
+
+void C4AulBytecodeCache::HashNamespace()
+{
+	Hasher hasher;
+	hasher.Add(FormatVersion);
+	for (const int ver : {C4XVER1, C4XVER2, C4XVER3, C4XVER4, C4XVERBUILD})
+		hasher.Add(ver);
+	hasher.AddString(C4VERSIONEXTRA);
+	hasher.Add(sizeof(C4AulBCC));
+	hasher.Add(AB_EOF);
+	// optimized and unoptimized byte code is kept apart
+	hasher.Add(Config.Developer.OptimizeScripts);
+
+	// everything the parser resolves names against, except for function bodies
+	hasher.Add(Funcs.size());
+	for (C4AulFunc *f : Funcs)
+	{
+		hasher.AddString(f->Owner ? f->Owner->ScriptName : "");
+		hasher.AddString(f->Name);
+		hasher.Add(f->GetParCount());
+		C4AulScriptFunc *Fn{f->SFunc()};
+		hasher.Add(Fn ? static_cast<int>(Fn->Access) : -1);
+		const auto linked = f->LinkedTo ? FuncIndices.find(f->LinkedTo) : FuncIndices.end();
+		hasher.Add(linked != FuncIndices.end() ? linked->second : -1);
+	}
+
+	hasher.AddNames(pEngine->GlobalConstNames);
+	for (std::int32_t i = 0; i < pEngine->GlobalConstNames.iSize; ++i)
+	{
+		const C4Value &value{pEngine->GlobalConsts.pData[i]};
+		hasher.Add(value.GetType());
+		switch (value.GetType())
+		{
+		case C4V_Int: hasher.Add(value._getInt()); break;
+		case C4V_Bool: hasher.Add(value._getBool()); break;
+		case C4V_C4ID: hasher.Add(value._getC4ID()); break;
+		case C4V_String: hasher.AddString(value._getStr() ? value._getStr()->Data.getData() : ""); break;
+		default: break;
+		}
+	}
+	hasher.AddNames(pEngine->GlobalNamedNames);
+
+	// namespace calls need the definition
+	for (std::size_t i = 0; C4Def *def = Game.Defs.GetDef(i); ++i)
+		hasher.Add(def->id);
+
+	NamespaceHash = hasher.GetHash<Hash>();
+}
+
+const C4AulBytecodeCache::Hash &C4AulBytecodeCache::GetTextHash(C4AulScript &script)
+{
+	const auto it = TextHashes.find(&script);
+	if (it != TextHashes.end()) return it->second;
+	Hasher hasher;
+	hasher.AddString(script.ScriptName);
+	hasher.Add(script.Strict);
+	hasher.AddString({script.Script.getData() ? script.Script.getData() : "", script.Script.getLength()});
+	return TextHashes.emplace(&script, hasher.GetHash<Hash>()).first->second;
+}
+
+std::string C4AulBytecodeCache::GetKey(C4AulScript &script, const std::vector<C4AulScriptFunc *> &funcs)
+{
+	Hasher hasher;
+	hasher.Add(NamespaceHash);
+	hasher.Add(GetTextHash(script));
+	hasher.AddNames(script.LocalNamed);
+	// the byte code of included and appended functions comes from other scripts
+	hasher.Add(funcs.size());
+	for (C4AulScriptFunc *Fn : funcs)
+	{
+		const auto func = FuncIndices.find(Fn);
+		if (func == FuncIndices.end() || !Fn->pOrgScript) return "";
+		hasher.Add(func->second);
+		hasher.Add(GetTextHash(*Fn->pOrgScript));
+	}
+	return HashToString(hasher.GetHash<Hash>());
+}
+
+void C4AulBytecodeCache::Prune()
+{
+	std::vector<std::pair<time_t, std::string>> files;
+	for (DirectoryIterator it{Config.AtUserPath(C4CFN_ScriptCache)}; *it; ++it)
+		if (WildcardMatch("*.c4b", GetFilename(*it)))
+			files.emplace_back(FileTime(*it), *it);
+	if (files.size() <= MaxFiles) return;
+	// remove the oldest files
+	std::sort(files.begin(), files.end());
+	for (std::size_t i = 0; i < files.size() - MaxFiles; ++i)
+		if (files[i].second != Filename)
+			EraseFile(files[i].second.c_str());
+}
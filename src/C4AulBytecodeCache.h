@@ -0,0 +1,113 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// Persistent cache for the byte code of parsed scripts
+
+#pragma once
+
+#include "StdSha1.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class C4AulFunc;
+class C4AulScript;
+class C4AulScriptEngine;
+class C4AulScriptFunc;
+class StdCompiler;
+
+namespace spdlog { class logger; }
+
+// Stores the byte code of each script in the user path, so the next link of
+// the same scripts can skip parsing.
+// Byte code chunks referencing functions or strings are stored by index into
+// the engine's function table and by string value. A script's entry is keyed
+// by the hash of all scripts its functions were parsed from and of the names
+// visible to the parser (function table, constants, globals, definitions),
+// so any change to these falls back to a full parse.
+class C4AulBytecodeCache
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	// Collects the engine's function table and loads the cache file matching it
+	void Begin(C4AulScriptEngine &engine);
+	// Writes the entries of this link back to disk and logs the timing summary
+	void End();
+	void Clear();
+
+	// Restores the byte code of the script; returns false if it has to be parsed
+	bool Restore(C4AulScript &script);
+	// Remembers the freshly parsed byte code of the script for the next link
+	void Store(C4AulScript &script);
+	void AddTime(C4AulScript &script, bool fFromCache, Clock::duration time);
+
+private:
+	using Hash = std::array<std::uint8_t, StdSha1::DigestLength>;
+
+	struct Chunk
+	{
+		std::int32_t Type;
+		std::int64_t X;
+		std::int32_t SPos; // offset in the script the function was parsed from, -1 for none
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	struct Entry
+	{
+		std::string Key;
+		std::vector<Chunk> Code;
+		std::vector<std::int32_t> FuncCode; // code position of each parsed function
+		std::vector<std::string> Strings;
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	struct File
+	{
+		std::int32_t Version;
+		std::vector<Entry> Entries;
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	std::shared_ptr<spdlog::logger> Logger;
+	C4AulScriptEngine *pEngine{nullptr};
+	std::string Filename;
+	Hash NamespaceHash;
+	std::vector<C4AulFunc *> Funcs;
+	std::unordered_map<C4AulFunc *, std::int32_t> FuncIndices;
+	std::unordered_map<C4AulScript *, Hash> TextHashes;
+	std::unordered_map<std::string, Entry> Entries; // loaded from disk
+	std::vector<Entry> Stored; // to be written back
+	bool fChanged{false};
+
+	std::int32_t iRestored{0}, iParsed{0};
+	Clock::duration RestoreTime{}, ParseTime{};
+
+	static std::vector<C4AulScriptFunc *> GetParsedFuncs(C4AulScript &script);
+	static std::string HashToString(const Hash &hash);
+	void AddFuncs(C4AulScript &script);
+	void HashNamespace();
+	const Hash &GetTextHash(C4AulScript &script);
+	std::string GetKey(C4AulScript &script, const std::vector<C4AulScriptFunc *> &funcs);
+	void Prune();
+};
@@ -20,6 +20,7 @@
 #include <C4Include.h>
 #include <C4Aul.h>
 
+#include <C4AulOptimizer.h>
 #include <C4Object.h>
 #include <C4Config.h>
 #include <C4Game.h>
@@ -122,20 +123,18 @@ private:
 
 	std::shared_ptr<spdlog::logger> traceLogger;
 	int iTraceStart;
-	bool fProfiling;
-	time_t tDirectExecStart, tDirectExecTotal; // profiler time for DirectExec
-	C4AulScript *pProfiledScript;
+	C4AulProfiler Profiler;
 
 public:
 	C4Value Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, const C4Value pPars[], bool fPassErrors, bool fTemporaryScript = false);
 	C4Value Exec(C4AulBCC *pCPos, bool fPassErrors);
 
 	void StartTrace();
-	void StartProfiling(C4AulScript *pScript); // resets profling times and starts recording the times
-	void StopProfiling(); // stop the profiler and displays results
-	void AbortProfiling() { fProfiling = false; }
-	inline void StartDirectExec() { if (fProfiling) tDirectExecStart = timeGetTime(); }
-	inline void StopDirectExec() { if (fProfiling) tDirectExecTotal += timeGetTime() - tDirectExecStart; }
+	void StartProfiling(C4AulScript *pScript); // resets profiling times and starts recording the times
+	void StopProfiling(const char *szFilename); // stop the profiler and displays results
+	void AbortProfiling() { Profiler.Clear(); }
+	bool IsProfiling() const { return Profiler.IsRunning(); }
+	C4AulProfiler &GetProfiler() { return Profiler; }
 
 private:
 	void PushContext(const C4AulScriptContext &rContext)
@@ -150,8 +149,8 @@ private:
 			buf.append(ContextStackSize() - iTraceStart, '>');
 			pCurCtx->dump(std::move(buf));
 		}
-		// Profiler: Safe time to measure difference afterwards
-		if (fProfiling) pCurCtx->tTime = timeGetTime();
+		// Profiler: temporary scripts are recorded as DirectExec
+		pCurCtx->ProfilerFrame = Profiler.IsRunning() && !pCurCtx->TemporaryScript ? Profiler.Enter(pCurCtx->Func) : C4AulProfiler::Frame{};
 	}
 
 	void PopContext()
@@ -159,12 +158,7 @@ private:
 		if (pCurCtx < Contexts)
 			throw C4AulExecError(pCurCtx->Obj, "context stack underflow!");
 		// Profiler adding up times
-		if (fProfiling)
-		{
-			time_t dt = timeGetTime() - pCurCtx->tTime;
-			if (dt && pCurCtx->Func)
-				pCurCtx->Func->tProfileTime += dt;
-		}
+		Profiler.Leave(pCurCtx->ProfilerFrame);
 		// Trace done?
 		if (iTraceStart >= 0)
 		{
@@ -322,6 +316,58 @@ private:
 			CheckOpPar<false>(pCurVal, C4ScriptOpMap[iOpID].Type1, C4ScriptOpMap[iOpID].Identifier);
 	}
 
+	static bool IsPlainInt(C4Value &value)
+	{
+		return !value.IsRef() && value.GetType() == C4V_Int;
+	}
+
+	// Fast path of the superinstructions: applies the int operator at pOp and
+	// branches directly if a comparison is followed by a conditional jump
+	C4AulBCC *ExecIntOp(C4AulBCC *pOp, C4ValueInt left, C4ValueInt right, bool fLeftOnStack)
+	{
+		const C4ValueInt result{C4AulOptimizer::EvalIntOp(pOp->bccType, left, right)};
+		if (!C4AulOptimizer::IsIntComparison(pOp->bccType))
+		{
+			if (fLeftOnStack)
+				pCurVal->SetInt(result);
+			else
+				PushValue(C4VInt(result));
+		}
+		else if (pOp[1].bccType == AB_CONDN)
+		{
+			if (fLeftOnStack) PopValue();
+			return result ? pOp + 2 : pOp + 1 + pOp[1].bccX;
+		}
+		else if (fLeftOnStack)
+			pCurVal->SetBool(result);
+		else
+			PushValue(C4VBool(result));
+		return pOp + 1;
+	}
+
+	// Int operator chunk on the two topmost values, after their types have been checked
+	void ExecIntOperator(C4AulBCCType eOp)
+	{
+		C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
+		const auto result = C4AulOptimizer::ExecIntOp(eOp, pPar1->_getInt(), pPar2->_getInt());
+		switch (result.Type)
+		{
+		case C4V_Int: pPar1->SetInt(result.Value); break;
+		case C4V_Bool: pPar1->SetBool(result.Value != 0); break;
+		default: pPar1->Set0(); break;
+		}
+		PopValue();
+	}
+
+	bool ExecIntCompareJump(C4AulBCC *&pCPos, C4AulBCCType eOp)
+	{
+		if (!IsPlainInt(pCurVal[-1]) || !IsPlainInt(pCurVal[0])) return false;
+		const C4ValueInt result{C4AulOptimizer::EvalIntOp(eOp, pCurVal[-1]._getInt(), pCurVal[0]._getInt())};
+		PopValues(2);
+		pCPos += result ? 2 : 1 + pCPos[1].bccX;
+		return true;
+	}
+
 	C4AulBCC *Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4Object *pObj = nullptr, C4Def *pDef = nullptr, bool globalContext = false);
 };
 
@@ -379,6 +425,14 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PushValue(C4VNull);
 				break;
 
+			case AB_INT_OP:
+				if (IsPlainInt(*pCurVal))
+				{
+					pCPos = ExecIntOp(pCPos + 1, pCurVal->_getInt(), static_cast<C4ValueInt>(pCPos->bccX), true);
+					fJump = true;
+					break;
+				}
+				[[fallthrough]];
 			case AB_INT:
 				PushValue(C4VInt(static_cast<C4ValueInt>(pCPos->bccX)));
 				break;
@@ -408,13 +462,49 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PushValue(pCurCtx->Pars[pCPos->bccX]);
 				break;
 
+			case AB_VARN_R_INC:
+			{
+				C4Value &var{pCurCtx->Vars[pCPos->bccX]};
+				if (IsPlainInt(var))
+				{
+					const C4AulBCCType eOp{pCPos[1].bccType};
+					var.GetData().Int += (eOp == AB_Inc1 || eOp == AB_Inc1_Postfix) ? 1 : -1;
+					pCPos += 3;
+					fJump = true;
+					break;
+				}
+			}
+				[[fallthrough]];
 			case AB_VARN_R:
 				PushValueRef(pCurCtx->Vars[pCPos->bccX]);
 				break;
+			case AB_VARN_V_INT_OP:
+			{
+				C4Value &var{pCurCtx->Vars[pCPos->bccX]};
+				if (IsPlainInt(var))
+				{
+					pCPos = ExecIntOp(pCPos + 2, var._getInt(), static_cast<C4ValueInt>(pCPos[1].bccX), false);
+					fJump = true;
+					break;
+				}
+			}
+				[[fallthrough]];
 			case AB_VARN_V:
 				PushValue(pCurCtx->Vars[pCPos->bccX]);
 				break;
 
+			case AB_LOCALN_V_INT_OP:
+				if (pCurCtx->Obj && pCurCtx->Func->Owner->Def == pCurCtx->Obj->Def)
+				{
+					C4Value &local{*pCurCtx->Obj->LocalNamed.GetItem(pCPos->bccX)};
+					if (IsPlainInt(local))
+					{
+						pCPos = ExecIntOp(pCPos + 2, local._getInt(), static_cast<C4ValueInt>(pCPos[1].bccX), false);
+						fJump = true;
+						break;
+					}
+				}
+				[[fallthrough]];
 			case AB_LOCALN_R: case AB_LOCALN_V:
 				if (!pCurCtx->Obj)
 					throw C4AulExecError(pCurCtx->Obj, "can't access local variables in a definition call!");
@@ -500,47 +590,31 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			case AB_Div: // /
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
-				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				if (pPar2->_getInt())
-					pPar1->SetInt(pPar1->_getInt() / pPar2->_getInt());
-				else
-					pPar1->Set0();
-				PopValue();
+				ExecIntOperator(pCPos->bccType);
 				break;
 			}
 			case AB_Mul: // *
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
-				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetInt(pPar1->_getInt() * pPar2->_getInt());
-				PopValue();
+				ExecIntOperator(pCPos->bccType);
 				break;
 			}
 			case AB_Mod: // %
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
-				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				if (pPar2->_getInt())
-					pPar1->SetInt(pPar1->_getInt() % pPar2->_getInt());
-				else
-					pPar1->Set0();
-				PopValue();
+				ExecIntOperator(pCPos->bccType);
 				break;
 			}
 			case AB_Sub: // -
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
-				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetInt(pPar1->_getInt() - pPar2->_getInt());
-				PopValue();
+				ExecIntOperator(pCPos->bccType);
 				break;
 			}
 			case AB_Sum: // +
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
-				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetInt(pPar1->_getInt() + pPar2->_getInt());
-				PopValue();
+				ExecIntOperator(pCPos->bccType);
 				break;
 			}
 			case AB_LeftShift: // <<
@@ -559,36 +633,56 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
+			case AB_LessThan_CONDN:
+				if (ExecIntCompareJump(pCPos, AB_LessThan))
+				{
+					fJump = true;
+					break;
+				}
+				[[fallthrough]];
 			case AB_LessThan: // <
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
-				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetBool(pPar1->_getInt() < pPar2->_getInt());
-				PopValue();
+				ExecIntOperator(pCPos->bccType);
 				break;
 			}
+			case AB_LessThanEqual_CONDN:
+				if (ExecIntCompareJump(pCPos, AB_LessThanEqual))
+				{
+					fJump = true;
+					break;
+				}
+				[[fallthrough]];
 			case AB_LessThanEqual: // <=
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
-				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetBool(pPar1->_getInt() <= pPar2->_getInt());
-				PopValue();
+				ExecIntOperator(pCPos->bccType);
 				break;
 			}
+			case AB_GreaterThan_CONDN:
+				if (ExecIntCompareJump(pCPos, AB_GreaterThan))
+				{
+					fJump = true;
+					break;
+				}
+				[[fallthrough]];
 			case AB_GreaterThan: // >
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
-				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetBool(pPar1->_getInt() > pPar2->_getInt());
-				PopValue();
+				ExecIntOperator(pCPos->bccType);
 				break;
 			}
+			case AB_GreaterThanEqual_CONDN:
+				if (ExecIntCompareJump(pCPos, AB_GreaterThanEqual))
+				{
+					fJump = true;
+					break;
+				}
+				[[fallthrough]];
 			case AB_GreaterThanEqual: // >=
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
-				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetBool(pPar1->_getInt() >= pPar2->_getInt());
-				PopValue();
+				ExecIntOperator(pCPos->bccType);
 				break;
 			}
 			case AB_Concat: // ..
@@ -709,25 +803,19 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			case AB_BitAnd: // &
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
-				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetInt(pPar1->_getInt() & pPar2->_getInt());
-				PopValue();
+				ExecIntOperator(pCPos->bccType);
 				break;
 			}
 			case AB_BitXOr: // ^
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
-				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetInt(pPar1->_getInt() ^ pPar2->_getInt());
-				PopValue();
+				ExecIntOperator(pCPos->bccType);
 				break;
 			}
 			case AB_BitOr: // |
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
-				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetInt(pPar1->_getInt() | pPar2->_getInt());
-				PopValue();
+				ExecIntOperator(pCPos->bccType);
 				break;
 			}
 			case AB_And: // &&
@@ -1170,34 +1258,20 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			{
 				// This should always hold
 				assert(pCurVal[-1].ConvertTo(C4V_Int));
-				using Iterator = C4ValueHash::Iterator;
-				auto iterator = reinterpret_cast<Iterator *>(pCurVal[0]._getRef());
 				// Check map the first time only
-				if (!iterator)
+				if (!pCurVal[0]._getInt())
 				{
 					if (!pCurVal[-2].ConvertTo(C4V_Map))
-						throw C4AulExecError(pCurCtx->Obj, std::format("for: map expected, but got {}!", pCurVal[-1].GetTypeName()));
+						throw C4AulExecError(pCurCtx->Obj, std::format("for: map expected, but got {}!", pCurVal[-2].GetTypeName()));
 					if (!pCurVal[-2]._getMap())
 						throw C4AulExecError(pCurCtx->Obj, std::format("for: map expected, but got nil!"));
 				}
 				C4ValueHash *map = pCurVal[-2]._getMap();
-				if (!iterator)
-				{
-					iterator = new Iterator (map->begin());
-					pCurVal[0].SetInt(1);
-					pCurVal[0].GetData().Ref = reinterpret_cast<C4Value *>(iterator);
-				}
-				// No more entries?
-				if (*iterator == map->end())
-				{
-					delete iterator;
+				// Get next and save position
+				C4ValueInt position = pCurVal[0]._getInt();
+				if (!map->ForeachNext(position, pCurCtx->Vars[pCPos->bccX], pCurCtx->Vars[pCurVal[-1]._getInt()]))
 					break;
-				}
-				// Get next
-				pCurCtx->Vars[pCPos->bccX] = (**iterator).first;
-				pCurCtx->Vars[pCurVal[-1]._getInt()] = (**iterator).second;
-
-				++(*iterator);
+				pCurVal[0].SetInt(position);
 				// Jump over next instruction
 				pCPos += 2;
 				fJump = true;
@@ -1507,10 +1581,13 @@ C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4
 #ifndef NDEBUG
 		C4AulScriptContext *pCtx = pCurCtx;
 #endif
-		if (pReturn > pCurVal)
-			PushValue(pFunc->Exec(&CallCtx, pPars, true));
-		else
-			pReturn->Set(pFunc->Exec(&CallCtx, pPars, true));
+		{
+			const C4AulProfiler::Scope profilerScope{Profiler, pFunc};
+			if (pReturn > pCurVal)
+				PushValue(pFunc->Exec(&CallCtx, pPars, true));
+			else
+				pReturn->Set(pFunc->Exec(&CallCtx, pPars, true));
+		}
 #ifndef NDEBUG
 		assert(pCtx == pCurCtx);
 #endif
@@ -1539,29 +1616,25 @@ void C4AulExec::StartTrace()
 
 void C4AulExec::StartProfiling(C4AulScript *pProfiledScript)
 {
-	// stop previous profiler run
-	if (fProfiling) AbortProfiling();
-	fProfiling = true;
-	// resets profling times and starts recording the times
-	this->pProfiledScript = pProfiledScript;
-	time_t tNow = timeGetTime();
-	tDirectExecStart = tNow; // in case profiling is started from DirectExec
-	tDirectExecTotal = 0;
-	pProfiledScript->ResetProfilerTimes();
-	for (C4AulScriptContext *pCtx = Contexts; pCtx <= pCurCtx; ++pCtx)
-		pCtx->tTime = tNow;
+	// stop previous profiler run; calls already running are not recorded
+	Profiler.Start(*pProfiledScript);
+	Game.FindObjectPlans.ResetStats();
 }
 
-void C4AulExec::StopProfiling()
+void C4AulExec::StopProfiling(const char *szFilename)
 {
 	// stop the profiler and displays results
-	if (!fProfiling) return;
-	fProfiling = false;
-	// collect profiler times
-	C4AulProfiler Profiler{CreateLogger("C4AulProfiler", {.GuiLogLevel = spdlog::level::info, .ShowLoggerNameInGui = false})};
-	Profiler.CollectEntry(nullptr, tDirectExecTotal);
-	pProfiledScript->CollectProfilerTimes(Profiler);
-	Profiler.Show();
+	if (!Profiler.IsRunning()) return;
+	Profiler.Stop();
+	Profiler.Show(Game.FindObjectPlans.GetHits(), Game.FindObjectPlans.GetMisses());
+	if (szFilename)
+	{
+		if (Profiler.SaveCollapsedStacks(szFilename))
+			LogNTr("Script profile saved to {}", szFilename);
+		else
+			LogNTr(spdlog::level::err, "Could not save script profile to {}", szFilename);
+	}
+	Profiler.Clear();
 }
 
 void C4AulProfiler::StartProfiling(C4AulScript *pScript)
@@ -1569,9 +1642,9 @@ void C4AulProfiler::StartProfiling(C4AulScript *pScript)
 	AulExec.StartProfiling(pScript);
 }
 
-void C4AulProfiler::StopProfiling()
+void C4AulProfiler::StopProfiling(const char *szFilename)
 {
-	AulExec.StopProfiling();
+	AulExec.StopProfiling(szFilename);
 }
 
 void C4AulProfiler::Abort()
@@ -1579,32 +1652,9 @@ void C4AulProfiler::Abort()
 	AulExec.AbortProfiling();
 }
 
-void C4AulProfiler::CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime)
+bool C4AulProfiler::IsProfiling()
 {
-	// zero entries are not collected to have a cleaner list
-	if (!tProfileTime) return;
-	// add entry to list
-	Entry e;
-	e.pFunc = pFunc;
-	e.tProfileTime = tProfileTime;
-	Times.push_back(e);
-}
-
-void C4AulProfiler::Show()
-{
-	// sort by time
-	std::sort(Times.rbegin(), Times.rend());
-	// display them
-	logger->info("Profiler statistics:");
-	logger->info("==============================");
-	typedef std::vector<Entry> EntryList;
-	for (EntryList::iterator i = Times.begin(); i != Times.end(); ++i)
-	{
-		Entry &e = (*i);
-		logger->info("{:05}ms\t{}", e.tProfileTime, e.pFunc ? (e.pFunc->GetFullName().c_str()) : "Direct exec");
-	}
-	logger->info("==============================");
-	// done!
+	return AulExec.IsProfiling();
 }
 
 C4Value C4AulFunc::Exec(C4Object *pObj, const C4AulParSet &pPars, bool fPassErrors, bool nonStrict3WarnConversionOnly, bool convertNilToIntBool)
@@ -1663,7 +1713,7 @@ C4Value C4AulScript::DirectExec(C4Object *pObj, const char *szScript, const char
 	AddDbgRec(RCT_DirectExec, &iObjNumber, sizeof(int32_t));
 #endif
 	// profiler
-	AulExec.StartDirectExec();
+	const C4AulProfiler::Scope profilerScope{AulExec.GetProfiler(), nullptr};
 	// Create a new temporary script as child of this script
 	C4AulScript *pScript = new C4AulScript();
 	pScript->Script.Copy(szScript);
@@ -1700,32 +1750,16 @@ C4Value C4AulScript::DirectExec(C4Object *pObj, const char *szScript, const char
 	pFunc->Code = pScript->Code;
 	pScript->State = ASS_PARSED;
 	// Execute. The TemporaryScript-parameter makes sure the script will be deleted later on.
-	C4Value vRetVal(AulExec.Exec(pFunc, pObj, nullptr, fPassErrors, true));
-	// profiler
-	AulExec.StopDirectExec();
-	return vRetVal;
-}
-
-void C4AulScript::ResetProfilerTimes()
-{
-	// zero all profiler times of owned functions
-	C4AulScriptFunc *pSFunc;
-	for (C4AulFunc *pFn = Func0; pFn; pFn = pFn->Next)
-		if (pSFunc = pFn->SFunc())
-			pSFunc->tProfileTime = 0;
-	// reset sub-scripts
-	for (C4AulScript *pScript = Child0; pScript; pScript = pScript->Next)
-		pScript->ResetProfilerTimes();
+	return AulExec.Exec(pFunc, pObj, nullptr, fPassErrors, true);
 }
 
-void C4AulScript::CollectProfilerTimes(class C4AulProfiler &rProfiler)
+void C4AulScript::CollectProfilerFuncs(C4AulProfiler &rProfiler)
 {
-	// collect all profiler times of owned functions
-	C4AulScriptFunc *pSFunc;
+	// list owned functions
 	for (C4AulFunc *pFn = Func0; pFn; pFn = pFn->Next)
-		if (pSFunc = pFn->SFunc())
-			rProfiler.CollectEntry(pSFunc, pSFunc->tProfileTime);
+		if (pFn->SFunc())
+			rProfiler.AddListedFunc(pFn);
 	// collect sub-scripts
 	for (C4AulScript *pScript = Child0; pScript; pScript = pScript->Next)
-		pScript->CollectProfilerTimes(rProfiler);
+		pScript->CollectProfilerFuncs(rProfiler);
 }
@@ -269,7 +269,9 @@ void C4AulScriptEngine::Link(C4DefList *rDefs)
 		ParseDescs();
 
 		// parse the scripts to byte code
+		BytecodeCache.Begin(*this);
 		Parse();
+		BytecodeCache.End();
 
 		// engine is always parsed (for global funcs)
 		State = ASS_PARSED;
@@ -315,6 +317,9 @@ void C4AulScriptEngine::ReLink(C4DefList *rDefs)
 	// unlink scripts
 	UnLink();
 
+	// cached FindObject conditions point to the old bytecode and functions
+	Game.FindObjectPlans.Clear();
+
 	// unlink defs
 	if (rDefs) rDefs->ResetIncludeDependencies();
 
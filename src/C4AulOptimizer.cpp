@@ -0,0 +1,258 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4AulOptimizer.h>
+
+namespace
+{
+	constexpr int MaxJumpThreading = 8;
+
+	bool IsJumpType(C4AulBCCType type) noexcept
+	{
+		return type == AB_JUMP || type == AB_JUMPAND || type == AB_JUMPOR || type == AB_CONDN || type == AB_JUMPNIL || type == AB_JUMPNOTNIL || type == AB_NilCoalescingIt;
+	}
+
+	bool IsConstant(const C4AulBCC &bcc) noexcept
+	{
+		// nil constants are pushed as AB_STACK 1
+		return bcc.bccType == AB_INT || bcc.bccType == AB_BOOL || (bcc.bccType == AB_STACK && bcc.bccX == 1);
+	}
+
+	C4AulBCCType GetCompareJump(C4AulBCCType type) noexcept
+	{
+		switch (type)
+		{
+		case AB_LessThan: return AB_LessThan_CONDN;
+		case AB_LessThanEqual: return AB_LessThanEqual_CONDN;
+		case AB_GreaterThan: return AB_GreaterThan_CONDN;
+		case AB_GreaterThanEqual: return AB_GreaterThanEqual_CONDN;
+		default: return type;
+		}
+	}
+}
+
+C4AulOptimizer::C4AulOptimizer(C4AulBCC *code, std::size_t size)
+	: Code{code}, Size{size}, NewSize{size},
+	Targets(size + 1), Pinned(size + 1), Removed(size + 1), Map(size + 1)
+{
+	for (std::size_t i = 0; i <= size; ++i)
+		Map[i] = i;
+}
+
+std::size_t C4AulOptimizer::Optimize()
+{
+	ThreadJumps();
+	FindTargets();
+	while (FoldConstants());
+	FoldConditions();
+	RemoveDeadJumps();
+	Compact();
+	Fuse();
+	return NewSize;
+}
+
+std::size_t C4AulOptimizer::GetOperandCount(C4AulBCCType type) noexcept
+{
+	switch (type)
+	{
+	case AB_INT_OP:
+	case AB_LessThan_CONDN: case AB_LessThanEqual_CONDN: case AB_GreaterThan_CONDN: case AB_GreaterThanEqual_CONDN:
+		return 1;
+	case AB_VARN_V_INT_OP: case AB_LOCALN_V_INT_OP: case AB_VARN_R_INC:
+		return 2;
+	default:
+		return 0;
+	}
+}
+
+std::size_t C4AulOptimizer::NextLive(std::size_t pos) const
+{
+	while (pos < Size && Removed[pos]) ++pos;
+	return pos;
+}
+
+void C4AulOptimizer::ThreadJumps()
+{
+	for (std::size_t i = 0; i < Size; ++i)
+	{
+		if (!IsJumpType(Code[i].bccType)) continue;
+		std::intptr_t target{static_cast<std::intptr_t>(i) + Code[i].bccX};
+		for (int j = 0; j < MaxJumpThreading; ++j)
+		{
+			if (target < 0 || static_cast<std::size_t>(target) >= Size) break;
+			const C4AulBCC &bcc = Code[target];
+			if (bcc.bccType != AB_JUMP || !bcc.bccX) break;
+			target += bcc.bccX;
+		}
+		if (target >= 0 && static_cast<std::size_t>(target) < Size)
+			Code[i].bccX = target - static_cast<std::intptr_t>(i);
+	}
+}
+
+void C4AulOptimizer::FindTargets()
+{
+	for (std::size_t i = 0; i < Size; ++i)
+	{
+		const C4AulBCC &bcc = Code[i];
+		if (IsJumpType(bcc.bccType))
+		{
+			const std::intptr_t target{static_cast<std::intptr_t>(i) + bcc.bccX};
+			if (target >= 0 && static_cast<std::size_t>(target) <= Size)
+				Targets[target] = true;
+		}
+		// the loop exit jump is skipped over by continuing at i + 2
+		else if ((bcc.bccType == AB_FOREACH_NEXT || bcc.bccType == AB_FOREACH_MAP_NEXT) && i + 2 <= Size)
+		{
+			Pinned[i + 1] = true;
+			Targets[i + 2] = true;
+		}
+	}
+}
+
+bool C4AulOptimizer::FoldConstants()
+{
+	bool fChanged{false};
+	for (std::size_t i = NextLive(0); i < Size; i = NextLive(i + 1))
+	{
+		// [int a][int b][operator] -> [result]
+		if (Code[i].bccType != AB_INT) continue;
+		const std::size_t iRight{NextLive(i + 1)};
+		if (iRight >= Size || Code[iRight].bccType != AB_INT || !IsRemovable(iRight)) continue;
+		const std::size_t iOp{NextLive(iRight + 1)};
+		if (iOp >= Size || !IsIntOp(Code[iOp].bccType) || !IsRemovable(iOp)) continue;
+
+		const auto a = static_cast<C4ValueInt>(Code[i].bccX), b = static_cast<C4ValueInt>(Code[iRight].bccX);
+		const C4AulBCCType type{Code[iOp].bccType};
+		if (!CanEvalIntOp(type, b)) continue;
+
+		Code[i].bccType = IsIntComparison(type) ? AB_BOOL : AB_INT;
+		Code[i].bccX = EvalIntOp(type, a, b);
+		Remove(iRight);
+		Remove(iOp);
+		fChanged = true;
+	}
+	return fChanged;
+}
+
+void C4AulOptimizer::FoldConditions()
+{
+	for (std::size_t i = NextLive(0); i < Size; i = NextLive(i + 1))
+	{
+		if (!IsConstant(Code[i]) || Pinned[i]) continue;
+		const std::size_t iCond{NextLive(i + 1)};
+		if (iCond >= Size || Code[iCond].bccType != AB_CONDN || !IsRemovable(iCond)) continue;
+
+		if (Code[i].bccType != AB_STACK && Code[i].bccX)
+		{
+			// never jumps: jumps to the constant continue after the condition
+			Remove(i);
+		}
+		else
+		{
+			// always jumps
+			Code[i].bccType = AB_JUMP;
+			Code[i].bccX = static_cast<std::intptr_t>(iCond) + Code[iCond].bccX - static_cast<std::intptr_t>(i);
+		}
+		Remove(iCond);
+	}
+}
+
+void C4AulOptimizer::RemoveDeadJumps()
+{
+	for (std::size_t i = 0; i < Size; ++i)
+	{
+		if (Removed[i] || Pinned[i] || Code[i].bccType != AB_JUMP) continue;
+		const std::intptr_t target{static_cast<std::intptr_t>(i) + Code[i].bccX};
+		if (target <= static_cast<std::intptr_t>(i) || static_cast<std::size_t>(target) > Size) continue;
+		// only removed chunks are in between
+		if (NextLive(i + 1) == NextLive(static_cast<std::size_t>(target)))
+			Remove(i);
+	}
+}
+
+void C4AulOptimizer::Compact()
+{
+	std::size_t iPos{0};
+	for (std::size_t i = 0; i <= Size; ++i)
+	{
+		Map[i] = iPos;
+		if (i < Size && !Removed[i]) ++iPos;
+	}
+	NewSize = iPos;
+	if (NewSize == Size) return;
+
+	for (std::size_t i = 0; i < Size; ++i)
+	{
+		if (Removed[i]) continue;
+		C4AulBCC bcc = Code[i];
+		if (IsJumpType(bcc.bccType))
+			bcc.bccX = static_cast<std::intptr_t>(Map[i + bcc.bccX]) - static_cast<std::intptr_t>(Map[i]);
+		Code[Map[i]] = bcc;
+	}
+}
+
+void C4AulOptimizer::Fuse()
+{
+	// the chunks belonging to a superinstruction are skipped, so they keep
+	// their original type for the fallback of the superinstruction
+	for (std::size_t i = 0; i < NewSize; ++i)
+	{
+		C4AulBCC &bcc = Code[i];
+		const C4AulBCCType next{i + 1 < NewSize ? Code[i + 1].bccType : AB_EOF};
+		switch (bcc.bccType)
+		{
+		case AB_INT:
+			// [int][operator]
+			if (IsIntOp(next) && CanEvalIntOp(next, static_cast<C4ValueInt>(bcc.bccX)))
+			{
+				bcc.bccType = AB_INT_OP;
+				++i;
+			}
+			break;
+
+		case AB_VARN_V: case AB_LOCALN_V:
+			// [var][int][operator]
+			if (next == AB_INT && i + 2 < NewSize && IsIntOp(Code[i + 2].bccType) && CanEvalIntOp(Code[i + 2].bccType, static_cast<C4ValueInt>(Code[i + 1].bccX)))
+			{
+				bcc.bccType = bcc.bccType == AB_VARN_V ? AB_VARN_V_INT_OP : AB_LOCALN_V_INT_OP;
+				i += 2;
+			}
+			break;
+
+		case AB_VARN_R:
+			// [var][++/--][pop]
+			if ((next == AB_Inc1 || next == AB_Dec1 || next == AB_Inc1_Postfix || next == AB_Dec1_Postfix) &&
+				i + 2 < NewSize && Code[i + 2].bccType == AB_STACK && Code[i + 2].bccX == -1)
+			{
+				bcc.bccType = AB_VARN_R_INC;
+				i += 2;
+			}
+			break;
+
+		case AB_LessThan: case AB_LessThanEqual: case AB_GreaterThan: case AB_GreaterThanEqual:
+			// [comparison][conditional jump]
+			if (next == AB_CONDN)
+			{
+				bcc.bccType = GetCompareJump(bcc.bccType);
+				++i;
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+}
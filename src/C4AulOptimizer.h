@@ -0,0 +1,129 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// Optimization pass over the byte code of a parsed script
+
+#pragma once
+
+#include <C4Aul.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Rewrites the byte code of a script after parsing:
+// - jumps to unconditional jumps are threaded to the final target
+// - int operators with constant operands are folded
+// - conditional jumps on constants and jumps to the next chunk are removed
+// - frequent chunk sequences get a superinstruction as their first chunk.
+//   The following chunks are left unchanged, so the superinstruction can fall
+//   back to the original chunk whenever its operands aren't plain ints.
+// Removed chunks are mapped to the next remaining chunk, so jumps to them
+// and function entries keep their meaning.
+class C4AulOptimizer
+{
+public:
+	C4AulOptimizer(C4AulBCC *code, std::size_t size);
+
+	// Runs all passes and returns the new code size
+	std::size_t Optimize();
+	// Position a chunk of the original code has been moved to
+	std::size_t GetNewPos(std::size_t pos) const { return Map[pos]; }
+
+	// Operators that the superinstructions and constant folding handle on plain ints
+	static bool IsIntOp(C4AulBCCType type) noexcept
+	{
+		switch (type)
+		{
+		case AB_Div: case AB_Mul: case AB_Mod: case AB_Sub: case AB_Sum:
+		case AB_BitAnd: case AB_BitXOr: case AB_BitOr:
+			return true;
+		default:
+			return IsIntComparison(type);
+		}
+	}
+
+	static bool IsIntComparison(C4AulBCCType type) noexcept
+	{
+		return type == AB_LessThan || type == AB_LessThanEqual || type == AB_GreaterThan || type == AB_GreaterThanEqual;
+	}
+
+	// Division by 0 results in nil, so it is left to the executor's operators
+	static bool CanEvalIntOp(C4AulBCCType type, C4ValueInt b) noexcept
+	{
+		return (type != AB_Div && type != AB_Mod) || b != 0;
+	}
+
+	// Int result of the operators for two ints; comparisons return 0 or 1
+	static C4ValueInt EvalIntOp(C4AulBCCType type, C4ValueInt a, C4ValueInt b) noexcept
+	{
+		// sums and products wrap around instead of overflowing, and so does the division of the smallest int by -1
+		using Unsigned = std::make_unsigned_t<C4ValueInt>;
+		switch (type)
+		{
+		case AB_Div: return b == -1 ? static_cast<C4ValueInt>(Unsigned{0} - static_cast<Unsigned>(a)) : a / b;
+		case AB_Mul: return static_cast<C4ValueInt>(static_cast<Unsigned>(a) * static_cast<Unsigned>(b));
+		case AB_Mod: return b == -1 ? 0 : a % b;
+		case AB_Sub: return static_cast<C4ValueInt>(static_cast<Unsigned>(a) - static_cast<Unsigned>(b));
+		case AB_Sum: return static_cast<C4ValueInt>(static_cast<Unsigned>(a) + static_cast<Unsigned>(b));
+		case AB_BitAnd: return a & b;
+		case AB_BitXOr: return a ^ b;
+		case AB_BitOr: return a | b;
+		case AB_LessThan: return a < b;
+		case AB_LessThanEqual: return a <= b;
+		case AB_GreaterThan: return a > b;
+		case AB_GreaterThanEqual: return a >= b;
+		default: return 0;
+		}
+	}
+
+	struct IntOpResult
+	{
+		C4V_Type Type; // C4V_Int, C4V_Bool or C4V_Any for nil
+		C4ValueInt Value;
+	};
+
+	// The executor's operators for two ints, so folded and fused operators can't differ from them
+	static IntOpResult ExecIntOp(C4AulBCCType type, C4ValueInt a, C4ValueInt b) noexcept
+	{
+		if (!CanEvalIntOp(type, b)) return {C4V_Any, 0};
+		return {IsIntComparison(type) ? C4V_Bool : C4V_Int, EvalIntOp(type, a, b)};
+	}
+
+	// Number of chunks following a superinstruction that belong to it
+	static std::size_t GetOperandCount(C4AulBCCType type) noexcept;
+
+private:
+	C4AulBCC *Code;
+	std::size_t Size;
+	std::size_t NewSize;
+	std::vector<bool> Targets; // chunks that are jumped to
+	std::vector<bool> Pinned; // chunks that must not be removed
+	std::vector<bool> Removed;
+	std::vector<std::size_t> Map;
+
+	std::size_t NextLive(std::size_t pos) const;
+	void Remove(std::size_t pos) { Removed[pos] = true; }
+	bool IsRemovable(std::size_t pos) const { return !Targets[pos] && !Pinned[pos]; }
+
+	void ThreadJumps();
+	void FindTargets();
+	bool FoldConstants();
+	void FoldConditions();
+	void RemoveDeadJumps();
+	void Compact();
+	void Fuse();
+};
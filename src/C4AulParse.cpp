@@ -20,6 +20,8 @@
 #include <C4Include.h>
 #include <C4Aul.h>
 
+#include <C4AulOptimizer.h>
+#include <C4Config.h>
 #include <C4Def.h>
 #include <C4Game.h>
 #include <C4Wrappers.h>
@@ -912,6 +914,14 @@ static const char *GetTTName(C4AulBCCType e)
 	case AB_CONDN:            return "AB_CONDN";            // conditional jump (negated, pops stack)
 	case AB_FOREACH_NEXT:     return "AB_FOREACH_NEXT";     // foreach: next element
 	case AB_FOREACH_MAP_NEXT: return "AB_FOREACH_MAP_NEXT"; // foreach: next element
+	case AB_INT_OP:                 return "AB_INT_OP";
+	case AB_VARN_V_INT_OP:          return "AB_VARN_V_INT_OP";
+	case AB_LOCALN_V_INT_OP:        return "AB_LOCALN_V_INT_OP";
+	case AB_VARN_R_INC:             return "AB_VARN_R_INC";
+	case AB_LessThan_CONDN:         return "AB_LessThan_CONDN";
+	case AB_LessThanEqual_CONDN:    return "AB_LessThanEqual_CONDN";
+	case AB_GreaterThan_CONDN:      return "AB_GreaterThan_CONDN";
+	case AB_GreaterThanEqual_CONDN: return "AB_GreaterThanEqual_CONDN";
 	case AB_RETURN:           return "AB_RETURN";           // return statement
 	case AB_ERR:              return "AB_ERR";              // parse error at this position
 	case AB_EOFN:             return "AB_EOFN";             // end of function
@@ -1397,7 +1407,7 @@ void C4AulParseState::UnexpectedToken(const char *Expected)
 	throw C4AulParseError(this, std::format("{} expected, but found {}", Expected, GetTokenName(TokenType)));
 }
 
-void C4AulScript::ParseFn(C4AulScriptFunc *Fn, bool fExprOnly)
+void C4AulScript::LinkOverloads(C4AulScriptFunc *Fn)
 {
 	// check if fn overloads other fn (all func tables are built now)
 	// *MUST* check Fn->Owner-list, because it may be the engine (due to linked globals)
@@ -1406,6 +1416,11 @@ void C4AulScript::ParseFn(C4AulScriptFunc *Fn, bool fExprOnly)
 			Fn->OwnerOverloaded->OverloadedBy = Fn;
 	// reset pointer to next same-named func (will be set in AfterLink)
 	Fn->NextSNFunc = nullptr;
+}
+
+void C4AulScript::ParseFn(C4AulScriptFunc *Fn, bool fExprOnly)
+{
+	LinkOverloads(Fn);
 	// store byte code pos
 	// (relative position to code start; code pointer may change while
 	//  parsing)
@@ -3507,6 +3522,26 @@ loopEnd:
 	return result;
 }
 
+void C4AulScript::Optimize()
+{
+	C4AulOptimizer optimizer{Code, static_cast<std::size_t>(CodeSize)};
+	CodeSize = static_cast<int>(optimizer.Optimize());
+	CPos = Code + CodeSize;
+
+	// function entries are still relative to the code start
+	for (C4AulFunc *f = Func0; f; f = f->Next)
+	{
+		C4AulScriptFunc *Fn;
+		if (!(Fn = f->SFunc()))
+		{
+			if (f->LinkedTo) Fn = f->LinkedTo->SFunc();
+			if (Fn) if (Fn->Owner != Engine) Fn = nullptr;
+		}
+		if (Fn)
+			Fn->Code = reinterpret_cast<C4AulBCC *>(optimizer.GetNewPos(reinterpret_cast<std::size_t>(Fn->Code)));
+	}
+}
+
 bool C4AulScript::Parse()
 {
 #if DEBUG_BYTECODE_DUMP
@@ -3531,58 +3566,69 @@ bool C4AulScript::Parse()
 	// reset code and script pos
 	CPos = Code;
 
-	// parse script funcs
+	// byte code of the last link may be reused if nothing changed
+	const auto parseStart = C4AulBytecodeCache::Clock::now();
+	const int iWarnCnt = Engine->warnCnt, iErrCnt = Engine->errCnt;
+	const bool fFromCache = Engine->BytecodeCache.Restore(*this);
+
 	C4AulFunc *f;
-	for (f = Func0; f; f = f->Next)
+	if (!fFromCache)
 	{
-		// check whether it's a script func, or linked to one
-		C4AulScriptFunc *Fn;
-		if (!(Fn = f->SFunc()))
-		{
-			if (f->LinkedTo) Fn = f->LinkedTo->SFunc();
-			// do only parse global funcs, because otherwise, the #append-links get parsed (->code overflow)
-			if (Fn) if (Fn->Owner != Engine) Fn = nullptr;
-		}
-		if (Fn)
+		// parse script funcs
+		for (f = Func0; f; f = f->Next)
 		{
-			// parse function
-			try
+			// check whether it's a script func, or linked to one
+			C4AulScriptFunc *Fn;
+			if (!(Fn = f->SFunc()))
 			{
-				ParseFn(Fn);
+				if (f->LinkedTo) Fn = f->LinkedTo->SFunc();
+				// do only parse global funcs, because otherwise, the #append-links get parsed (->code overflow)
+				if (Fn) if (Fn->Owner != Engine) Fn = nullptr;
 			}
-			catch (const C4AulError &err)
+			if (Fn)
 			{
-				// do not show errors for System.c4g scripts that appear to be pure #appendto scripts
-				if (Fn->Owner->Def || Fn->Owner->Appends.empty())
+				// parse function
+				try
 				{
-					// show
-					err.show();
-					// show a warning if the error is in a remote script
-					if (Fn->pOrgScript != this)
-						DebugLog("  (as #appendto/#include to {})", Fn->Owner->ScriptName);
-					// and count (visible only ;) )
-					++Game.ScriptEngine.errCnt;
+					ParseFn(Fn);
 				}
-				// make all jumps that don't have their destination yet jump here
-				// std::intptr_t to make it work on 64bit
-				for (std::intptr_t i = reinterpret_cast<std::intptr_t>(Fn->Code); i < CPos - Code; i++)
+				catch (const C4AulError &err)
 				{
-					C4AulBCC *pBCC = Code + i;
-					if (IsJumpType(pBCC->bccType))
-						if (!pBCC->bccX)
-							pBCC->bccX = CPos - Code - i;
+					// do not show errors for System.c4g scripts that appear to be pure #appendto scripts
+					if (Fn->Owner->Def || Fn->Owner->Appends.empty())
+					{
+						// show
+						err.show();
+						// show a warning if the error is in a remote script
+						if (Fn->pOrgScript != this)
+							DebugLog("  (as #appendto/#include to {})", Fn->Owner->ScriptName);
+						// and count (visible only ;) )
+						++Game.ScriptEngine.errCnt;
+					}
+					// make all jumps that don't have their destination yet jump here
+					// std::intptr_t to make it work on 64bit
+					for (std::intptr_t i = reinterpret_cast<std::intptr_t>(Fn->Code); i < CPos - Code; i++)
+					{
+						C4AulBCC *pBCC = Code + i;
+						if (IsJumpType(pBCC->bccType))
+							if (!pBCC->bccX)
+								pBCC->bccX = CPos - Code - i;
+					}
+					// add an error chunk
+					AddBCC(AB_ERR);
 				}
-				// add an error chunk
-				AddBCC(AB_ERR);
-			}
 
-			// add separator
-			AddBCC(AB_EOFN);
+				// add separator
+				AddBCC(AB_EOFN);
+			}
 		}
-	}
 
-	// add eof chunk
-	AddBCC(AB_EOF);
+		// add eof chunk
+		AddBCC(AB_EOF);
+
+		if (Config.Developer.OptimizeScripts)
+			Optimize();
+	}
 
 	// calc absolute code addresses for script funcs
 	for (f = Func0; f; f = f->Next)
@@ -3597,6 +3643,11 @@ bool C4AulScript::Parse()
 			Fn->Code = Code + reinterpret_cast<std::intptr_t>(Fn->Code);
 	}
 
+	Engine->BytecodeCache.AddTime(*this, fFromCache, C4AulBytecodeCache::Clock::now() - parseStart);
+	// only cache scripts without messages, so they are shown again on the next link
+	if (!fFromCache && Engine->warnCnt == iWarnCnt && Engine->errCnt == iErrCnt)
+		Engine->BytecodeCache.Store(*this);
+
 	// save line count
 	Engine->lineCnt += SGetLine(Script.getData(), Script.getPtr(Script.getLength()));
 
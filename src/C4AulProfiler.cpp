@@ -0,0 +1,195 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4AulProfiler.h>
+
+#include <C4Aul.h>
+#include <C4Log.h>
+
+#include <algorithm>
+#include <format>
+
+namespace
+{
+	double ToMilliseconds(const C4AulProfiler::Clock::duration duration)
+	{
+		return std::chrono::duration<double, std::milli>{duration}.count();
+	}
+
+	// frames are separated by ';' and the time by the last space
+	std::string GetFrameName(std::string name)
+	{
+		std::replace_if(name.begin(), name.end(), [](const char c) { return c == ';' || c == '\n' || c == '\r'; }, '_');
+		return name;
+	}
+}
+
+void C4AulProfiler::Start(C4AulScript &script)
+{
+	Clear();
+	// frames of the previous run must not be left in this one
+	if (!++Run) ++Run;
+	script.CollectProfilerFuncs(*this);
+	Nodes.push_back({nullptr, 0});
+	fRunning = true;
+	StartTime = Clock::now();
+}
+
+void C4AulProfiler::Stop()
+{
+	if (!fRunning) return;
+	const Clock::time_point now{Clock::now()};
+	while (!Stack.empty())
+		PopFrame(now);
+	TotalTime = now - StartTime;
+	fRunning = false;
+}
+
+void C4AulProfiler::Clear()
+{
+	fRunning = false;
+	TotalTime = {};
+	ListedFuncs.clear();
+	Funcs.clear();
+	Nodes.clear();
+	Stack.clear();
+}
+
+C4AulProfiler::FuncStats &C4AulProfiler::GetStats(C4AulFunc *const func)
+{
+	const auto [it, inserted] = Funcs.try_emplace(func);
+	FuncStats &stats = it->second;
+	if (inserted)
+	{
+		// names are resolved now, as temporary functions are gone at the end
+		if (!func)
+		{
+			stats.Name = "DirectExec";
+			stats.fEngine = false;
+			stats.fListed = true;
+		}
+		else if (C4AulScriptFunc *const sfunc{func->SFunc()})
+		{
+			stats.Name = sfunc->GetFullName();
+			stats.fEngine = false;
+			stats.fListed = ListedFuncs.contains(func);
+		}
+		else
+		{
+			stats.Name = func->Name;
+			stats.fEngine = true;
+			stats.fListed = true;
+		}
+	}
+	return stats;
+}
+
+C4AulProfiler::Frame C4AulProfiler::Enter(C4AulFunc *const func)
+{
+	FuncStats &stats = GetStats(func);
+	const std::size_t parent{Stack.empty() ? 0 : Stack.back().Node};
+	const auto [it, inserted] = Nodes[parent].Children.try_emplace(func, Nodes.size());
+	const std::size_t node{it->second};
+	if (inserted)
+		Nodes.push_back({&stats, parent});
+
+	++Nodes[node].Calls;
+	++stats.Calls;
+	++stats.ActiveCalls;
+	Stack.push_back({node, Clock::now(), {}});
+	return {Run, static_cast<std::uint32_t>(Stack.size())};
+}
+
+void C4AulProfiler::LeaveFrames(const std::size_t depth)
+{
+	const Clock::time_point now{Clock::now()};
+	while (depth && Stack.size() >= depth)
+		PopFrame(now);
+}
+
+void C4AulProfiler::PopFrame(const Clock::time_point now)
+{
+	const StackEntry entry{Stack.back()};
+	Stack.pop_back();
+
+	const Clock::duration inclusive{now - entry.Start};
+	const Clock::duration exclusive{inclusive - entry.Children};
+	Node &node = Nodes[entry.Node];
+	node.Inclusive += inclusive;
+	node.Exclusive += exclusive;
+	node.Func->Exclusive += exclusive;
+	if (!--node.Func->ActiveCalls)
+		node.Func->Inclusive += inclusive;
+
+	if (!Stack.empty())
+		Stack.back().Children += inclusive;
+}
+
+std::string C4AulProfiler::GetStack(std::size_t node) const
+{
+	std::vector<const FuncStats *> frames;
+	for (; node; node = Nodes[node].Parent)
+		frames.push_back(Nodes[node].Func);
+
+	std::string stack;
+	for (auto it = frames.rbegin(); it != frames.rend(); ++it)
+	{
+		if (!stack.empty()) stack += ';';
+		stack += GetFrameName((*it)->Name);
+		if ((*it)->fEngine) stack += " [engine]";
+	}
+	return stack;
+}
+
+void C4AulProfiler::Show(const std::uint32_t iFindObjectPlanHits, const std::uint32_t iFindObjectPlanMisses)
+{
+	const auto logger = CreateLogger("C4AulProfiler", {.GuiLogLevel = spdlog::level::info, .ShowLoggerNameInGui = false});
+
+	std::vector<const FuncStats *> funcs;
+	for (const auto &[func, stats] : Funcs)
+		if (stats.fListed && stats.Calls)
+			funcs.push_back(&stats);
+	// most expensive first
+	std::sort(funcs.begin(), funcs.end(), [](const FuncStats *const a, const FuncStats *const b) { return a->Exclusive > b->Exclusive; });
+
+	logger->info("Profiler statistics ({:.3f}ms):", ToMilliseconds(TotalTime));
+	for (const bool fEngine : {false, true})
+	{
+		logger->info("==============================");
+		logger->info("{:>10} {:>12} {:>12}  {}", "calls", "inclusive", "exclusive", fEngine ? "engine function" : "script function");
+		for (const FuncStats *const stats : funcs)
+			if (stats->fEngine == fEngine)
+				logger->info("{:>10} {:>10.3f}ms {:>10.3f}ms  {}", stats->Calls, ToMilliseconds(stats->Inclusive), ToMilliseconds(stats->Exclusive), stats->Name);
+	}
+	logger->info("==============================");
+	// search conditions reused by FindObject2, FindObjects and ObjectCount2
+	if (const std::uint32_t iTotal{iFindObjectPlanHits + iFindObjectPlanMisses})
+	{
+		logger->info("FindObject plan cache: {} hits, {} misses ({}% hits)", iFindObjectPlanHits, iFindObjectPlanMisses, std::uint64_t{iFindObjectPlanHits} * 100 / iTotal);
+	}
+}
+
+bool C4AulProfiler::SaveCollapsedStacks(const char *const szFilename) const
+{
+	std::string output;
+	for (std::size_t i{1}; i < Nodes.size(); ++i)
+	{
+		const auto time = std::chrono::duration_cast<std::chrono::microseconds>(Nodes[i].Exclusive).count();
+		if (time > 0)
+			output += std::format("{} {}\n", GetStack(i), time);
+	}
+	return StdStrBuf{output.c_str(), output.size(), false}.SaveToFile(szFilename);
+}
@@ -0,0 +1,124 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// Hierarchical script profiler
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class C4AulFunc;
+class C4AulScript;
+
+// Records the time spent in script and engine functions per call stack.
+// The flat report lists the functions of the profiled script and all engine
+// functions, the collapsed stacks file (one "frame;frame;frame time" line per
+// call stack, time in microseconds) can be fed to flamegraph tooling.
+class C4AulProfiler
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	// handle of an entered call; leaving it also leaves all calls above it,
+	// which haven't been left because of a script error
+	struct Frame
+	{
+		std::uint32_t Run{0}; // 0: not recorded
+		std::uint32_t Depth{0};
+	};
+
+	// records an engine function call or DirectExec until the end of the scope
+	class Scope
+	{
+	public:
+		Scope(C4AulProfiler &profiler, C4AulFunc *func) : profiler{profiler}, frame{profiler.IsRunning() ? profiler.Enter(func) : Frame{}} {}
+		~Scope() { profiler.Leave(frame); }
+
+		Scope(const Scope &) = delete;
+		Scope &operator=(const Scope &) = delete;
+
+	private:
+		C4AulProfiler &profiler;
+		Frame frame;
+	};
+
+private:
+	struct FuncStats
+	{
+		std::string Name;
+		bool fEngine;
+		bool fListed; // shown in the flat report
+		std::uint64_t Calls{0};
+		Clock::duration Inclusive{}; // recursive calls are only counted once
+		Clock::duration Exclusive{};
+		std::int32_t ActiveCalls{0};
+	};
+
+	struct Node
+	{
+		FuncStats *Func;
+		std::size_t Parent;
+		std::uint64_t Calls{0};
+		Clock::duration Inclusive{};
+		Clock::duration Exclusive{};
+		std::unordered_map<C4AulFunc *, std::size_t> Children;
+	};
+
+	struct StackEntry
+	{
+		std::size_t Node;
+		Clock::time_point Start;
+		Clock::duration Children;
+	};
+
+	std::uint32_t Run{0};
+	bool fRunning{false};
+	Clock::time_point StartTime;
+	Clock::duration TotalTime{};
+	std::unordered_set<C4AulFunc *> ListedFuncs;
+	std::unordered_map<C4AulFunc *, FuncStats> Funcs; // nullptr: DirectExec
+	std::vector<Node> Nodes; // first one is the root
+	std::vector<StackEntry> Stack;
+
+	FuncStats &GetStats(C4AulFunc *func);
+	void LeaveFrames(std::size_t depth);
+	void PopFrame(Clock::time_point now);
+	std::string GetStack(std::size_t node) const;
+
+public:
+	bool IsRunning() const { return fRunning; }
+
+	void Start(C4AulScript &script); // profiles all calls; the flat report is restricted to the script
+	void Stop(); // leaves all open calls
+	void Clear();
+	void AddListedFunc(C4AulFunc *func) { ListedFuncs.insert(func); }
+
+	Frame Enter(C4AulFunc *func);
+	void Leave(Frame frame) { if (frame.Run && frame.Run == Run && fRunning) LeaveFrames(frame.Depth); }
+
+	void Show(std::uint32_t iFindObjectPlanHits, std::uint32_t iFindObjectPlanMisses);
+	bool SaveCollapsedStacks(const char *szFilename) const;
+
+	static void Abort();
+	static void StartProfiling(C4AulScript *pScript);
+	static void StopProfiling(const char *szFilename = nullptr); // shows the report and saves the collapsed stacks if a file is given
+	static bool IsProfiling();
+};
@@ -692,7 +692,7 @@ void C4Command::Grab()
 		// Scaling or hangling: let go
 		if ((cObj->GetProcedure() == DFA_SCALE) || (cObj->GetProcedure() == DFA_HANGLE))
 			ObjectComLetGo(cObj, (cObj->Action.Dir == DIR_Left) ? +1 : -1);
-		if (!Target->Call(PSF_RejectGrabbed, {C4VObj(cObj)}).getBool())
+		if (!Target->Call(PSFSlot_RejectGrabbed, {C4VObj(cObj)}).getBool())
 		{
 			// Grab
 			cObj->Action.ComDir = COMD_Stop;
@@ -1094,7 +1094,7 @@ bool C4Command::GetTryEnter()
 	// No minimum con knowledge vehicles/items: fail
 	if (Target->Contained && CheckMinimumCon(Target)) { /* fail??! */ return false; }
 	// Target contained and container has RejectContents: fail
-	if (Target->Contained && Target->Contained->Call(PSF_RejectContents)) { Finish(); return false; }
+	if (Target->Contained && Target->Contained->Call(PSFSlot_RejectContents)) { Finish(); return false; }
 	// Collection limit: drop other object
 	// return after drop, so multiple objects may be dropped
 	if (cObj->Def->CollectionLimit && (cObj->Contents.ObjectCount() >= cObj->Def->CollectionLimit))
@@ -1121,7 +1121,7 @@ bool C4Command::GetTryEnter()
 	// if not successfully entered for any other reason, fail
 	if (!fSuccess) { Finish(); return false; }
 	// get-callback for getting out of containers
-	if (fWasContained) cObj->Call(PSF_Get, {C4VObj(Target)});
+	if (fWasContained) cObj->Call(PSFSlot_Get, {C4VObj(Target)});
 	// entered
 	return true;
 }
@@ -1141,6 +1141,7 @@ void C4Command::Get()
 		{
 			Finish(); return;
 		}
+	RegisterTargets();
 
 	// No target: failure
 	if (!Target) { Finish(); return; }
@@ -1324,7 +1325,10 @@ void C4Command::Activate()
 	// No container specified: determine container by target object
 	if (!Target2)
 		if (Target)
+		{
 			Target2 = Target->Contained;
+			RegisterTargets();
+		}
 
 	// No container specified: fail
 	if (!Target2) { Finish(); return; }
@@ -1345,7 +1349,7 @@ void C4Command::Activate()
 					if (pObj->Status && (pObj->Def->id == static_cast<C4ID>(Data)))
 						if (!pObj->Command || (pObj->Command->Command != C4CMD_Exit))
 						{
-							Target = pObj; break;
+							Target = pObj; RegisterTargets(); break;
 						}
 			// No target
 			if (!Target) { Finish(); return; }
@@ -1392,6 +1396,7 @@ void C4Command::Put() // Notice: Put command is currently using Ty as an interna
 		{
 			Finish(); return;
 		}
+	RegisterTargets();
 
 	// No thing to put specified
 	if (!Target2)
@@ -1403,6 +1408,7 @@ void C4Command::Put() // Notice: Put command is currently using Ty as an interna
 		{
 			Finish(true); return;
 		}
+	RegisterTargets();
 
 	// Thing is in target
 	if (Target2->Contained == Target)
@@ -1996,6 +2002,7 @@ void C4Command::Buy()
 				Target = pBase;
 	// No target (base) object: fail
 	if (!Target) { Finish(); return; }
+	RegisterTargets();
 	// No type to buy specified: open buy menu for base
 	if (!Data)
 	{
@@ -2049,6 +2056,7 @@ void C4Command::Sell()
 				Target = pBase;
 	// No target (base) object: fail
 	if (!Target) { Finish(); return; }
+	RegisterTargets();
 	// No type to sell specified: open sell menu for base
 	if (!Data)
 	{
@@ -2257,7 +2265,11 @@ void C4Command::Energy()
 		Finish(true); return;
 	}
 	// No energy supply specified: find one
-	if (!Target2) Target2 = Game.FindObject(0, Target->x, Target->y, -1, -1, OCF_PowerSupply, nullptr, nullptr, Target);
+	if (!Target2)
+	{
+		Target2 = Game.FindObject(0, Target->x, Target->y, -1, -1, OCF_PowerSupply, nullptr, nullptr, Target);
+		RegisterTargets();
+	}
 	// No energy supply: fail
 	if (!Target2) { Finish(); return; }
 	// Energy supply too far away: fail
@@ -2295,6 +2307,7 @@ void C4Command::Energy()
 			Target2 = pLine->Action.Target2;
 		else
 			Target2 = pLine->Action.Target;
+		RegisterTargets();
 	}
 	// Move to target
 	if (!Target->At(cObj->x, cObj->y, ocf))
@@ -2328,6 +2341,7 @@ void C4Command::Home()
 				Target = pBase;
 	// No base: fail
 	if (!Target) { Finish(); return; }
+	RegisterTargets();
 	// Enter base
 	cObj->AddCommand(C4CMD_Enter, Target);
 }
@@ -2344,6 +2358,7 @@ void C4Command::Set(int32_t iCommand, C4Object *pObj, C4Object *pTarget, C4Value
 	Target = pTarget;
 	Tx = nTx; Ty = iTy;
 	Target2 = pTarget2;
+	RegisterTargets();
 	Data = iData;
 	UpdateInterval = iUpdateInterval;
 	Evaluated = fEvaluated;
@@ -2506,3 +2521,17 @@ C4Command *C4Command::GetBaseCommand() const
 	}
 	return nullptr;
 }
+
+void C4Command::RegisterTargets()
+{
+	if (!cObj) return;
+	cObj->RegisterReference(Target);
+	cObj->RegisterReference(Target2);
+}
+
+void C4Command::ReleaseTargets()
+{
+	if (!cObj) return;
+	cObj->ReleaseReference(Target);
+	cObj->ReleaseReference(Target2);
+}
@@ -100,6 +100,7 @@ public:
 	void Clear();
 	void Execute();
 	void ClearPointers(C4Object *pObj);
+	void ReleaseTargets(); // after removal from the command stack: drop registrations of cObj that are no longer needed
 	void Default();
 	void EnumeratePointers();
 	void DenumeratePointers();
@@ -145,6 +146,7 @@ protected:
 	bool InitEvaluation();
 	int32_t GetExpGain(); // get control counts gained by this command; 1EXP=5 ControlCounts
 	bool CheckMinimumCon(C4Object *pObj);
+	void RegisterTargets(); // register cObj as referrer of the targets, see C4Object::RegisterReference
 
 private:
 	C4Command *GetBaseCommand() const;
@@ -107,8 +107,10 @@
 #define C4CFN_MapFolderData "FolderMap.txt"
 #define C4CFN_MapFolderBG   "FolderMap"
 
-#define C4CFN_Language  "Language*.txt"
-#define C4CFN_KeyConfig "KeyConfig.txt"
+#define C4CFN_Language      "Language*.txt"
+#define C4CFN_KeyConfig     "KeyConfig.txt"
+#define C4CFN_ScriptCache   "ScriptCache"
+#define C4CFN_ScriptProfile "ScriptProfile.txt"
 
 #define C4CFN_Log    "Clonk.log"
 #define C4CFN_LogEx  "Clonk{}.log" // created if regular logfile is in use
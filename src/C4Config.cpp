@@ -83,6 +83,7 @@ void C4ConfigGeneral::CompileFunc(StdCompiler *pComp)
 #endif
 	pComp->Value(mkNamingAdapt(FPS,                     "FPS",                     false,         false, true));
 	pComp->Value(mkNamingAdapt(Record,                  "Record",                  false,         false, true));
+	pComp->Value(mkNamingAdapt(RecordKeyframeInterval,  "RecordKeyframeInterval",  0,             false, true));
 	pComp->Value(mkNamingAdapt(ScreenshotFolder,        "ScreenshotFolder",        "Screenshots", false, true));
 	pComp->Value(mkNamingAdapt(FairCrew,                "NoCrew",                  false,         false, true));
 	pComp->Value(mkNamingAdapt(FairCrewStrength,        "DefCrewStrength",         1000,          false, true));
@@ -136,6 +137,8 @@ void C4ConfigDeveloper::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(AutoFileReload, "AutoFileReload", true, false, true));
 	pComp->Value(mkNamingAdapt(ConsoleScriptStrictness, "ConsoleScriptStrictness", ConsoleScriptStrictnessWrapper{ConsoleScriptStrictnessWrapper::MaxStrictSentinel}));
+	pComp->Value(mkNamingAdapt(SyncCheckDetails, "SyncCheckDetails", false));
+	pComp->Value(mkNamingAdapt(OptimizeScripts, "OptimizeScripts", true));
 }
 
 void C4ConfigGraphics::CompileFunc(StdCompiler *pComp)
@@ -185,6 +188,7 @@ void C4ConfigGraphics::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(DisableGamma,         "DisableGamma",         false, false, true));
 	pComp->Value(mkNamingAdapt(Monitor,              "Monitor",              0)); // 0 = D3DADAPTER_DEFAULT
 	pComp->Value(mkNamingAdapt(FireParticles,        "FireParticles",        true,  false, true));
+	pComp->Value(mkNamingAdapt(ParallelParticles,    "ParallelParticles",    true,  false, true));
 	pComp->Value(mkNamingAdapt(MaxRefreshDelay,      "MaxRefreshDelay",      30));
 	pComp->Value(mkNamingAdapt(Shader,               "Shader",               false, false, true));
 	pComp->Value(mkNamingAdapt(AutoFrameSkip,        "AutoFrameSkip",        true,  false, true));
@@ -66,6 +66,7 @@ public:
 	char MissionAccess[CFG_MaxString + 1];
 	bool FPS;
 	bool Record;
+	int32_t RecordKeyframeInterval; // frames between game state snapshots in records for seeking; each one synchronizes the game like a runtime record start; 0 (default) to disable
 	bool FairCrew;   // don't use permanent crew physicals
 	int32_t FairCrewStrength; // strength of clonks in fair crew mode
 	int32_t MouseAScroll; // auto scroll strength
@@ -115,6 +116,8 @@ public:
 public:
 	bool AutoFileReload;
 	ConsoleScriptStrictnessWrapper ConsoleScriptStrictness;
+	bool SyncCheckDetails; // send per-tile and per-object hashes with sync checks to locate desyncs
+	bool OptimizeScripts; // fold constants and use superinstructions in parsed script byte code
 
 	void CompileFunc(StdCompiler *pComp);
 };
@@ -160,6 +163,7 @@ public:
 	bool DisableGamma;
 	int32_t Monitor; // monitor index to play on
 	bool FireParticles; // draw extended fire particles if enabled (defualt on)
+	bool ParallelParticles; // execute particles on the thread pool after all objects have been executed
 	int32_t MaxRefreshDelay; // minimum time after which graphics should be refreshed (ms)
 	bool AutoFrameSkip; // if true, gfx frames are skipped when they would slow down the game
 	int32_t CacheTexturesInRAM; // -1 for disabled; otherwise after CacheTexturesInRAM times of Locking, Unlock(true) keeps the texture in RAM
@@ -27,10 +27,12 @@
 #include <C4Log.h>
 #include <C4Wrappers.h>
 #include <C4Player.h>
+#include <C4SyncHash.h>
 
 #include <cassert>
 #include <cinttypes>
 #include <format>
+#include <unordered_map>
 
 #include <fmt/printf.h>
 
@@ -455,6 +457,19 @@ void C4ControlSyncCheck::Set()
 	ObjectCount = Game.Objects.ObjectCount();
 	ObjectEnumerationIndex = Game.ObjectEnumerationIndex;
 	SectShapeSum = Game.Objects.Sectors.getShapeSum();
+	// game state hashes; the landscape hash is kept up to date by C4Landscape
+	const bool fDetails = Config.Developer.SyncCheckDetails;
+	LandscapeHash = Game.Landscape.GetSyncHash();
+	LandscapeTilesPitch = fDetails ? Game.Landscape.GetSyncHashTilesPitch() : 0;
+	if (fDetails) LandscapeTileHashes = Game.Landscape.GetSyncHashTiles();
+	ObjectHash = 0;
+	for (C4ObjectLink *clnk = Game.Objects.First; clnk; clnk = clnk->Next)
+		if (clnk->Obj->Status)
+		{
+			const uint64_t hash = clnk->Obj->GetSyncHash();
+			ObjectHash = C4SyncHash::Combine(ObjectHash, hash);
+			if (fDetails) ObjectHashes.push_back({clnk->Obj->Number, hash});
+		}
 }
 
 int32_t C4ControlSyncCheck::GetAllCrewPosX()
@@ -489,7 +504,9 @@ void C4ControlSyncCheck::Execute(const std::shared_ptr<spdlog::logger> &) const
 		|| MassMoverIndex         != pSyncCheck->MassMoverIndex
 		|| ObjectCount            != pSyncCheck->ObjectCount
 		|| ObjectEnumerationIndex != pSyncCheck->ObjectEnumerationIndex
-		|| SectShapeSum           != pSyncCheck->SectShapeSum)
+		|| SectShapeSum           != pSyncCheck->SectShapeSum
+		|| LandscapeHash          != pSyncCheck->LandscapeHash
+		|| ObjectHash             != pSyncCheck->ObjectHash)
 	{
 		const char *szThis = "Client", *szOther = Game.Control.isReplay() ? "Rec " : "Host";
 		if (iByClient != Game.Control.ClientID())
@@ -500,6 +517,9 @@ void C4ControlSyncCheck::Execute(const std::shared_ptr<spdlog::logger> &) const
 		LogFatalNTr("Network: Synchronization loss!");
 		LogFatalNTr("Network: {} Frm {} Ctrl {} Rnc {} Rn3 {} Cpx {} PXS {} MMi {} Obc {} Oei {} Sct {}", szThis,            Frame,           ControlTick,           RandomCount,           Random3,           AllCrewPosX,           PXSCount,           MassMoverIndex,           ObjectCount,           ObjectEnumerationIndex,           SectShapeSum);
 		LogFatalNTr("Network: {} Frm {} Ctrl {} Rnc {} Rn3 {} Cpx {} PXS {} MMi {} Obc {} Oei {} Sct {}", szOther, SyncCheck.Frame, SyncCheck.ControlTick, SyncCheck.RandomCount, SyncCheck.Random3, SyncCheck.AllCrewPosX, SyncCheck.PXSCount, SyncCheck.MassMoverIndex, SyncCheck.ObjectCount, SyncCheck.ObjectEnumerationIndex, SyncCheck.SectShapeSum);
+		LogFatalNTr("Network: {} Lsh {:016x} Obh {:016x}", szThis,  LandscapeHash,           ObjectHash);
+		LogFatalNTr("Network: {} Lsh {:016x} Obh {:016x}", szOther, SyncCheck.LandscapeHash, SyncCheck.ObjectHash);
+		LogHashMismatches(SyncCheck, szThis, szOther);
 		StartSoundEffect("SyncError");
 #ifndef NDEBUG
 		// Debug safe
@@ -531,9 +551,69 @@ void C4ControlSyncCheck::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(ObjectCount),            "ObjectCount",             0));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(ObjectEnumerationIndex), "ObjectEnumerationIndex",  0));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(SectShapeSum),           "SectShapeSum",            0));
+	pComp->Value(mkNamingAdapt(LandscapeHash,                          "LandscapeHash",           0u));
+	pComp->Value(mkNamingAdapt(ObjectHash,                             "ObjectHash",              0u));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(LandscapeTilesPitch),    "LandscapeTilesPitch",     0));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(LandscapeTileHashes), "LandscapeTileHashes",   std::vector<uint64_t>{}));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(ObjectHashes),      "ObjectHashes",            std::vector<ObjectHashEntry>{}));
 	C4ControlPacket::CompileFunc(pComp);
 }
 
+void C4ControlSyncCheck::ObjectHashEntry::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkIntPackAdapt(Number));
+	pComp->Separator();
+	pComp->Value(Hash);
+}
+
+void C4ControlSyncCheck::LogHashMismatches(const C4ControlSyncCheck &other, const char *szThis, const char *szOther) const
+{
+	// narrow mismatching hashes down to landscape tiles and objects, if both sides sent details
+	constexpr int32_t MaxLines = 20;
+	if (LandscapeHash != other.LandscapeHash && !LandscapeTileHashes.empty()
+		&& LandscapeTilesPitch == other.LandscapeTilesPitch && LandscapeTileHashes.size() == other.LandscapeTileHashes.size())
+	{
+		int32_t iLines = 0;
+		for (size_t i = 0; i < LandscapeTileHashes.size() && iLines < MaxLines; ++i)
+			if (LandscapeTileHashes[i] != other.LandscapeTileHashes[i])
+			{
+				const int32_t x = static_cast<int32_t>(i % LandscapeTilesPitch) * C4LS_SyncHashTileSize, y = static_cast<int32_t>(i / LandscapeTilesPitch) * C4LS_SyncHashTileSize;
+				LogFatalNTr("Network: Landscape differs in {}/{}-{}/{}", x, y, x + C4LS_SyncHashTileSize - 1, y + C4LS_SyncHashTileSize - 1);
+				++iLines;
+			}
+	}
+
+	if (ObjectHash != other.ObjectHash && !ObjectHashes.empty() && !other.ObjectHashes.empty())
+	{
+		// objects are matched by number, because the order might differ as well
+		std::unordered_map<int32_t, uint64_t> otherHashes;
+		for (const auto &entry : other.ObjectHashes) otherHashes.emplace(entry.Number, entry.Hash);
+		int32_t iLines = 0;
+		const auto logObject = [&iLines](const int32_t iNumber, const char *szState)
+		{
+			if (iLines++ >= MaxLines) return;
+			if (C4Object *const pObj = Game.Objects.SafeObjectPointer(iNumber))
+				LogFatalNTr("Network: Object #{} ({}) at {}/{} {}", iNumber, pObj->GetName(), pObj->x, pObj->y, szState);
+			else
+				LogFatalNTr("Network: Object #{} {}", iNumber, szState);
+		};
+		for (const auto &entry : ObjectHashes)
+		{
+			const auto it = otherHashes.find(entry.Number);
+			if (it == otherHashes.end())
+				logObject(entry.Number, std::format("only exists on {}", szThis).c_str());
+			else
+			{
+				if (it->second != entry.Hash) logObject(entry.Number, "differs");
+				otherHashes.erase(it);
+			}
+		}
+		for (const auto &[iNumber, hash] : otherHashes)
+			logObject(iNumber, std::format("only exists on {}", szOther).c_str());
+		if (!iLines) LogFatalNTr("Network: Object order differs");
+	}
+}
+
 // *** C4ControlSynchronize
 
 void C4ControlSynchronize::Execute(const std::shared_ptr<spdlog::logger> &) const
@@ -27,6 +27,7 @@
 
 #include <format>
 #include <string>
+#include <vector>
 
 class C4Record;
 
@@ -214,6 +215,21 @@ protected:
 	int32_t ObjectCount;
 	int32_t ObjectEnumerationIndex;
 	int32_t SectShapeSum;
+	uint64_t LandscapeHash;
+	uint64_t ObjectHash;
+
+	// hashes of the single landscape tiles and objects, only sent if Config.Developer.SyncCheckDetails is set
+	struct ObjectHashEntry
+	{
+		int32_t Number;
+		uint64_t Hash;
+
+		bool operator==(const ObjectHashEntry &) const = default;
+		void CompileFunc(StdCompiler *pComp);
+	};
+	int32_t LandscapeTilesPitch;
+	std::vector<uint64_t> LandscapeTileHashes;
+	std::vector<ObjectHashEntry> ObjectHashes;
 
 public:
 	void Set();
@@ -223,6 +239,7 @@ public:
 
 protected:
 	static int32_t GetAllCrewPosX();
+	void LogHashMismatches(const C4ControlSyncCheck &other, const char *szThis, const char *szOther) const;
 };
 
 class C4ControlSynchronize : public C4ControlPacket // sync
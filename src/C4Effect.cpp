@@ -68,6 +68,7 @@ C4Effect::C4Effect(C4Object *pForObj, const char *szName, int32_t iPrio, int32_t
 	iTime = 0;
 	pCommandTarget = pCmdTarget;
 	pCommandTarget.Enumerate();
+	if (pForObj) pForObj->RegisterReference(pCmdTarget);
 	idCommandTarget = idCmdTarget;
 	AssignCallbackFunctions();
 	// get effect target
@@ -329,10 +330,12 @@ void C4Effect::Execute(C4Object *pObj)
 		{
 			// delete it, then
 			C4Effect *pNextEffect = pEffect->pNext;
+			C4Object *const pCmdTarget{pEffect->pCommandTarget};
 			pEffect->pNext = nullptr;
 			delete pEffect;
 			// next effect
 			*ppPrevEffect = pEffect = pNextEffect;
+			if (pObj) pObj->ReleaseReference(pCmdTarget);
 		}
 		else
 		{
@@ -603,7 +606,7 @@ int32_t FnFxFireStart(C4AulContext *ctx, C4Object *pObj, int32_t iNumber, int32_
 	{
 		// if object was blasted but not incinerated (i.e., inside extinguisher)
 		// do a script callback
-		if (fBlasted) pObj->Call(PSF_IncinerationEx, {C4VInt(iCausedBy)});
+		if (fBlasted) pObj->Call(PSFSlot_IncinerationEx, {C4VInt(iCausedBy)});
 		return -1;
 	}
 	// determine fire appearance
@@ -635,7 +638,7 @@ int32_t FnFxFireStart(C4AulContext *ctx, C4Object *pObj, int32_t iNumber, int32_
 	if (pObj->Shape.Wdt * pObj->Shape.Hgt > 500) StartSoundEffect("Inflame", false, 100, pObj);
 	if (pObj->Def->Mass >= 100) StartSoundEffect("Fire", true, 100, pObj);
 	// Engine script call
-	pObj->Call(PSF_Incineration, {C4VInt(iCausedBy)});
+	pObj->Call(PSFSlot_Incineration, {C4VInt(iCausedBy)});
 	// Done, success
 	return C4Fx_OK;
 }
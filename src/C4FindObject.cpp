@@ -23,10 +23,40 @@
 #include <C4Random.h>
 
 #include <algorithm>
+#include <bit>
 #include <numeric>
 #include <ranges>
 #include <utility>
 
+namespace
+{
+	// relative costs of checking a condition, see C4FindObjectAnd::UpdatePredicates
+	constexpr int32_t CheckCostField = 0; // comparing an object field
+	constexpr int32_t CheckCostPosition = 1;
+	constexpr int32_t CheckCostDefault = 2; // shapes, strings
+	constexpr int32_t CheckCostCombination = 3;
+	constexpr int32_t CheckCostScript = 4;
+
+	bool CheckInlinePredicate(C4FindObjectPredicate &Pred, C4Object *pObj)
+	{
+		switch (Pred.Type)
+		{
+		case C4FO_Exclude: return pObj != Pred.pObj;
+		case C4FO_ID: return pObj->id == Pred.id;
+		case C4FO_InRect: return Pred.rect.Contains(pObj->x, pObj->y);
+		case C4FO_Distance: return (pObj->x - Pred.rect.x) * (pObj->x - Pred.rect.x) + (pObj->y - Pred.rect.y) * (pObj->y - Pred.rect.y) <= Pred.iValue;
+		case C4FO_OCF: return !!(pObj->OCF & Pred.iValue);
+		case C4FO_Category: return !!(pObj->Category & Pred.iValue);
+		case C4FO_Container: return pObj->Contained == Pred.pObj;
+		case C4FO_AnyContainer: return !!pObj->Contained;
+		case C4FO_Owner: return pObj->Owner == Pred.iValue;
+		case C4FO_Controller: return pObj->Controller == Pred.iValue;
+		case C4FO_Layer: return pObj->pLayer == Pred.pObj;
+		default: assert(!"No inline check for this condition"); return false;
+		}
+	}
+}
+
 // *** C4FindObject
 
 C4FindObject::~C4FindObject()
@@ -161,6 +191,20 @@ C4FindObject *C4FindObject::CreateByValue(const C4Value &DataVal, C4SortObject *
 	return nullptr;
 }
 
+bool C4FindObject::RebindByValue(const C4Value &DataVal)
+{
+	// Must be an array
+	C4ValueArray *pArray = C4Value(DataVal).getArray();
+	if (!pArray) return false;
+
+	const C4ValueArray &Data = *pArray;
+	// Trivial combinations are created as their only condition
+	const auto iType = Data[0].getInt();
+	if ((iType == C4FO_And || iType == C4FO_Or) && Data.GetSize() == 2)
+		return RebindByValue(Data[1]);
+	return Rebind(Data);
+}
+
 int32_t C4FindObject::Count(const C4ObjectList &Objs)
 {
 	// Trivial cases
@@ -168,6 +212,9 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs)
 		return 0;
 	if (IsEnsured())
 		return Objs.ObjectCount();
+	// Indexed?
+	if (auto candidates = GetIndexedCandidates(Objs, nullptr))
+		return CountCandidates(std::move(*candidates));
 	// Count
 	int32_t iCount = 0;
 	for (C4ObjectLink *pLnk = Objs.First; pLnk; pLnk = pLnk->Next)
@@ -182,6 +229,9 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs)
 	// Trivial case
 	if (IsImpossible())
 		return nullptr;
+	// Indexed?
+	if (auto candidates = GetIndexedCandidates(Objs, nullptr))
+		return FindCandidates(std::move(*candidates));
 	// Search
 	// Double-check object status, as object might be deleted after Check()!
 	C4Object *pBestResult = nullptr;
@@ -205,6 +255,9 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs)
 	// Trivial case
 	if (IsImpossible())
 		return new C4ValueArray();
+	// Indexed?
+	if (auto candidates = GetIndexedCandidates(Objs, nullptr))
+		return FindManyCandidates(std::move(*candidates));
 	// Set up array
 	std::vector<C4Object *> result;
 	// Search
@@ -236,6 +289,9 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 	C4Rect *pBounds = GetBounds();
 	if (!pBounds)
 		return Count(Objs);
+	// Unlike the area traversal order, the index order doesn't matter for the count
+	else if (auto candidates = GetIndexedCandidates(Objs, pBounds))
+		return CountCandidates(std::move(*candidates));
 	else if (UseShapes())
 	{
 		// Get area
@@ -280,6 +336,7 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs, const C4LSectors &Sct)
 	if (!pBounds)
 		return Find(Objs);
 	// Traverse areas, return first matching object w/o sort or best with sort
+	// The index isn't used here, as the result depends on the traversal order
 	else if (UseShapes())
 	{
 		C4LArea Area(&Game.Objects.Sectors, *pBounds); C4LSector *pSct;
@@ -315,6 +372,7 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 	C4Rect *pBounds = GetBounds();
 	if (!pBounds)
 		return FindMany(Objs);
+	// The index isn't used here, as the order of the result (and of equally ranked objects when sorting) depends on the traversal order
 
 	std::vector<C4Object *> result;
 	// Check shape lists?
@@ -364,6 +422,74 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 	return new C4ValueArray{std::span{result}};
 }
 
+std::optional<std::vector<C4Object *>> C4FindObject::GetIndexedCandidates(const C4ObjectList &Objs, const C4Rect *pBounds)
+{
+	// only the main object list is indexed
+	if (&Objs != &Game.Objects) return std::nullopt;
+	// pick the smaller index
+	const C4GameObjects::TypeIndexObjects *pCandidates = nullptr;
+	if (const C4ID idBound = GetIDBound(); idBound != C4ID_None)
+		pCandidates = &Game.Objects.ObjectsByID(idBound);
+	if (const uint32_t dwCategoryBound = GetCategoryBound())
+		if (const auto &objects = Game.Objects.ObjectsByCategory(dwCategoryBound); !pCandidates || objects.size() < pCandidates->size())
+			pCandidates = &objects;
+	if (!pCandidates) return std::nullopt;
+	// compare to the objects estimated to be within the sectors covered by the bounds
+	if (pBounds)
+	{
+		const C4LSectors &Sectors = Game.Objects.Sectors;
+		const int64_t iSectorCount = std::clamp<int64_t>(
+			(int64_t{pBounds->Wdt} / C4LSectorWdt + 2) * (int64_t{pBounds->Hgt} / C4LSectorHgt + 2), 1, std::max(Sectors.Size, 1));
+		if (Game.Objects.IndexedObjectCount() * iSectorCount / std::max(Sectors.Size, 1) < static_cast<int64_t>(pCandidates->size()))
+			return std::nullopt;
+	}
+	const auto objects = std::views::values(*pCandidates);
+	return std::vector<C4Object *>{objects.begin(), objects.end()};
+}
+
+int32_t C4FindObject::CountCandidates(std::vector<C4Object *> candidates)
+{
+	int32_t iCount = 0;
+	for (C4Object *const pObj : candidates)
+		if (pObj->Status)
+			if (Check(pObj))
+				iCount++;
+	return iCount;
+}
+
+C4Object *C4FindObject::FindCandidates(std::vector<C4Object *> candidates)
+{
+	// Double-check object status, as object might be deleted after Check()!
+	C4Object *pBestResult = nullptr;
+	for (C4Object *const pObj : candidates)
+		if (pObj->Status)
+			if (Check(pObj))
+				if (pObj->Status)
+				{
+					// no sorting: Use first object found
+					if (!pSort) return pObj;
+					// Sorting: Check if found object is better
+					if (!pBestResult || pSort->Compare(pObj, pBestResult) > 0)
+						if (pObj->Status)
+							pBestResult = pObj;
+				}
+	return pBestResult;
+}
+
+C4ValueArray *C4FindObject::FindManyCandidates(std::vector<C4Object *> candidates)
+{
+	std::erase_if(candidates, [this](C4Object *const pObj) { return !pObj->Status || !Check(pObj); });
+	// Recheck object status (may shrink array again)
+	CheckObjectStatus(candidates);
+	// Apply sorting
+	if (pSort)
+	{
+		pSort->SortObjects(candidates);
+		CheckObjectStatusAfterSort(candidates);
+	}
+	return new C4ValueArray{std::span{candidates}};
+}
+
 void C4FindObject::CheckObjectStatus(std::vector<C4Object *> &objects)
 {
 	std::erase_if(objects, [](C4Object *const obj) { return !obj->Status; });
@@ -392,6 +518,17 @@ bool C4FindObjectNot::Check(C4Object *pObj)
 	return !pCond->Check(pObj);
 }
 
+bool C4FindObjectNot::Rebind(const C4ValueArray &Data)
+{
+	return Data[0].getInt() == C4FO_Not && pCond->RebindByValue(Data[1]);
+}
+
+bool C4FindObjectNot::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.iCost = CheckCostCombination;
+	return false;
+}
+
 // *** C4FindObjectAnd
 
 C4FindObjectAnd::C4FindObjectAnd(int32_t inCnt, C4FindObject **ppConds, bool fFreeArray)
@@ -408,6 +545,15 @@ C4FindObjectAnd::C4FindObjectAnd(int32_t inCnt, C4FindObject **ppConds, bool fFr
 		}
 		else
 			i++;
+	UpdateBounds();
+	UpdatePredicates();
+}
+
+void C4FindObjectAnd::UpdateBounds()
+{
+	fHasBounds = fUseShapes = false;
+	idBound = C4ID_None;
+	dwCategoryBound = 0;
 	// Intersect all child bounds
 	for (int32_t i = 0; i < iCnt; i++)
 	{
@@ -432,6 +578,39 @@ C4FindObjectAnd::C4FindObjectAnd(int32_t inCnt, C4FindObject **ppConds, bool fFr
 			}
 		}
 	}
+	// Take any index bound of the children
+	for (int32_t i = 0; i < iCnt; i++)
+	{
+		if (idBound == C4ID_None) idBound = ppConds[i]->GetIDBound();
+		if (!dwCategoryBound) dwCategoryBound = ppConds[i]->GetCategoryBound();
+	}
+}
+
+void C4FindObjectAnd::UpdatePredicates()
+{
+	// Cheap checks first, keeping the given order of equally expensive ones
+	Predicates.resize(iCnt);
+	for (int32_t i = 0; i < iCnt; i++)
+	{
+		C4FindObjectPredicate &Pred = Predicates[i];
+		Pred.pCond = ppConds[i];
+		Pred.iCost = CheckCostDefault;
+		Pred.fInline = ppConds[i]->GetPredicate(Pred);
+	}
+	std::ranges::stable_sort(Predicates, {}, &C4FindObjectPredicate::iCost);
+}
+
+template<typename GetData>
+bool C4FindObjectAnd::RebindChildren(int32_t iDataCnt, GetData &&getData)
+{
+	// Only possible if no entries were filtered on creation
+	if (iDataCnt != iCnt) return false;
+	for (int32_t i = 0; i < iCnt; i++)
+		if (!ppConds[i]->RebindByValue(getData(i)) || ppConds[i]->IsEnsured())
+			return false;
+	UpdateBounds();
+	UpdatePredicates();
+	return true;
 }
 
 C4FindObjectAnd::~C4FindObjectAnd()
@@ -444,12 +623,24 @@ C4FindObjectAnd::~C4FindObjectAnd()
 
 bool C4FindObjectAnd::Check(C4Object *pObj)
 {
-	for (int32_t i = 0; i < iCnt; i++)
-		if (!ppConds[i]->Check(pObj))
+	for (auto &Pred : Predicates)
+		if (!(Pred.fInline ? CheckInlinePredicate(Pred, pObj) : Pred.pCond->Check(pObj)))
 			return false;
 	return true;
 }
 
+bool C4FindObjectAnd::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_And) return false;
+	return RebindChildren(Data.GetSize() - 1, [&Data](const int32_t i) -> const C4Value & { return Data.GetItem(i + 1); });
+}
+
+bool C4FindObjectAnd::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.iCost = CheckCostCombination;
+	return false;
+}
+
 bool C4FindObjectAnd::IsImpossible()
 {
 	for (int32_t i = 0; i < iCnt; i++)
@@ -474,6 +665,12 @@ C4FindObjectOr::C4FindObjectOr(int32_t inCnt, C4FindObject **ppConds)
 		}
 		else
 			i++;
+	UpdateBounds();
+}
+
+void C4FindObjectOr::UpdateBounds()
+{
+	fHasBounds = false;
 	// Sum up all child bounds
 	for (int32_t i = 0; i < iCnt; i++)
 	{
@@ -519,6 +716,23 @@ bool C4FindObjectOr::IsEnsured()
 	return false;
 }
 
+bool C4FindObjectOr::Rebind(const C4ValueArray &Data)
+{
+	// Only possible if no entries were filtered on creation
+	if (Data[0].getInt() != C4FO_Or || Data.GetSize() - 1 != iCnt) return false;
+	for (int32_t i = 0; i < iCnt; i++)
+		if (!ppConds[i]->RebindByValue(Data[i + 1]) || ppConds[i]->IsImpossible())
+			return false;
+	UpdateBounds();
+	return true;
+}
+
+bool C4FindObjectOr::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.iCost = CheckCostCombination;
+	return false;
+}
+
 // *** C4FindObject* (primitive conditions)
 
 bool C4FindObjectExclude::Check(C4Object *pObj)
@@ -526,6 +740,21 @@ bool C4FindObjectExclude::Check(C4Object *pObj)
 	return pObj != pExclude;
 }
 
+bool C4FindObjectExclude::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_Exclude) return false;
+	pExclude = Data[1].getObj();
+	return true;
+}
+
+bool C4FindObjectExclude::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.Type = C4FO_Exclude;
+	Pred.iCost = CheckCostField;
+	Pred.pObj = pExclude;
+	return true;
+}
+
 bool C4FindObjectID::Check(C4Object *pObj)
 {
 	return pObj->id == id;
@@ -537,6 +766,21 @@ bool C4FindObjectID::IsImpossible()
 	return !pDef || !pDef->Count;
 }
 
+bool C4FindObjectID::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_ID) return false;
+	id = Data[1].getC4ID();
+	return true;
+}
+
+bool C4FindObjectID::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.Type = C4FO_ID;
+	Pred.iCost = CheckCostField;
+	Pred.id = id;
+	return true;
+}
+
 bool C4FindObjectInRect::Check(C4Object *pObj)
 {
 	return rect.Contains(pObj->x, pObj->y);
@@ -547,11 +791,33 @@ bool C4FindObjectInRect::IsImpossible()
 	return !rect.Wdt || !rect.Hgt;
 }
 
+bool C4FindObjectInRect::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_InRect) return false;
+	rect = C4Rect(Data[1].getInt(), Data[2].getInt(), Data[3].getInt(), Data[4].getInt());
+	return true;
+}
+
+bool C4FindObjectInRect::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.Type = C4FO_InRect;
+	Pred.iCost = CheckCostPosition;
+	Pred.rect = rect;
+	return true;
+}
+
 bool C4FindObjectAtPoint::Check(C4Object *pObj)
 {
 	return pObj->Shape.Contains(bounds.x - pObj->x, bounds.y - pObj->y);
 }
 
+bool C4FindObjectAtPoint::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_AtPoint) return false;
+	bounds = C4Rect(Data[1].getInt(), Data[2].getInt(), 1, 1);
+	return true;
+}
+
 bool C4FindObjectAtRect::Check(C4Object *pObj)
 {
 	C4Rect rcShapeBounds = pObj->Shape;
@@ -559,16 +825,51 @@ bool C4FindObjectAtRect::Check(C4Object *pObj)
 	return !!rcShapeBounds.Overlap(bounds);
 }
 
+bool C4FindObjectAtRect::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_AtRect) return false;
+	bounds = C4Rect(Data[1].getInt(), Data[2].getInt(), Data[3].getInt(), Data[4].getInt());
+	return true;
+}
+
 bool C4FindObjectOnLine::Check(C4Object *pObj)
 {
 	return pObj->Shape.IntersectsLine(x - pObj->x, y - pObj->y, x2 - pObj->x, y2 - pObj->y);
 }
 
+bool C4FindObjectOnLine::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_OnLine) return false;
+	x = Data[1].getInt(); y = Data[2].getInt(); x2 = Data[3].getInt(); y2 = Data[4].getInt();
+	bounds = C4Rect(x, y, 1, 1);
+	bounds.Add(C4Rect(x2, y2, 1, 1));
+	return true;
+}
+
 bool C4FindObjectDistance::Check(C4Object *pObj)
 {
 	return (pObj->x - x) * (pObj->x - x) + (pObj->y - y) * (pObj->y - y) <= r2;
 }
 
+bool C4FindObjectDistance::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_Distance) return false;
+	x = Data[1].getInt(); y = Data[2].getInt();
+	const int32_t r = Data[3].getInt();
+	r2 = r * r;
+	bounds = C4Rect(x - r, y - r, 2 * r + 1, 2 * r + 1);
+	return true;
+}
+
+bool C4FindObjectDistance::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.Type = C4FO_Distance;
+	Pred.iCost = CheckCostPosition;
+	Pred.rect.x = x; Pred.rect.y = y;
+	Pred.iValue = r2;
+	return true;
+}
+
 bool C4FindObjectOCF::Check(C4Object *pObj)
 {
 	return !!(pObj->OCF & ocf);
@@ -579,6 +880,21 @@ bool C4FindObjectOCF::IsImpossible()
 	return !ocf;
 }
 
+bool C4FindObjectOCF::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_OCF) return false;
+	ocf = Data[1].getInt();
+	return true;
+}
+
+bool C4FindObjectOCF::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.Type = C4FO_OCF;
+	Pred.iCost = CheckCostField;
+	Pred.iValue = ocf;
+	return true;
+}
+
 bool C4FindObjectCategory::Check(C4Object *pObj)
 {
 	return !!(pObj->Category & iCategory);
@@ -589,11 +905,41 @@ bool C4FindObjectCategory::IsEnsured()
 	return !iCategory;
 }
 
+uint32_t C4FindObjectCategory::GetCategoryBound()
+{
+	// the category index can only serve single categories
+	return std::has_single_bit(static_cast<uint32_t>(iCategory)) ? static_cast<uint32_t>(iCategory) : 0;
+}
+
+bool C4FindObjectCategory::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_Category) return false;
+	iCategory = Data[1].getInt();
+	return true;
+}
+
+bool C4FindObjectCategory::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.Type = C4FO_Category;
+	Pred.iCost = CheckCostField;
+	Pred.iValue = iCategory;
+	return true;
+}
+
 bool C4FindObjectAction::Check(C4Object *pObj)
 {
 	return SEqual(pObj->Action.Name, szAction);
 }
 
+bool C4FindObjectAction::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_Action) return false;
+	C4String *pStr = Data[1].getStr();
+	if (!pStr) return false;
+	szAction = pStr->Data.getData();
+	return true;
+}
+
 bool C4FindObjectActionTarget::Check(C4Object *pObj)
 {
 	assert(index >= 0 && index <= 1);
@@ -605,16 +951,53 @@ bool C4FindObjectActionTarget::Check(C4Object *pObj)
 		return false;
 }
 
+bool C4FindObjectActionTarget::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_ActionTarget) return false;
+	pActionTarget = Data[1].getObj();
+	index = 0;
+	if (Data.GetSize() >= 3)
+		index = static_cast<decltype(index)>(BoundBy<C4ValueInt>(Data[2].getInt(), 0, 1));
+	return true;
+}
+
 bool C4FindObjectContainer::Check(C4Object *pObj)
 {
 	return pObj->Contained == pContainer;
 }
 
+bool C4FindObjectContainer::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_Container) return false;
+	pContainer = Data[1].getObj();
+	return true;
+}
+
+bool C4FindObjectContainer::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.Type = C4FO_Container;
+	Pred.iCost = CheckCostField;
+	Pred.pObj = pContainer;
+	return true;
+}
+
 bool C4FindObjectAnyContainer::Check(C4Object *pObj)
 {
 	return !!pObj->Contained;
 }
 
+bool C4FindObjectAnyContainer::Rebind(const C4ValueArray &Data)
+{
+	return Data[0].getInt() == C4FO_AnyContainer;
+}
+
+bool C4FindObjectAnyContainer::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.Type = C4FO_AnyContainer;
+	Pred.iCost = CheckCostField;
+	return true;
+}
+
 bool C4FindObjectOwner::Check(C4Object *pObj)
 {
 	return pObj->Owner == iOwner;
@@ -625,6 +1008,21 @@ bool C4FindObjectOwner::IsImpossible()
 	return iOwner != NO_OWNER && !ValidPlr(iOwner);
 }
 
+bool C4FindObjectOwner::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_Owner) return false;
+	iOwner = Data[1].getInt();
+	return true;
+}
+
+bool C4FindObjectOwner::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.Type = C4FO_Owner;
+	Pred.iCost = CheckCostField;
+	Pred.iValue = iOwner;
+	return true;
+}
+
 bool C4FindObjectController::Check(C4Object *pObj)
 {
 	return pObj->Controller == controller;
@@ -635,9 +1033,25 @@ bool C4FindObjectController::IsImpossible()
 	return controller != NO_OWNER && !ValidPlr(controller);
 }
 
+bool C4FindObjectController::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_Controller) return false;
+	controller = Data[1].getInt();
+	return true;
+}
+
+bool C4FindObjectController::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.Type = C4FO_Controller;
+	Pred.iCost = CheckCostField;
+	Pred.iValue = controller;
+	return true;
+}
+
 // *** C4FindObjectFunc
 
 C4FindObjectFunc::C4FindObjectFunc(const char *szFunc)
+	: FuncName(szFunc)
 {
 	pFunc = Game.ScriptEngine.GetFirstFunc(szFunc);
 }
@@ -666,6 +1080,27 @@ bool C4FindObjectFunc::IsImpossible()
 	return !pFunc;
 }
 
+bool C4FindObjectFunc::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_Func) return false;
+	C4String *pStr = Data[1].getStr();
+	if (!pStr) return false;
+	if (FuncName != pStr->Data.getData())
+	{
+		FuncName = pStr->Data.getData();
+		pFunc = Game.ScriptEngine.GetFirstFunc(FuncName.c_str());
+	}
+	for (int i = 0; i < C4AUL_MAX_Par; i++)
+		Pars[i] = Data[i + 2];
+	return true;
+}
+
+bool C4FindObjectFunc::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.iCost = CheckCostScript;
+	return false;
+}
+
 // *** C4FindObjectLayer
 
 bool C4FindObjectLayer::Check(C4Object *pObj)
@@ -678,6 +1113,21 @@ bool C4FindObjectLayer::IsImpossible()
 	return false;
 }
 
+bool C4FindObjectLayer::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4FO_Layer) return false;
+	pLayer = Data[1].getObj();
+	return true;
+}
+
+bool C4FindObjectLayer::GetPredicate(C4FindObjectPredicate &Pred)
+{
+	Pred.Type = C4FO_Layer;
+	Pred.iCost = CheckCostField;
+	Pred.pObj = pLayer;
+	return true;
+}
+
 // *** C4SortObject
 
 C4SortObject *C4SortObject::CreateByValue(const C4Value &DataVal)
@@ -757,6 +1207,18 @@ C4SortObject *C4SortObject::CreateByValue(C4ValueInt iType, const C4ValueArray &
 	return nullptr;
 }
 
+bool C4SortObject::RebindByValue(const C4Value &DataVal)
+{
+	// Must be an array
+	const C4ValueArray *pArray = C4Value(DataVal).getArray();
+	if (!pArray) return false;
+	const C4ValueArray &Data = *pArray;
+	// Trivial case (one sort) is created as its only sort
+	if (Data[0].getInt() == C4SO_Multiple && Data.GetSize() == 2)
+		return RebindByValue(Data[1]);
+	return Rebind(Data);
+}
+
 namespace
 {
 	class C4SortObjectSTL
@@ -868,6 +1330,11 @@ int32_t C4SortObjectReverse::CompareCache(int32_t iObj1, int32_t iObj2, C4Object
 	return pSort->CompareCache(iObj2, iObj1, pObj2, pObj1);
 }
 
+bool C4SortObjectReverse::Rebind(const C4ValueArray &Data)
+{
+	return Data[0].getInt() == C4SO_Reverse && pSort->RebindByValue(Data[1]);
+}
+
 C4SortObjectMultiple::~C4SortObjectMultiple()
 {
 	for (int32_t i = 0; i < iCnt; ++i) delete ppSorts[i];
@@ -905,33 +1372,79 @@ int32_t C4SortObjectMultiple::CompareCache(int32_t iObj1, int32_t iObj2, C4Objec
 	return 0;
 }
 
+bool C4SortObjectMultiple::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4SO_Multiple) return false;
+	return RebindChildren(Data.GetSize() - 1, [&Data](const int32_t i) -> const C4Value & { return Data.GetItem(i + 1); });
+}
+
+template<typename GetData>
+bool C4SortObjectMultiple::RebindChildren(int32_t iDataCnt, GetData &&getData)
+{
+	// Only possible if no entries were filtered on creation
+	if (iDataCnt != iCnt) return false;
+	for (int32_t i = 0; i < iCnt; i++)
+		if (!ppSorts[i]->RebindByValue(getData(i)))
+			return false;
+	return true;
+}
+
 int32_t C4SortObjectDistance::CompareGetValue(C4Object *pFor)
 {
 	int32_t dx = pFor->x - iX, dy = pFor->y - iY;
 	return dx * dx + dy * dy;
 }
 
+bool C4SortObjectDistance::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4SO_Distance) return false;
+	iX = Data[1].getInt();
+	iY = Data[2].getInt();
+	return true;
+}
+
 int32_t C4SortObjectRandom::CompareGetValue(C4Object *pFor)
 {
 	return Random(1 << 16);
 }
 
+bool C4SortObjectRandom::Rebind(const C4ValueArray &Data)
+{
+	return Data[0].getInt() == C4SO_Random;
+}
+
 int32_t C4SortObjectSpeed::CompareGetValue(C4Object *pFor)
 {
 	return pFor->xdir * pFor->xdir + pFor->ydir * pFor->ydir;
 }
 
+bool C4SortObjectSpeed::Rebind(const C4ValueArray &Data)
+{
+	return Data[0].getInt() == C4SO_Speed;
+}
+
 int32_t C4SortObjectMass::CompareGetValue(C4Object *pFor)
 {
 	return pFor->Mass;
 }
 
+bool C4SortObjectMass::Rebind(const C4ValueArray &Data)
+{
+	return Data[0].getInt() == C4SO_Mass;
+}
+
 int32_t C4SortObjectValue::CompareGetValue(C4Object *pFor)
 {
 	return pFor->GetValue(nullptr, NO_OWNER);
 }
 
+bool C4SortObjectValue::Rebind(const C4ValueArray &Data)
+{
+	return Data[0].getInt() == C4SO_Value;
+}
+
 C4SortObjectFunc::C4SortObjectFunc(const char *szFunc)
+	: FuncName(szFunc)
 {
 	pFunc = Game.ScriptEngine.GetFirstFunc(szFunc);
 }
@@ -954,3 +1467,138 @@ int32_t C4SortObjectFunc::CompareGetValue(C4Object *pObj)
 	// Call
 	return pCallFunc->Exec(pObj, Pars, true).getInt();
 }
+
+bool C4SortObjectFunc::Rebind(const C4ValueArray &Data)
+{
+	if (Data[0].getInt() != C4SO_Func) return false;
+	C4String *pStr = Data[1].getStr();
+	if (!pStr) return false;
+	if (FuncName != pStr->Data.getData())
+	{
+		FuncName = pStr->Data.getData();
+		pFunc = Game.ScriptEngine.GetFirstFunc(FuncName.c_str());
+	}
+	for (int i = 0; i < C4AUL_MAX_Par; i++)
+		Pars[i] = Data[i + 2];
+	return true;
+}
+
+// *** C4FindObjectPlanCache
+
+C4FindObjectPlanCache::Lease C4FindObjectPlanCache::Acquire(const C4AulBCC *pCallSite, const C4Value *pPars, bool fWithSort)
+{
+	Lease lease;
+	// Reuse the conditions of the previous call from here
+	std::shared_ptr<Plan> *pCached = nullptr;
+	if (pCallSite)
+	{
+		pCached = &Plans[pCallSite];
+		Plan *pPlan = pCached->get();
+		if (pPlan && !pPlan->fInUse && pPlan->fWithSort == fWithSort && Rebind(*pPlan, pPars))
+		{
+			++iHits;
+			pPlan->fInUse = true;
+			lease.pCond = pPlan->Cond.get();
+			lease.plan = *pCached;
+			return lease;
+		}
+	}
+	++iMisses;
+	std::shared_ptr<Plan> compiled = Compile(pPars, fWithSort);
+	if (!compiled) return lease;
+	lease.pCond = compiled->Cond.get();
+	// Cache it if following calls will be able to rebind it
+	if (pCached && !(*pCached && (*pCached)->fInUse) && Rebind(*compiled, pPars))
+	{
+		compiled->fInUse = true;
+		*pCached = compiled;
+		lease.plan = std::move(compiled);
+	}
+	else
+		lease.owned = std::move(compiled->Cond);
+	return lease;
+}
+
+void C4FindObjectPlanCache::Clear()
+{
+	// plans still in use are kept alive by their leases
+	Plans.clear();
+}
+
+std::shared_ptr<C4FindObjectPlanCache::Plan> C4FindObjectPlanCache::Compile(const C4Value *pPars, bool fWithSort)
+{
+	auto plan = std::make_shared<Plan>();
+	plan->fWithSort = fWithSort;
+	// Read all parameters
+	C4FindObject *pFOs[C4AUL_MAX_Par];
+	C4SortObject *pSOs[C4AUL_MAX_Par];
+	for (int32_t i = 0; i < C4AUL_MAX_Par; i++)
+	{
+		const C4Value &Data = pPars[i].GetRefVal();
+		// No data given?
+		if (!Data) break;
+		// Construct
+		C4SortObject *pSO = nullptr;
+		if (C4FindObject *pFO = C4FindObject::CreateByValue(Data, fWithSort ? &pSO : nullptr))
+			pFOs[plan->iCondCnt++] = pFO;
+		if (pSO)
+			pSOs[plan->iSortCnt++] = pSO;
+	}
+	// No criterions?
+	if (!plan->iCondCnt)
+	{
+		for (int32_t i = 0; i < plan->iSortCnt; ++i) delete pSOs[i];
+		return nullptr;
+	}
+	// Create search object
+	if (plan->iCondCnt == 1)
+		plan->Cond.reset(pFOs[0]);
+	else
+	{
+		C4FindObject **ppConds = new C4FindObject *[plan->iCondCnt];
+		std::copy_n(pFOs, plan->iCondCnt, ppConds);
+		plan->Cond.reset(plan->pAnd = new C4FindObjectAnd(plan->iCondCnt, ppConds));
+	}
+	// Create sort criterion
+	if (plan->iSortCnt == 1)
+		plan->pSort = pSOs[0];
+	else if (plan->iSortCnt)
+	{
+		C4SortObject **ppSorts = new C4SortObject *[plan->iSortCnt];
+		std::copy_n(pSOs, plan->iSortCnt, ppSorts);
+		plan->pSort = plan->pSortMultiple = new C4SortObjectMultiple(plan->iSortCnt, ppSorts);
+	}
+	if (plan->pSort) plan->Cond->SetSort(plan->pSort);
+	return plan;
+}
+
+bool C4FindObjectPlanCache::Rebind(Plan &plan, const C4Value *pPars)
+{
+	// Split up the parameters like Compile does
+	const C4Value *pConds[C4AUL_MAX_Par], *pSorts[C4AUL_MAX_Par];
+	int32_t iCondCnt = 0, iSortCnt = 0;
+	for (int32_t i = 0; i < C4AUL_MAX_Par; i++)
+	{
+		const C4Value &Data = pPars[i].GetRefVal();
+		if (!Data) break;
+		const C4ValueArray *pArray = C4Value(Data).getArray();
+		if (pArray && Inside<C4ValueInt>((*pArray)[0].getInt(), C4SO_First, C4SO_Last))
+			pSorts[iSortCnt++] = &Data;
+		else
+			pConds[iCondCnt++] = &Data;
+	}
+	// Parameters that didn't create anything can't be told apart otherwise
+	if (iCondCnt != plan.iCondCnt || iSortCnt != plan.iSortCnt) return false;
+	// Rebind conditions
+	if (plan.pAnd)
+	{
+		if (!plan.pAnd->RebindChildren(iCondCnt, [&pConds](const int32_t i) -> const C4Value & { return *pConds[i]; }))
+			return false;
+	}
+	else if (!plan.Cond->RebindByValue(*pConds[0]))
+		return false;
+	// Rebind sort criterion
+	if (plan.pSortMultiple)
+		return plan.pSortMultiple->RebindChildren(iSortCnt, [&pSorts](const int32_t i) -> const C4Value & { return *pSorts[i]; });
+	return !plan.pSort || plan.pSort->RebindByValue(*pSorts[0]);
+}
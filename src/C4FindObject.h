@@ -22,6 +22,12 @@
 #include "C4Value.h"
 #include "C4Aul.h"
 
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 // Condition map
 enum C4FindObjectCondID
 {
@@ -87,6 +93,8 @@ public:
 
 	void SetSort(C4SortObject *pToSort);
 
+	bool RebindByValue(const C4Value &Data); // take over the parameters of criteria of the same structure as the ones this condition was created from
+
 protected:
 	// Overridables
 	virtual bool Check(C4Object *pObj) = 0;
@@ -94,12 +102,25 @@ protected:
 	virtual bool UseShapes() { return false; }
 	virtual bool IsImpossible() { return false; }
 	virtual bool IsEnsured() { return false; }
+	virtual C4ID GetIDBound() { return C4ID_None; } // all matching objects have this id
+	virtual uint32_t GetCategoryBound() { return 0; } // all matching objects have this category bit
+	virtual bool Rebind(const C4ValueArray &Data) { return false; } // false if Data has a different structure
+	virtual bool GetPredicate(struct C4FindObjectPredicate &Pred) { return false; } // parameters and cost for the check in C4FindObjectAnd; false if it can't be inlined
 
 private:
+	// objects of the id or category index to check instead of Objs or the bounds, if they're fewer
+	// candidates are copied, as scripts called by Check() might change the index
+	std::optional<std::vector<C4Object *>> GetIndexedCandidates(const C4ObjectList &Objs, const C4Rect *pBounds);
+	int32_t CountCandidates(std::vector<C4Object *> candidates);
+	C4Object *FindCandidates(std::vector<C4Object *> candidates);
+	C4ValueArray *FindManyCandidates(std::vector<C4Object *> candidates);
+
 	void CheckObjectStatus(std::vector<C4Object *> &objects);
 	void CheckObjectStatusAfterSort(std::vector<C4Object *> &objects);
 };
 
+class C4FindObjectPlanCache;
+
 // Combinators
 class C4FindObjectNot : public C4FindObject
 {
@@ -115,6 +136,21 @@ protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override { return pCond->IsEnsured(); }
 	virtual bool IsEnsured() override { return pCond->IsImpossible(); }
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
+};
+
+// primitive condition checked inline by C4FindObjectAnd
+struct C4FindObjectPredicate
+{
+	bool fInline; // otherwise, pCond->Check() is called
+	C4FindObjectCondID Type;
+	int32_t iCost; // cheapest predicates are checked first
+	C4FindObject *pCond;
+	C4ID id;
+	int32_t iValue;
+	C4Object *pObj;
+	C4Rect rect;
 };
 
 class C4FindObjectAnd : public C4FindObject
@@ -127,13 +163,25 @@ private:
 	int32_t iCnt;
 	C4FindObject **ppConds; bool fFreeArray; bool fUseShapes;
 	C4Rect Bounds; bool fHasBounds;
+	C4ID idBound{C4ID_None}; uint32_t dwCategoryBound{0};
+	std::vector<C4FindObjectPredicate> Predicates; // children, cheapest first
+
+	void UpdateBounds();
+	void UpdatePredicates();
+	template<typename GetData> bool RebindChildren(int32_t iDataCnt, GetData &&getData);
+
+	friend class C4FindObjectPlanCache;
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return fHasBounds ? &Bounds : nullptr; }
 	virtual bool UseShapes() override { return fUseShapes; }
+	virtual C4ID GetIDBound() override { return idBound; }
+	virtual uint32_t GetCategoryBound() override { return dwCategoryBound; }
 	virtual bool IsEnsured() override { return !iCnt; }
 	virtual bool IsImpossible() override;
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 class C4FindObjectOr : public C4FindObject
@@ -147,11 +195,15 @@ private:
 	C4FindObject **ppConds;
 	C4Rect Bounds; bool fHasBounds;
 
+	void UpdateBounds();
+
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return fHasBounds ? &Bounds : nullptr; }
 	virtual bool IsEnsured() override;
 	virtual bool IsImpossible() override { return !iCnt; }
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 // Primitive conditions
@@ -166,6 +218,8 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 class C4FindObjectID : public C4FindObject
@@ -180,6 +234,9 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override;
+	virtual C4ID GetIDBound() override { return id; }
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 class C4FindObjectInRect : public C4FindObject
@@ -195,6 +252,8 @@ protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return &rect; }
 	virtual bool IsImpossible() override;
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 class C4FindObjectAtPoint : public C4FindObject
@@ -210,6 +269,7 @@ protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return &bounds; }
 	virtual bool UseShapes() override { return true; }
+	virtual bool Rebind(const C4ValueArray &Data) override;
 };
 
 class C4FindObjectAtRect : public C4FindObject
@@ -225,6 +285,7 @@ protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return &bounds; }
 	virtual bool UseShapes() override { return true; }
+	virtual bool Rebind(const C4ValueArray &Data) override;
 };
 
 class C4FindObjectOnLine : public C4FindObject
@@ -244,6 +305,7 @@ protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return &bounds; }
 	virtual bool UseShapes() override { return true; }
+	virtual bool Rebind(const C4ValueArray &Data) override;
 };
 
 class C4FindObjectDistance : public C4FindObject
@@ -259,6 +321,8 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return &bounds; }
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 class C4FindObjectOCF : public C4FindObject
@@ -273,6 +337,8 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override;
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 class C4FindObjectCategory : public C4FindObject
@@ -287,6 +353,9 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsEnsured() override;
+	virtual uint32_t GetCategoryBound() override;
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 class C4FindObjectAction : public C4FindObject
@@ -300,6 +369,7 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual bool Rebind(const C4ValueArray &Data) override;
 };
 
 class C4FindObjectActionTarget : public C4FindObject
@@ -314,6 +384,7 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual bool Rebind(const C4ValueArray &Data) override;
 };
 
 class C4FindObjectContainer : public C4FindObject
@@ -327,6 +398,8 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 class C4FindObjectAnyContainer : public C4FindObject
@@ -336,6 +409,8 @@ public:
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 class C4FindObjectOwner : public C4FindObject
@@ -350,6 +425,8 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override;
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 class C4FindObjectFunc : public C4FindObject
@@ -360,11 +437,14 @@ public:
 
 private:
 	C4AulFunc *pFunc;
+	std::string FuncName;
 	C4AulParSet Pars;
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override;
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 class C4FindObjectLayer : public C4FindObject
@@ -378,6 +458,8 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override;
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 class C4FindObjectController : public C4FindObject
@@ -392,6 +474,8 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override;
+	virtual bool Rebind(const C4ValueArray &Data) override;
+	virtual bool GetPredicate(C4FindObjectPredicate &Pred) override;
 };
 
 // result sorting
@@ -408,10 +492,14 @@ public:
 	virtual bool PrepareCache([[maybe_unused]] std::vector<C4Object *> &objects) { return false; }
 	virtual int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) { return Compare(pObj1, pObj2); }
 
+	virtual bool Rebind(const C4ValueArray &Data) = 0; // false if Data has a different structure
+
 public:
 	static C4SortObject *CreateByValue(const C4Value &Data);
 	static C4SortObject *CreateByValue(C4ValueInt iType, const C4ValueArray &Data);
 
+	bool RebindByValue(const C4Value &Data); // see C4FindObject::RebindByValue
+
 	void SortObjects(std::vector<C4Object *> &result);
 };
 
@@ -448,6 +536,7 @@ protected:
 
 	virtual bool PrepareCache(std::vector<C4Object *> &objects) override;
 	virtual int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) override;
+	bool Rebind(const C4ValueArray &Data) override;
 };
 
 class C4SortObjectMultiple : public C4SortObject // apply next sort if previous compares to equality
@@ -467,6 +556,12 @@ protected:
 
 	virtual bool PrepareCache(std::vector<C4Object *> &objects) override;
 	virtual int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) override;
+	bool Rebind(const C4ValueArray &Data) override;
+
+private:
+	template<typename GetData> bool RebindChildren(int32_t iDataCnt, GetData &&getData);
+
+	friend class C4FindObjectPlanCache;
 };
 
 class C4SortObjectDistance : public C4SortObjectByValue // sort by distance from point x/y
@@ -480,6 +575,7 @@ private:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
+	bool Rebind(const C4ValueArray &Data) override;
 };
 
 class C4SortObjectRandom : public C4SortObjectByValue // randomize order
@@ -489,6 +585,7 @@ public:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
+	bool Rebind(const C4ValueArray &Data) override;
 };
 
 class C4SortObjectSpeed : public C4SortObjectByValue // sort by object xdir/ydir
@@ -498,6 +595,7 @@ public:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
+	bool Rebind(const C4ValueArray &Data) override;
 };
 
 class C4SortObjectMass : public C4SortObjectByValue // sort by mass
@@ -507,6 +605,7 @@ public:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
+	bool Rebind(const C4ValueArray &Data) override;
 };
 
 class C4SortObjectValue : public C4SortObjectByValue // sort by value
@@ -516,6 +615,7 @@ public:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
+	bool Rebind(const C4ValueArray &Data) override;
 };
 
 class C4SortObjectFunc : public C4SortObjectByValue // sort by script function
@@ -526,8 +626,63 @@ public:
 
 private:
 	C4AulFunc *pFunc;
+	std::string FuncName;
 	C4AulParSet Pars;
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
+	bool Rebind(const C4ValueArray &Data) override;
+};
+
+// search criteria of FindObject2, FindObjects and ObjectCount2, compiled once per call site
+// calls with criteria of the same structure reuse the compiled conditions and only rebind their parameters
+class C4FindObjectPlanCache
+{
+private:
+	struct Plan
+	{
+		std::unique_ptr<C4FindObject> Cond;
+		C4FindObjectAnd *pAnd{nullptr}; // Cond if it combines several parameters
+		C4SortObject *pSort{nullptr}; // owned by Cond
+		C4SortObjectMultiple *pSortMultiple{nullptr}; // pSort if it combines several parameters
+		int32_t iCondCnt{0}, iSortCnt{0};
+		bool fWithSort{false};
+		bool fInUse{false}; // scripts called by the search might run the same call again
+	};
+
+public:
+	// search object for a single call
+	class Lease
+	{
+	public:
+		Lease() = default;
+		Lease(Lease &&) = default;
+		Lease &operator=(Lease &&) = default;
+		~Lease() { if (plan) plan->fInUse = false; }
+
+		C4FindObject *operator->() const { return pCond; }
+		explicit operator bool() const { return pCond != nullptr; }
+
+	private:
+		std::shared_ptr<Plan> plan;
+		std::unique_ptr<C4FindObject> owned; // conditions that could not be cached
+		C4FindObject *pCond{nullptr};
+
+		friend class C4FindObjectPlanCache;
+	};
+
+	// criteria are read from pPars like the parameters of FindObject2; pCallSite may be nullptr for calls without script context
+	Lease Acquire(const C4AulBCC *pCallSite, const C4Value *pPars, bool fWithSort);
+	void Clear(); // must be called whenever bytecode or script functions are freed
+
+	void ResetStats() { iHits = iMisses = 0; }
+	uint32_t GetHits() const { return iHits; }
+	uint32_t GetMisses() const { return iMisses; }
+
+private:
+	std::unordered_map<const C4AulBCC *, std::shared_ptr<Plan>> Plans;
+	uint32_t iHits{0}, iMisses{0};
+
+	static std::shared_ptr<Plan> Compile(const C4Value *pPars, bool fWithSort);
+	static bool Rebind(Plan &plan, const C4Value *pPars);
 };
@@ -57,12 +57,13 @@
 #include <format>
 #include <iterator>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
 
 constexpr unsigned int defaultIngameGameTickDelay = 28;
 
 C4Game::C4Game()
-	: Input(Control.Input), KeyboardInput(C4KeyboardInput_Init()), fQuitWithError(false), fPreinited(false),
+	: Input(Control.Input), KeyboardInput(C4KeyboardInput_Init()), fQuitWithError(false), fPreinited(false), ReplaySeekFrame(-1),
 	Teams(Parameters.Teams),
 	PlayerInfos(Parameters.PlayerInfos),
 	RestorePlayerInfos(Parameters.RestorePlayerInfos),
@@ -85,6 +86,7 @@ bool C4Game::InitDefs()
 	for ([[maybe_unused]] const auto &def : Parameters.GameRes.iterRes(NRT_Definitions))
 		++iDefResCount;
 	int i = 0;
+	C4Group_ResetLookupStats();
 	// Load specified defs
 	for (const auto &def : Parameters.GameRes.iterRes(NRT_Definitions))
 	{
@@ -99,6 +101,7 @@ bool C4Game::InitDefs()
 
 	// Load for scenario file - ignore sys group here, because it has been loaded already
 	iDefs += Defs.Load(ScenarioFile, C4D_Load_RX, Config.General.LanguageEx, &*Application.SoundSystem, true, true, 35, 40, false);
+	C4Group_LogLookupStats("definitions");
 
 	// Absolutely no defs: we don't like that
 	if (!iDefs) { LogFatal(C4ResStrTableKey::IDS_PRC_NODEFS); return false; }
@@ -509,6 +512,12 @@ bool C4Game::Init()
 	// game running now!
 	IsRunning = true;
 
+	// script profile of the whole round
+	if (ScriptProfileFile) C4AulProfiler::StartProfiling(&ScriptEngine);
+
+	// replay benchmark
+	if (Benchmark.IsEnabled() && !Benchmark.Start()) return false;
+
 	// Start message
 	if (C4S.Head.NetworkGame)
 	{
@@ -568,6 +577,7 @@ void C4Game::Clear()
 
 	// stop statistics
 	delete pNetworkStatistics; pNetworkStatistics = nullptr;
+	if (ScriptProfileFile && C4AulProfiler::IsProfiling()) C4AulProfiler::StopProfiling(ScriptProfileFile.getData());
 	C4AulProfiler::Abort();
 
 	// exit gui
@@ -588,6 +598,7 @@ void C4Game::Clear()
 	C4S.Clear();
 	Weather.Clear();
 	GraphicsSystem.Clear();
+	FindObjectPlans.Clear();
 	DeleteObjects(true);
 	Defs.Clear();
 	Landscape.Clear();
@@ -605,7 +616,9 @@ void C4Game::Clear()
 	Names.Clear();
 	GameText.Clear();
 	RecordDumpFile.Clear();
+	ScriptProfileFile.Clear();
 	RecordStream.Clear();
+	Benchmark.Clear();
 
 	PathFinder.Clear();
 	TransferZones.Clear();
@@ -758,14 +771,14 @@ C4ST_NEW(MusicSystemStat, "C4Game::Execute MusicSystem.Execute")
 C4ST_NEW(MessagesStat,    "C4Game::Execute Messages.Execute")
 C4ST_NEW(ScriptStat,      "C4Game::Execute Script.Execute")
 
-#define EXEC_S(Expressions, Stat) \
-	{ C4ST_START(Stat) Expressions C4ST_STOP(Stat) }
+#define EXEC_S(Expressions, Stat, BenchmarkPart) \
+	{ C4GameBenchmark::Timer BenchmarkTimer{Benchmark, C4GameBenchmark::BenchmarkPart}; C4ST_START(Stat) Expressions C4ST_STOP(Stat) }
 
 #ifdef DEBUGREC
-#define EXEC_S_DR(Expressions, Stat, DebugRecName) { AddDbgRec(RCT_Block, DebugRecName, 6); EXEC_S(Expressions, Stat) }
+#define EXEC_S_DR(Expressions, Stat, BenchmarkPart, DebugRecName) { AddDbgRec(RCT_Block, DebugRecName, 6); EXEC_S(Expressions, Stat, BenchmarkPart) }
 #define EXEC_DR(Expressions, DebugRecName) { AddDbgRec(RCT_Block, DebugRecName, 6); Expressions }
 #else
-#define EXEC_S_DR(Expressions, Stat, DebugRecName) EXEC_S(Expressions, Stat)
+#define EXEC_S_DR(Expressions, Stat, BenchmarkPart, DebugRecName) EXEC_S(Expressions, Stat, BenchmarkPart)
 #define EXEC_DR(Expressions, DebugRecName) Expressions
 #endif
 
@@ -779,7 +792,7 @@ bool C4Game::Execute() // Returns true if the game is over
 
 	// Prepare control
 	bool fControl;
-	EXEC_S(fControl = Control.Prepare();, ControlStat)
+	EXEC_S(fControl = Control.Prepare();, ControlStat, Control)
 	if (!fControl) return false; // not ready yet: wait
 
 	// Halt
@@ -790,7 +803,10 @@ bool C4Game::Execute() // Returns true if the game is over
 #endif
 
 	// Execute the control
-	Control.Execute();
+	{
+		C4GameBenchmark::Timer BenchmarkTimer{Benchmark, C4GameBenchmark::Control};
+		Control.Execute();
+	}
 	if (!IsRunning) return false;
 
 	// Ticks
@@ -803,19 +819,19 @@ bool C4Game::Execute() // Returns true if the game is over
 
 	// Game
 
-	EXEC_S(ExecObjects();, ExecObjectsStat)
+	EXEC_S(ExecObjects();, ExecObjectsStat, Objects)
 	if (pGlobalEffects)
-		EXEC_S_DR(pGlobalEffects->Execute(nullptr);, GEStats, "GEEx\0");
-	EXEC_S_DR(PXS.Execute();,                      PXSStat,         "PXSEx")
-	EXEC_S_DR(Particles.GlobalParticles.Exec();,   PartStat,        "ParEx")
-	EXEC_S_DR(MassMover.Execute();,                MassMoverStat,   "MMvEx")
-	EXEC_S_DR(Weather.Execute();,                  WeatherStat,     "WtrEx")
-	EXEC_S_DR(Landscape.Execute();,                LandscapeStat,   "LdsEx")
-	EXEC_S_DR(Players.Execute();,                  PlayersStat,     "PlrEx")
+		EXEC_S_DR(pGlobalEffects->Execute(nullptr);, GEStats, Effects, "GEEx\0");
+	EXEC_S_DR(PXS.Execute();,                      PXSStat,         PXS,       "PXSEx")
+	EXEC_S_DR(Particles.Execute();,                PartStat,        Particles, "ParEx")
+	EXEC_S_DR(MassMover.Execute();,                MassMoverStat,   MassMover, "MMvEx")
+	EXEC_S_DR(Weather.Execute();,                  WeatherStat,     Weather,   "WtrEx")
+	EXEC_S_DR(Landscape.Execute();,                LandscapeStat,   Landscape, "LdsEx")
+	EXEC_S_DR(Players.Execute();,                  PlayersStat,     Players,   "PlrEx")
 	// FIXME: C4Application::Execute should do this, but what about the stats?
-	EXEC_S_DR(Application.MusicSystem->Execute();, MusicSystemStat, "Music")
-	EXEC_S_DR(Messages.Execute();,                 MessagesStat,    "MsgEx")
-	EXEC_S_DR(Script.Execute();,                   ScriptStat,      "Scrpt")
+	EXEC_S_DR(Application.MusicSystem->Execute();, MusicSystemStat, Music,     "Music")
+	EXEC_S_DR(Messages.Execute();,                 MessagesStat,    Messages,  "MsgEx")
+	EXEC_S_DR(Script.Execute();,                   ScriptStat,      Script,    "Scrpt")
 
 	EXEC_DR(MouseControl.Execute();, "Input")
 
@@ -981,12 +997,27 @@ void C4Game::ClearObjectPtrs(C4Object *pObj)
 	// May not call Objects.ClearPointers() because that would
 	// remove pObj from primary list and pObj is to be kept
 	// until CheckObjectRemoval().
-	C4Object *cObj; C4ObjectLink *clnk;
-	for (clnk = Objects.First; clnk && (cObj = clnk->Obj); clnk = clnk->Next)
-		cObj->ClearPointers(pObj);
-	// check in inactive objects as well
-	for (clnk = Objects.InactiveObjects.First; clnk && (cObj = clnk->Obj); clnk = clnk->Next)
+#ifndef NDEBUG
+	// all objects pointing to pObj must be registered as its referrers
+	for (C4ObjectList *pList : {static_cast<C4ObjectList *>(&Objects), &Objects.InactiveObjects})
+		for (C4ObjectLink *clnk = pList->First; clnk; clnk = clnk->Next)
+			if (C4Object *cObj = clnk->Obj; cObj != pObj && cObj->HasPointers(pObj))
+				assert(std::ranges::find(pObj->Referrers, cObj) != pObj->Referrers.end());
+#endif
+	// the object itself isn't registered
+	pObj->ClearPointers(pObj);
+	// only objects that might point to pObj need to be checked
+	const std::vector<C4Object *> referrers{std::move(pObj->Referrers)};
+	pObj->Referrers.clear();
+	for (C4Object *cObj : referrers)
+	{
+		std::erase(cObj->ReferencedObjects, pObj);
 		cObj->ClearPointers(pObj);
+	}
+	// menu items aren't registered
+	for (C4Object *cObj : Objects.MenuObjects)
+		if (cObj->Menu && cObj != pObj)
+			cObj->ClearPointers(pObj);
 	Application.SoundSystem->ClearPointers(pObj);
 }
 
@@ -3158,9 +3189,18 @@ void C4Game::ParseCommandLine(const char *szCmdLine)
 		// record dump
 		if (SEqual2NoCase(szParameter, "/recdump:"))
 			RecordDumpFile.Copy(szParameter + 9);
+		// script profile
+		if (SEqual2NoCase(szParameter, "/scriptprofile:"))
+			ScriptProfileFile.Copy(szParameter + 15);
 		// record stream
 		if (SEqual2NoCase(szParameter, "/stream:"))
 			RecordStream.Copy(szParameter + 8);
+		// replay benchmark
+		if (SEqual2NoCase(szParameter, "/benchmark:"))
+		{
+			Benchmark.Enable(szParameter + 11);
+			SCopy(szParameter + 11, ScenarioFilename, _MAX_PATH);
+		}
 		// startup start screen
 		if (SEqual2NoCase(szParameter, "/startup:"))
 			C4Startup::SetStartScreen(szParameter + 9);
@@ -3896,9 +3936,11 @@ bool C4Game::CheckObjectEnumeration()
 {
 	// Check valid & maximum number & duplicate numbers
 	int32_t iMax = 0;
+	std::unordered_map<int32_t, C4Object *> numbers;
+	numbers.reserve(Objects.ObjectCount() + Objects.InactiveObjects.ObjectCount());
 	C4Object *cObj; C4ObjectLink *clnk;
-	C4Object *cObj2; C4ObjectLink *clnk2;
 	clnk = Objects.First; if (!clnk) clnk = Objects.InactiveObjects.First;
+	bool inactive = !Objects.First;
 	while (clnk)
 	{
 		// Invalid number
@@ -3911,23 +3953,17 @@ bool C4Game::CheckObjectEnumeration()
 		// Max
 		if (cObj->Number > iMax) iMax = cObj->Number;
 		// Duplicate
-		for (clnk2 = Objects.First; clnk2 && (cObj2 = clnk2->Obj); clnk2 = clnk2->Next)
-			if (cObj2 != cObj)
-				if (cObj->Number == cObj2->Number)
-				{
-					LogNTr(spdlog::level::err, "Duplicate object enumeration number {} ({} and {})", cObj2->Number, cObj->GetName(), cObj2->GetName());
-					return false;
-				}
-		for (clnk2 = Objects.InactiveObjects.First; clnk2 && (cObj2 = clnk2->Obj); clnk2 = clnk2->Next)
-			if (cObj2 != cObj)
-				if (cObj->Number == cObj2->Number)
-				{
-					LogNTr(spdlog::level::err, "Duplicate object enumeration number {} ({} and {}(i))", cObj2->Number, cObj->GetName(), cObj2->GetName());
-					return false;
-				}
+		if (const auto [it, inserted] = numbers.try_emplace(cObj->Number, cObj); !inserted && it->second != cObj)
+		{
+			LogNTr(spdlog::level::err, "Duplicate object enumeration number {} ({} and {}{})", cObj->Number, it->second->GetName(), cObj->GetName(), inactive ? "(i)" : "");
+			return false;
+		}
 		// next
 		if (!clnk->Next)
-			if (clnk == Objects.Last) clnk = Objects.InactiveObjects.First; else clnk = nullptr;
+		{
+			if (clnk == Objects.Last) { clnk = Objects.InactiveObjects.First; inactive = true; }
+			else clnk = nullptr;
+		}
 		else
 			clnk = clnk->Next;
 	}
@@ -4392,3 +4428,36 @@ bool C4Game::ToggleChat()
 {
 	return C4ChatDlg::ToggleChat();
 }
+
+// *** C4Value lookups
+
+C4ObjectHandle C4Value::GetObjectHandle(C4Object *const pObj)
+{
+#ifndef NDEBUG
+	// check if the object actually exists
+	if (!Game.Objects.ObjectNumber(pObj))
+	{
+		LogNTr(spdlog::level::warn, "using wild object ptr {}!", static_cast<void *>(pObj));
+	}
+	else if (!pObj->Status)
+	{
+		LogNTr(spdlog::level::warn, "using ptr on deleted object {} ({})!", static_cast<void *>(pObj), pObj->GetName());
+	}
+#endif
+	return pObj->GetHandle();
+}
+
+std::int32_t C4Value::GetObjectNumber(C4Object *const pObj)
+{
+	return Game.Objects.ObjectNumber(pObj);
+}
+
+C4Object *C4Value::GetObjectByNumber(const std::int32_t iNumber)
+{
+	return Game.Objects.ObjectPointer(iNumber);
+}
+
+C4StringTable &C4Value::GetStringTable()
+{
+	return Game.ScriptEngine.Strings;
+}
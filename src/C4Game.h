@@ -55,6 +55,7 @@
 #include <C4RoundResults.h>
 #include <C4NetworkRestartInfos.h>
 #include "C4FileMonitor.h"
+#include "C4GameBenchmark.h"
 
 class C4Game
 {
@@ -101,6 +102,7 @@ public:
 	C4Weather Weather;
 	C4MaterialMap Material;
 	C4GameObjects Objects;
+	C4FindObjectPlanCache FindObjectPlans;
 	C4ObjectList BackObjects; // objects in background (C4D_Background)
 	C4ObjectList ForeObjects; // objects in foreground (C4D_Foreground)
 	C4Landscape Landscape;
@@ -154,7 +156,9 @@ public:
 	bool fObserve;
 	bool NetworkActive;
 	StdStrBuf RecordDumpFile;
+	StdStrBuf ScriptProfileFile; // profile all scripts of the round and save the collapsed stacks
 	StdStrBuf RecordStream;
+	C4GameBenchmark Benchmark;
 	bool TempScenarioFile;
 	bool fPreinited; // set after PreInit has been called; unset by Clear and Default
 	int32_t FrameCounter;
@@ -181,6 +185,9 @@ public:
 	// next mission to be played after this one
 	StdStrBuf NextMission, NextMissionText, NextMissionDesc;
 	C4NetworkRestartInfos::Infos RestartRestoreInfos;
+	// replays that are restarted for seeking; kept across the restart like RestartRestoreInfos
+	StdStrBuf ReplaySeekOrigin; // record that has been started originally
+	int32_t ReplaySeekFrame; // frame to fast forward to after the restart; -1 if not restarted for seeking
 
 public:
 	// Init and execution
@@ -0,0 +1,104 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4GameBenchmark.h>
+
+#include <C4Application.h>
+#include <C4Game.h>
+#include <C4Log.h>
+
+#include <cstdio>
+#include <format>
+
+namespace
+{
+	constexpr const char *PartNames[C4GameBenchmark::PartCount]
+	{
+		"Control",
+		"Objects",
+		"Effects",
+		"PXS",
+		"Particles",
+		"MassMover",
+		"Weather",
+		"Landscape",
+		"Players",
+		"Music",
+		"Messages",
+		"Script"
+	};
+}
+
+bool C4GameBenchmark::Start()
+{
+	// the benchmark measures the simulation, so it needs the controls of a record
+	if (!Game.Control.isReplay())
+	{
+		LogFatalNTr(std::format("Benchmark: {} is not a record", Record));
+		return false;
+	}
+	LogNTr("Benchmark: Playing {} from frame {}", Record, Game.FrameCounter);
+	fRunning = true;
+	StartFrame = Game.FrameCounter;
+	Times.fill(Clock::duration::zero());
+	// no frame pacing; drawing is skipped by the application while the benchmark is running
+	Game.FullSpeed = true;
+	StartTime = Clock::now();
+	Application.NextTick(false);
+	return true;
+}
+
+void C4GameBenchmark::Finish()
+{
+	if (!fRunning) return;
+	TotalTime = Clock::now() - StartTime;
+	Frames = Game.FrameCounter - StartFrame;
+	fRunning = false;
+
+	// machine readable report on stdout, independent of the log settings
+	C4ControlSyncCheck SyncCheck;
+	SyncCheck.Set();
+	std::string report{DecompileToBuf<StdCompilerINIWrite>(mkNamingAdapt(*this, "Benchmark"))};
+	report += DecompileToBuf<StdCompilerINIWrite>(mkNamingAdapt(SyncCheck, "SyncCheck"));
+	std::fwrite(report.data(), 1, report.size(), stdout);
+	std::fflush(stdout);
+
+	Application.Quit();
+}
+
+void C4GameBenchmark::Clear()
+{
+	Record.clear();
+	fRunning = false;
+}
+
+void C4GameBenchmark::CompileFunc(StdCompiler *pComp)
+{
+	const auto micro = [](const Clock::duration duration) -> int64_t { return std::chrono::duration_cast<std::chrono::microseconds>(duration).count(); };
+
+	pComp->Value(mkNamingAdapt(Record, "Record"));
+	pComp->Value(mkNamingAdapt(StartFrame, "StartFrame"));
+	pComp->Value(mkNamingAdapt(Frames, "Frames"));
+	int64_t iTotal{micro(TotalTime)};
+	pComp->Value(mkNamingAdapt(iTotal, "Total"));
+
+	const auto name = pComp->Name("Parts");
+	for (std::size_t i{0}; i < PartCount; ++i)
+	{
+		int64_t iTime{micro(Times[i])};
+		pComp->Value(mkNamingAdapt(iTime, PartNames[i]));
+	}
+}
@@ -0,0 +1,88 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// Replay benchmark (/benchmark:<record>): plays a record as fast as possible
+// without drawing and reports the time spent in the single game subsystems
+// in microseconds, followed by the sync check values of the last frame.
+
+#pragma once
+
+#include "StdCompiler.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class C4GameBenchmark
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	enum Part
+	{
+		Control,
+		Objects,
+		Effects,
+		PXS,
+		Particles,
+		MassMover,
+		Weather,
+		Landscape,
+		Players,
+		Music,
+		Messages,
+		Script,
+		PartCount
+	};
+
+	// measures the time until the end of the scope if the benchmark is running
+	class Timer
+	{
+	public:
+		Timer(C4GameBenchmark &benchmark, const Part part)
+			: benchmark{benchmark.IsRunning() ? &benchmark : nullptr}, part{part}, start{this->benchmark ? Clock::now() : Clock::time_point{}} {}
+		~Timer() { if (benchmark) benchmark->Times[part] += Clock::now() - start; }
+
+		Timer(const Timer &) = delete;
+		Timer &operator=(const Timer &) = delete;
+
+	private:
+		C4GameBenchmark *benchmark;
+		Part part;
+		Clock::time_point start;
+	};
+
+private:
+	std::string Record; // set by command line
+	bool fRunning{false};
+	int32_t StartFrame{0};
+	int32_t Frames{0};
+	Clock::time_point StartTime;
+	Clock::duration TotalTime{};
+	std::array<Clock::duration, PartCount> Times{};
+
+public:
+	void Enable(const char *szRecord) { Record = szRecord; }
+	bool IsEnabled() const { return !Record.empty(); }
+	bool IsRunning() const { return fRunning; }
+
+	bool Start(); // called when the game is running
+	void Finish(); // called at the end of the record; prints the report and quits
+	void Clear();
+
+	void CompileFunc(StdCompiler *pComp);
+};
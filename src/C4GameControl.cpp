@@ -134,6 +134,11 @@ void C4GameControl::OnGameSynchronizing()
 		fRecordNeeded = false;
 		StartRecord(false, false);
 	}
+	// record keyframe; the game state is saved before the synchronization, like runtime records are
+	fKeyframeRequested = false;
+	if (pRecord && pRecord->IsKeyframeDue(Game.FrameCounter))
+		if (!pRecord->RecKeyframe(Game.FrameCounter))
+			logger->error("Could not record keyframe in frame {}", Game.FrameCounter);
 }
 
 bool C4GameControl::StartRecord(bool fInitial, bool fStreaming)
@@ -205,6 +210,20 @@ bool C4GameControl::RecAddFile(const char *szLocalFilename, const char *szAddAs)
 	return pRecord->AddFile(szLocalFilename, szAddAs);
 }
 
+bool C4GameControl::SeekReplay(const int32_t iFrame)
+{
+	if (!isReplay() || !pPlayback) return false;
+	return pPlayback->Seek(iFrame);
+}
+
+void C4GameControl::RequestRecordKeyframe()
+{
+	// keyframes are only taken while the game is synchronized, so the host requests a synchronization when one is due
+	if (fKeyframeRequested || !fHost || !pRecord || !pRecord->IsKeyframeDue(Game.FrameCounter)) return;
+	fKeyframeRequested = true;
+	DoInput(CID_Synchronize, new C4ControlSynchronize(false, true), CDT_Queue);
+}
+
 void C4GameControl::Clear()
 {
 	StopRecord();
@@ -227,6 +246,7 @@ void C4GameControl::Default()
 	SyncRate = C4SyncCheckRate;
 	DoSync = false;
 	fRecordNeeded = false;
+	fKeyframeRequested = false;
 	pExecutingControl = nullptr;
 }
 
@@ -305,7 +325,10 @@ void C4GameControl::Execute()
 
 	// Record: Save ctrl
 	if (pRecord)
+	{
 		pRecord->Rec(Control, Game.FrameCounter);
+		RequestRecordKeyframe();
+	}
 
 	// debug: recheck PreExecute
 	assert(Control.PreExecute(logger));
@@ -57,6 +57,7 @@ protected:
 	bool fHost; // (set for local, too)
 	bool fActivated;
 	bool fRecordNeeded;
+	bool fKeyframeRequested;
 	int32_t iClientID;
 
 	C4Record *pRecord;
@@ -107,6 +108,7 @@ public:
 	void RequestRuntimeRecord();
 	bool IsRuntimeRecordPossible() const;
 	bool RecAddFile(const char *szLocalFilename, const char *szAddAs);
+	bool SeekReplay(int32_t iFrame);
 
 	// execution
 	bool Prepare();
@@ -147,4 +149,6 @@ protected:
 	// sync checks
 	C4ControlSyncCheck *GetSyncCheck(int32_t iTick);
 	void RemoveOldSyncChecks();
+	// records
+	void RequestRecordKeyframe();
 };
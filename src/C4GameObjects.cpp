@@ -28,9 +28,16 @@
 #include <C4Game.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
+#include <bit>
+#include <ranges>
+
 C4GameObjects::C4GameObjects()
 {
 	Default();
+	// object numbers are resolved all the time (scripts, denumeration), so keep an index for both lists
+	EnableNumberIndex();
+	InactiveObjects.EnableNumberIndex();
 }
 
 C4GameObjects::~C4GameObjects()
@@ -128,8 +135,8 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 							if (Game.Players.Hostile(obj1->Owner, obj2->Owner))
 							{
 								// RejectFight callback
-								if (obj1->Call(PSF_RejectFight, {C4VObj(obj2)}).getBool()) continue;
-								if (obj2->Call(PSF_RejectFight, {C4VObj(obj1)}).getBool()) continue;
+								if (obj1->Call(PSFSlot_RejectFight, {C4VObj(obj2)}).getBool()) continue;
+								if (obj2->Call(PSFSlot_RejectFight, {C4VObj(obj1)}).getBool()) continue;
 								ObjectActionFight(obj1, obj2);
 								ObjectActionFight(obj2, obj1);
 								continue;
@@ -165,7 +172,7 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 										obj2->Marker = Marker;
 										// Hit
 										if ((obj2->OCF & OCF_HitSpeed2) && (obj1->OCF & OCF_Alive) && (obj2->Category & C4D_Object))
-											if (!obj1->Call(PSF_QueryCatchBlow, {C4VObj(obj2)}))
+											if (!obj1->Call(PSFSlot_QueryCatchBlow, {C4VObj(obj2)}))
 											{
 												// "realistic" hit energy
 												C4Fixed dXDir = obj2->xdir - obj1->xdir, dYDir = obj2->ydir - obj1->ydir;
@@ -175,7 +182,7 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 												int tmass = std::max<int32_t>(obj1->Mass, 50);
 												if (!Tick3 || (obj1->Action.Act >= 0 && obj1->Def->ActMap[obj1->Action.Act].Procedure != DFA_FLIGHT))
 													obj1->Fling(obj2->xdir * 50 / tmass, -Abs(obj2->ydir / 2) * 50 / tmass, false, obj2->Controller);
-												obj1->Call(PSF_CatchBlow, {C4VInt(-iHitEnergy / 5),
+												obj1->Call(PSFSlot_CatchBlow, {C4VInt(-iHitEnergy / 5),
 													C4VObj(obj2)});
 												// obj1 might have been tampered with
 												if (!obj1->Status || obj1->Contained || !(obj1->OCF & focf))
@@ -293,6 +300,64 @@ C4ObjectList &C4GameObjects::ObjectsInt()
 	return *this;
 }
 
+C4Object *C4GameObjects::Find(C4ID id, int iOwner, uint32_t dwOCF)
+{
+	for (C4Object *const pObj : std::views::values(ObjectsByID(id)))
+		if (pObj->Status)
+			if ((iOwner == ANY_OWNER) || (pObj->Owner == iOwner))
+				if (dwOCF & pObj->OCF)
+					return pObj;
+	return nullptr;
+}
+
+int C4GameObjects::ObjectCount(C4ID id, int32_t dwCategory) const
+{
+	const TypeIndexObjects *pCandidates;
+	if (id != C4ID_None)
+		pCandidates = &ObjectsByID(id);
+	else if ((dwCategory != C4D_All) && std::has_single_bit(static_cast<uint32_t>(dwCategory)))
+		pCandidates = &ObjectsByCategory(dwCategory);
+	else
+		return C4ObjectList::ObjectCount(id, dwCategory);
+
+	return static_cast<int>(std::ranges::count_if(std::views::values(*pCandidates), [dwCategory](const C4Object *const pObj)
+	{
+		return pObj->Status && ((dwCategory == C4D_All) || (pObj->Category & dwCategory));
+	}));
+}
+
+void C4GameObjects::UpdateTypeIndex()
+{
+	TypeIndex.Rebuild(First);
+}
+
+void C4GameObjects::UpdateTypeIndex(C4Object *pObj)
+{
+	// not in the main list?
+	if (!TypeIndex.Contains(pObj)) return;
+	TypeIndex.Remove(pObj);
+	if (C4ObjectLink *const pLnk = GetLink(pObj))
+		TypeIndex.Insert(pLnk);
+}
+
+void C4GameObjects::InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore)
+{
+	C4NotifyingObjectList::InsertLinkBefore(pLink, pBefore);
+	TypeIndex.Insert(pLink);
+}
+
+void C4GameObjects::InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter)
+{
+	C4NotifyingObjectList::InsertLink(pLink, pAfter);
+	TypeIndex.Insert(pLink);
+}
+
+void C4GameObjects::RemoveLink(C4ObjectLink *pLnk)
+{
+	TypeIndex.Remove(pLnk->Obj);
+	C4NotifyingObjectList::RemoveLink(pLnk);
+}
+
 void C4GameObjects::RemoveSolidMasks()
 {
 	C4ObjectLink *cLnk;
@@ -517,6 +582,8 @@ void C4ObjResort::Sort(C4ObjectLink *pFirst, C4ObjectLink *pLast)
 #ifndef NDEBUG
 	assert(Game.Objects.Sectors.CheckSort());
 #endif
+	// objects have been swapped between links
+	Game.Objects.UpdateTypeIndex();
 	// resort objects in sector lists
 	for (pCurr = pFirstBck; pCurr != pLast->Next; pCurr = pCurr->Next)
 	{
@@ -556,11 +623,8 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 	{
 		C4Object *pObj = cLnk->Obj;
 		// check object number collision with inactive list
-		if (fKeepInactive)
-		{
-			for (C4ObjectLink *clnk = InactiveObjects.First; clnk; clnk = clnk->Next)
-				if (clnk->Obj->Number == pObj->Number) fObjectNumberCollision = true;
-		}
+		if (fKeepInactive && InactiveObjects.ObjectPointer(pObj->Number))
+			fObjectNumberCollision = true;
 		// keep track of numbers
 		iMaxObjectNumber = std::max<long>(iMaxObjectNumber, pObj->Number);
 		// add to list of backobjects
@@ -576,7 +640,7 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 	// if object numbers collideded, numbers will be adjusted afterwards
 	// so fake inactive object list empty meanwhile
 	C4ObjectLink *pInFirst;
-	if (fObjectNumberCollision) { pInFirst = InactiveObjects.First; InactiveObjects.First = nullptr; }
+	if (fObjectNumberCollision) { pInFirst = InactiveObjects.First; InactiveObjects.First = nullptr; InactiveObjects.UpdateNumberIndex(); }
 	// denumerate pointers
 	Denumerate();
 	// update object enumeration index now, because calls like UpdateTransferZone might create objects
@@ -589,6 +653,7 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 		for (cLnk = InactiveObjects.First; cLnk; cLnk = cLnk->Next)
 			if ((pObj = cLnk->Obj)->Status)
 				pObj->Number = ++Game.ObjectEnumerationIndex;
+		InactiveObjects.UpdateNumberIndex();
 	}
 
 	// special checks:
@@ -648,6 +713,10 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 			Mass -= pObj->Mass;
 		}
 	}
+	// links have been moved directly
+	UpdateNumberIndex();
+	InactiveObjects.UpdateNumberIndex();
+	UpdateTypeIndex();
 
 	{
 		C4DebugRecOff DBGRECOFF; // - script callbacks that would kill DebugRec-sync for runtime start
@@ -729,6 +798,17 @@ void C4GameObjects::UpdateScriptPointers()
 	if (Game.pGlobalEffects) Game.pGlobalEffects->ReAssignAllCallbackFunctions();
 }
 
+void C4GameObjects::AddMenuObject(C4Object *pObj)
+{
+	if (std::ranges::find(MenuObjects, pObj) == MenuObjects.end())
+		MenuObjects.push_back(pObj);
+}
+
+void C4GameObjects::RemoveMenuObject(C4Object *pObj)
+{
+	std::erase(MenuObjects, pObj);
+}
+
 void C4GameObjects::UpdatePos(C4Object *pObj)
 {
 	// Position might have changed. Update sector lists
@@ -750,7 +830,8 @@ bool C4GameObjects::OrderObjectBefore(C4Object *pObj1, C4Object *pObj2)
 	// reorder
 	if (!C4ObjectList::OrderObjectBefore(pObj1, pObj2))
 		return false;
-	// update area lists
+	// update type index and area lists
+	UpdateTypeIndex(pObj1);
 	UpdatePosResort(pObj1);
 	// done, success
 	return true;
@@ -764,7 +845,8 @@ bool C4GameObjects::OrderObjectAfter(C4Object *pObj1, C4Object *pObj2)
 	// reorder
 	if (!C4ObjectList::OrderObjectAfter(pObj1, pObj2))
 		return false;
-	// update area lists
+	// update type index and area lists
+	UpdateTypeIndex(pObj1);
 	UpdatePosResort(pObj1);
 	// done, success
 	return true;
@@ -847,7 +929,8 @@ void C4GameObjects::FixObjectOrder()
 		if (!pLnk1stUnsorted) break; // done
 		pLnk0 = pLnk1stUnsorted;
 	}
-	// objects fixed!
+	// objects fixed! they might have been swapped between links
+	UpdateTypeIndex();
 }
 
 void C4GameObjects::ResortUnsorted()
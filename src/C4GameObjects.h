@@ -20,6 +20,7 @@
 #pragma once
 
 #include <C4ObjectList.h>
+#include <C4ObjectTypeIndex.h>
 #include <C4FindObject.h>
 #include <C4Sector.h>
 
@@ -38,7 +39,12 @@ public:
 private:
 	uint32_t LastUsedMarker; // last used value for C4Object::Marker
 
+	// lookup index by id and by category bit for FindObject2/ObjectCount, each in list order
+	C4ObjectTypeIndex<C4Object, C4ObjectLink, C4ID> TypeIndex;
+
 public:
+	using TypeIndexObjects = C4ObjectTypeIndexObjects<C4Object>;
+
 	C4LSectors Sectors; // section object lists
 	C4ObjectList InactiveObjects; // inactive objects (Status=2)
 	C4ObjResort *ResortProc; // current sheduled user resorts
@@ -54,6 +60,8 @@ public:
 	uint32_t GetNextMarker();
 
 	C4Object *FindInternal(C4ID id); // find object in first sector
+	C4Object *Find(C4ID id, int iOwner = ANY_OWNER, uint32_t dwOCF = OCF_All); // C4ObjectList::Find using the id index
+	int ObjectCount(C4ID id = C4ID_None, int32_t dwCategory = C4D_All) const; // C4ObjectList::ObjectCount using the indices
 	virtual C4Object *ObjectPointer(int32_t iNumber) override; // object pointer by number
 	std::int32_t ObjectNumber(C4Object *pObj); // object number by pointer
 
@@ -68,9 +76,20 @@ public:
 
 	void UpdateScriptPointers(); // update pointers to C4AulScript *
 
+	const TypeIndexObjects &ObjectsByID(C4ID id) const { return TypeIndex.ByID(id); } // all objects of this id, in list order
+	const TypeIndexObjects &ObjectsByCategory(uint32_t dwCategoryBit) const { return TypeIndex.ByCategory(dwCategoryBit); } // all objects having this category bit, in list order
+	int32_t IndexedObjectCount() const { return static_cast<int32_t>(TypeIndex.Size()); }
+	void UpdateTypeIndex(); // rebuild the type index; must be called after links were modified directly
+	void UpdateTypeIndex(C4Object *pObj); // reindex a single object after its id, category or list position changed
+
 	void UpdatePos(C4Object *pObj);
 	void UpdatePosResort(C4Object *pObj);
 
+	// objects that opened a menu; its items may point to any object, so they are not covered by C4Object::Referrers
+	std::vector<C4Object *> MenuObjects;
+	void AddMenuObject(C4Object *pObj);
+	void RemoveMenuObject(C4Object *pObj);
+
 	bool OrderObjectBefore(C4Object *pObj1, C4Object *pObj2); // order pObj1 before pObj2
 	bool OrderObjectAfter(C4Object *pObj1, C4Object *pObj2); // order pObj1 after pObj2
 	void FixObjectOrder(); // Called after loading: Resort any objects that are out of order
@@ -81,6 +100,13 @@ public:
 
 	bool ValidateOwners();
 	bool AssignInfo();
+
+protected:
+	virtual void InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore) override;
+	virtual void InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter) override;
+	virtual void RemoveLink(C4ObjectLink *pLnk) override;
+
+	friend class C4ObjResort;
 };
 
 class C4AulFunc;
@@ -43,6 +43,7 @@
 #include <StdSha1.h>
 #include <fcntl.h>
 
+#include <atomic>
 #include <cstring>
 #include <print>
 
@@ -67,6 +68,36 @@ const char *C4CFN_FLS[] =
 	nullptr, nullptr
 };
 
+namespace
+{
+	std::atomic<uint64_t> LookupStatIndexed{0}, LookupStatScans{0}, LookupStatScannedEntries{0};
+
+	bool HasWildcard(const char *szName)
+	{
+		return std::strpbrk(szName, "*?") != nullptr;
+	}
+}
+
+C4GroupLookupStats C4Group_GetLookupStats()
+{
+	return {LookupStatIndexed.load(std::memory_order_relaxed), LookupStatScans.load(std::memory_order_relaxed), LookupStatScannedEntries.load(std::memory_order_relaxed)};
+}
+
+void C4Group_ResetLookupStats()
+{
+	LookupStatIndexed = LookupStatScans = LookupStatScannedEntries = 0;
+}
+
+void C4Group_LogLookupStats(const char *szWhat)
+{
+	const C4GroupLookupStats stats{C4Group_GetLookupStats()};
+#ifdef C4ENGINE
+	LogNTr(spdlog::level::debug, "Group lookups for {}: {} indexed, {} scans comparing {} entries", szWhat, stats.IndexedLookups, stats.ScanLookups, stats.ScannedEntries);
+#else
+	std::println("Group lookups for {}: {} indexed, {} scans comparing {} entries", szWhat, stats.IndexedLookups, stats.ScanLookups, stats.ScannedEntries);
+#endif
+}
+
 #ifndef NDEBUG
 char *szCurrAccessedEntry = nullptr;
 int iC4GroupRewindFilePtrNoWarn = 0;
@@ -634,6 +665,7 @@ void C4Group::Init()
 	Modified = false;
 	Head.Init();
 	FirstEntry = nullptr;
+	EntryIndex.clear();
 	SearchPtr = nullptr;
 	// Folder only
 	FolderSearch.Reset();
@@ -851,7 +883,7 @@ bool C4Group::AddEntry(int status,
 
 	// Delete existing entries of same name
 	centry = GetEntry(GetFilename(entryname ? entryname : fname));
-	if (centry) { centry->Status = C4GRES_Deleted; Head.Entries--; }
+	if (centry) { RemoveFromIndex(centry); centry->Status = C4GRES_Deleted; Head.Entries--; }
 
 	// Allocate memory for new entry
 	nentry = new C4GroupEntry;
@@ -885,6 +917,7 @@ bool C4Group::AddEntry(int status,
 	// Append entry to list
 	if (lentry) lentry->Next = nentry;
 	else FirstEntry = nentry;
+	EntryIndex.insert_or_assign(nentry->FileName, nentry);
 
 	// Increase virtual file count of group
 	Head.Entries++;
@@ -895,14 +928,33 @@ bool C4Group::AddEntry(int status,
 C4GroupEntry *C4Group::GetEntry(const char *szName)
 {
 	if (Status == GRPF_Folder) return nullptr;
+	if (!HasWildcard(szName)) return GetIndexedEntry(szName);
+	LookupStatScans.fetch_add(1, std::memory_order_relaxed);
 	C4GroupEntry *centry;
 	for (centry = FirstEntry; centry; centry = centry->Next)
 		if (centry->Status != C4GRES_Deleted)
+		{
+			LookupStatScannedEntries.fetch_add(1, std::memory_order_relaxed);
 			if (WildcardMatch(szName, centry->FileName))
 				return centry;
+		}
 	return nullptr;
 }
 
+C4GroupEntry *C4Group::GetIndexedEntry(const char *szName)
+{
+	// a name without wildcards can only match the one entry of that name
+	LookupStatIndexed.fetch_add(1, std::memory_order_relaxed);
+	const auto it = EntryIndex.find(std::string_view{szName});
+	return it != EntryIndex.end() ? it->second : nullptr;
+}
+
+void C4Group::RemoveFromIndex(C4GroupEntry *pEntry)
+{
+	const auto it = EntryIndex.find(std::string_view{pEntry->FileName});
+	if (it != EntryIndex.end() && it->second == pEntry) EntryIndex.erase(it);
+}
+
 bool C4Group::Close()
 {
 	C4GroupEntry *centry;
@@ -1053,6 +1105,7 @@ bool C4Group::Save(bool fReOpen)
 void C4Group::Default()
 {
 	FirstEntry = nullptr;
+	EntryIndex.clear();
 	StdFile.Default();
 	Mother = nullptr;
 	ExclusiveChild = 0;
@@ -1069,6 +1122,7 @@ void C4Group::Clear()
 		delete FirstEntry;
 		FirstEntry = next;
 	}
+	EntryIndex.clear();
 	// Close std file
 	StdFile.Close();
 	// Delete mother
@@ -1215,13 +1269,17 @@ C4GroupEntry *C4Group::SearchNextEntry(const char *szName)
 	switch (Status)
 	{
 	case GRPF_File:
+		LookupStatScans.fetch_add(1, std::memory_order_relaxed);
 		for (pEntry = SearchPtr; pEntry; pEntry = pEntry->Next)
 			if (pEntry->Status != C4GRES_Deleted)
+			{
+				LookupStatScannedEntries.fetch_add(1, std::memory_order_relaxed);
 				if (WildcardMatch(szName, pEntry->FileName))
 				{
 					SearchPtr = pEntry->Next;
 					return pEntry;
 				}
+			}
 		break;
 
 	case GRPF_Folder:
@@ -1250,13 +1308,23 @@ bool C4Group::SetFilePtr(size_t iOffset)
 	if (Mother && !Mother->EnsureChildFilePtr(this))
 		return false;
 
-	// Rewind if necessary
-	if (FilePtr > iOffset)
-		if (!RewindFilePtr()) return false;
+	if (FilePtr == iOffset) return true;
 
-	// Advance to target pointer
-	if (FilePtr < iOffset)
-		if (!AdvanceFilePtr(iOffset - FilePtr)) return false;
+	// Child group in a group file: move the mother instead, which ends up seeking in the outermost file
+	if (Mother && Mother->Status == GRPF_File)
+	{
+		if (!Mother->SetFilePtr(MotherOffset + EntryOffset + iOffset))
+			return false;
+	}
+	// Regular group or child group of a folder: seek in the standard file, which doesn't need to rewind compressed files
+	else
+	{
+		CStdFile &rFile = Mother ? Mother->StdFile : StdFile;
+		if (!rFile.Seek(EntryOffset + iOffset))
+			return false;
+	}
+
+	FilePtr = iOffset;
 
 	return true;
 }
@@ -1264,10 +1332,10 @@ bool C4Group::SetFilePtr(size_t iOffset)
 bool C4Group::Advance(size_t iOffset)
 {
 	if (Status == GRPF_Folder) return !!StdFile.Advance(iOffset);
-	// FIXME: reading the file one byte at a time sounds just slow.
-	uint8_t buf;
-	for (; iOffset > 0; iOffset--)
-		if (!Read(&buf, 1)) return false;
+	if (!AdvanceFilePtr(iOffset))
+	{
+		RewindFilePtr(); return Error("Advance:");
+	}
 	return true;
 }
 
@@ -1613,6 +1681,7 @@ bool C4Group::DeleteEntry(const char *szFilename, bool fRecycle)
 			}
 		// (moved buffers are deleted by ~C4GroupEntry)
 		// Delete status and update virtual file count
+		RemoveFromIndex(pEntry);
 		pEntry->Status = C4GRES_Deleted;
 		Head.Entries--;
 		break;
@@ -1647,7 +1716,9 @@ bool C4Group::Rename(const char *szFile, const char *szNewName)
 		// Check double name
 		if (GetEntry(szNewName) && !SEqualNoCase(szNewName, szFile)) return Error("Rename: File exists already");
 		// Rename
+		RemoveFromIndex(pEntry);
 		SCopy(szNewName, pEntry->FileName, _MAX_FNAME);
+		EntryIndex.insert_or_assign(pEntry->FileName, pEntry);
 		Modified = true;
 		break;
 	case GRPF_Folder:
@@ -1978,6 +2049,18 @@ bool C4Group::SetFilePtr2Entry(const char *szName, C4Group *pByChild)
 
 bool C4Group::FindEntry(const char *szWildCard, char *sFileName, size_t *iSize, bool *fChild)
 {
+	// Exact name in group file: no need to search
+	if (Status == GRPF_File && szWildCard && !HasWildcard(szWildCard))
+	{
+		C4GroupEntry *centry = GetIndexedEntry(szWildCard);
+		// continue searching after the entry, as a search from the start would
+		SearchPtr = centry ? centry->Next : nullptr;
+		if (!centry) return false;
+		if (sFileName) SCopy(centry->FileName, sFileName);
+		if (iSize) *iSize = centry->Size;
+		if (fChild) *fChild = !!centry->ChildGroup;
+		return true;
+	}
 	ResetSearch();
 	return FindNextEntry(szWildCard, sFileName, iSize, fChild);
 }
@@ -22,6 +22,12 @@
 #include <StdBuf.h>
 #include <StdCompiler.h>
 
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
 // C4Group-Rewind-warning:
 // The current C4Group-implementation cannot handle random file access very well,
 // because all files are written within a single zlib-stream.
@@ -77,6 +83,18 @@ bool C4Group_GetFileSHA1(const char *szFilename, uint8_t *pSHA1);
 
 bool EraseItemSafe(const char *szFilename);
 
+// counts of entry lookups by name in group files, for measuring load times
+struct C4GroupLookupStats
+{
+	uint64_t IndexedLookups{0}; // exact names found through the entry index
+	uint64_t ScanLookups{0}; // wildcards and sequential searches
+	uint64_t ScannedEntries{0}; // entries compared by those scans
+};
+
+C4GroupLookupStats C4Group_GetLookupStats();
+void C4Group_ResetLookupStats();
+void C4Group_LogLookupStats(const char *szWhat);
+
 extern const char *C4CFN_FLS[];
 
 extern time_t C4Group_AssumeTimeOffset;
@@ -145,6 +163,32 @@ const int GRPF_Inactive = 0,
           GRPF_File = 1,
           GRPF_Folder = 2;
 
+// case insensitive like WildcardMatch
+struct C4GroupEntryNameHash
+{
+	using is_transparent = void;
+
+	size_t operator()(std::string_view name) const
+	{
+		size_t hash{14695981039346656037u};
+		for (const char c : name) hash = (hash ^ static_cast<size_t>(std::tolower(c))) * 1099511628211u;
+		return hash;
+	}
+};
+
+struct C4GroupEntryNameEqual
+{
+	using is_transparent = void;
+
+	bool operator()(std::string_view first, std::string_view second) const
+	{
+		if (first.size() != second.size()) return false;
+		for (size_t i = 0; i < first.size(); ++i)
+			if (std::tolower(first[i]) != std::tolower(second[i])) return false;
+		return true;
+	}
+};
+
 class C4Group
 {
 public:
@@ -168,6 +212,7 @@ protected:
 	bool Modified;
 	C4GroupHeader Head;
 	C4GroupEntry *FirstEntry;
+	std::unordered_map<std::string, C4GroupEntry *, C4GroupEntryNameHash, C4GroupEntryNameEqual> EntryIndex; // entries that are not deleted, by name
 	// Folder only
 	DirectoryIterator FolderSearch;
 	C4GroupEntry FolderSearchEntry;
@@ -279,6 +324,8 @@ protected:
 	bool SetFilePtr2Entry(const char *szName, C4Group *pByChild = nullptr);
 	bool AppendEntry2StdFile(C4GroupEntry *centry, CStdFile &stdfile);
 	C4GroupEntry *GetEntry(const char *szName);
+	C4GroupEntry *GetIndexedEntry(const char *szName);
+	void RemoveFromIndex(C4GroupEntry *pEntry);
 	C4GroupEntry *SearchNextEntry(const char *szName);
 	C4GroupEntry *GetNextFolderEntry();
 	bool CalcCRC32(C4GroupEntry *pEntry);
@@ -0,0 +1,205 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// default relocation for C4InsertionOrderedHashMap: moves key and value into the new entry
+struct C4InsertionOrderedHashMapMoveRelocate
+{
+	template<typename Entry>
+	void operator()(Entry &from, Entry &to) const
+	{
+		to.key = std::move(from.key);
+		to.value = std::move(from.value);
+	}
+};
+
+// Hash map that stores its entries inline in a dense vector in insertion order
+// and finds them through an open-addressed index of entry positions.
+// Erasing an entry only marks it as removed; removed entries are dropped when
+// the entry vector has to grow. Until then, entries never move, so references
+// to them stay valid while the map is being modified. On growth, live entries
+// are handed to Relocate, which has to transfer the key and value into the
+// new, default constructed entry.
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>, typename Relocate = C4InsertionOrderedHashMapMoveRelocate>
+class C4InsertionOrderedHashMap
+{
+public:
+	struct Entry
+	{
+		Key key;
+		Value value;
+		std::size_t hash{0};
+		std::uint32_t sequence{0}; // increasing in entry order; used to resume iterations after compaction
+		bool removed{false};
+	};
+
+private:
+	static constexpr std::size_t MinCapacity{4};
+	// sequence numbers are renumbered on compaction once they get this large, so they fit into script integers
+	static constexpr std::uint32_t MaxSequence{1u << 30};
+	static constexpr std::uint32_t EmptySlot{0};
+
+	std::vector<Entry> entries; // never grows beyond its capacity outside of Rebuild
+	std::vector<std::uint32_t> slots; // entry position + 1, or EmptySlot
+	std::size_t count{0};
+	std::uint32_t nextSequence{0};
+	[[no_unique_address]] Relocate relocate;
+	[[no_unique_address]] Hash hasher;
+	[[no_unique_address]] KeyEqual keyEqual;
+
+public:
+	C4InsertionOrderedHashMap() = default;
+
+	C4InsertionOrderedHashMap(const C4InsertionOrderedHashMap &) = delete;
+	C4InsertionOrderedHashMap &operator=(const C4InsertionOrderedHashMap &) = delete;
+
+	std::size_t size() const { return count; }
+	bool empty() const { return !count; }
+
+	Entry *Find(const Key &key) { return Find(key, hasher(key)); }
+	const Entry *Find(const Key &key) const { return const_cast<C4InsertionOrderedHashMap *>(this)->Find(key, hasher(key)); }
+
+	Entry *Find(const Key &key, const std::size_t hash)
+	{
+		if (slots.empty()) return nullptr;
+		const std::size_t mask{slots.size() - 1};
+		for (std::size_t slot{hash & mask}; slots[slot] != EmptySlot; slot = (slot + 1) & mask)
+		{
+			Entry &entry{entries[slots[slot] - 1]};
+			if (!entry.removed && entry.hash == hash && keyEqual(entry.key, key))
+			{
+				return &entry;
+			}
+		}
+		return nullptr;
+	}
+
+	// Returns the entry for key and whether it has been newly inserted.
+	// A new entry is appended with a default constructed value; its key is assigned from the parameter.
+	std::pair<Entry *, bool> Insert(const Key &key)
+	{
+		const std::size_t hash{hasher(key)};
+		if (Entry *const entry{Find(key, hash)}) return {entry, false};
+
+		if (entries.size() == entries.capacity())
+		{
+			Rebuild(std::max(MinCapacity, count * 2));
+		}
+
+		const auto position = static_cast<std::uint32_t>(entries.size());
+		Entry &entry{entries.emplace_back()};
+		entry.key = key;
+		entry.hash = hash;
+		entry.sequence = nextSequence++;
+		// take the first free or removed slot in the probe sequence
+		const std::size_t mask{slots.size() - 1};
+		std::size_t slot{hash & mask};
+		while (slots[slot] != EmptySlot && !entries[slots[slot] - 1].removed)
+		{
+			slot = (slot + 1) & mask;
+		}
+		slots[slot] = position + 1;
+		++count;
+		return {&entry, true};
+	}
+
+	// Marks the entry as removed. Key and value are left untouched; they are destroyed on the next compaction or Clear.
+	void Erase(Entry &entry)
+	{
+		assert(!entry.removed);
+		entry.removed = true;
+		--count;
+	}
+
+	void Clear()
+	{
+		entries.clear();
+		entries.shrink_to_fit();
+		slots.clear();
+		count = 0;
+		nextSequence = 0;
+	}
+
+	// Position-based access for iterations that must survive erasing entries
+	std::size_t EntryCount() const { return entries.size(); }
+	Entry &GetEntry(const std::size_t position) { return entries[position]; }
+	const Entry &GetEntry(const std::size_t position) const { return entries[position]; }
+
+	// first position >= position that holds a live entry, or EntryCount()
+	std::size_t NextLivePosition(std::size_t position) const
+	{
+		while (position < entries.size() && entries[position].removed) ++position;
+		return position;
+	}
+
+	// first position of a live entry that has been inserted with or after the given sequence number, or EntryCount()
+	std::size_t PositionOfSequence(const std::uint32_t sequence) const
+	{
+		const auto it = std::ranges::lower_bound(entries, sequence, {}, &Entry::sequence);
+		return NextLivePosition(static_cast<std::size_t>(it - entries.begin()));
+	}
+
+	// position of an entry that contains the given address, for values that only know their own address
+	std::size_t PositionOf(const void *const member) const
+	{
+		assert(!entries.empty());
+		const auto offset = static_cast<const std::byte *>(member) - reinterpret_cast<const std::byte *>(entries.data());
+		assert(offset >= 0 && static_cast<std::size_t>(offset) < entries.size() * sizeof(Entry));
+		return static_cast<std::size_t>(offset) / sizeof(Entry);
+	}
+
+private:
+	void Rebuild(const std::size_t capacity)
+	{
+		assert(capacity >= count);
+		std::vector<Entry> newEntries;
+		newEntries.reserve(capacity);
+
+		const bool renumber{nextSequence >= MaxSequence};
+		if (renumber) nextSequence = 0;
+
+		for (Entry &entry : entries)
+		{
+			if (entry.removed) continue;
+			Entry &newEntry{newEntries.emplace_back()};
+			newEntry.hash = entry.hash;
+			newEntry.sequence = renumber ? nextSequence++ : entry.sequence;
+			relocate(entry, newEntry);
+		}
+
+		// destroys removed entries and the remains of relocated ones
+		entries.swap(newEntries);
+		newEntries.clear();
+
+		slots.assign(std::bit_ceil(capacity * 2), EmptySlot);
+		const std::size_t mask{slots.size() - 1};
+		for (std::size_t position{0}; position < entries.size(); ++position)
+		{
+			std::size_t slot{entries[position].hash & mask};
+			while (slots[slot] != EmptySlot) slot = (slot + 1) & mask;
+			slots[slot] = static_cast<std::uint32_t>(position + 1);
+		}
+	}
+};
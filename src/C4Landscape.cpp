@@ -27,6 +27,7 @@
 #include <C4Physics.h>
 #include <C4Random.h>
 #include <C4SurfaceFile.h>
+#include <C4SyncHash.h>
 #include <C4ToolsDlg.h>
 #ifdef DEBUGREC
 #include <C4Record.h>
@@ -40,6 +41,7 @@
 #include <StdPNG.h>
 
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
 #include <utility>
@@ -249,12 +251,18 @@ void C4Landscape::Clear(bool fClearMapCreator, bool fClearSky)
 	delete Map;              Map              = nullptr;
 	// clear initial landscape
 	delete[] pInitial;       pInitial         = nullptr;
+	DiffTiles.clear();
+	DiffTilesPitch = 0;
 	// clear scan
 	ScanX = 0;
 	Mode = C4LSC_Undefined;
 	// clear pixel count
 	delete[] PixCnt;         PixCnt           = nullptr;
 	PixCntPitch = 0;
+	SolidityBits.Clear();
+	SyncHashTiles.clear();
+	SyncHashTilesPitch = 0;
+	SyncHash = 0;
 }
 
 void C4Landscape::Draw(C4FacetEx &cgo, int32_t iPlayer)
@@ -716,6 +724,12 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 	PixCntPitch = (Height + 14) / 15;
 	PixCnt = new uint8_t[PixCntWidth * PixCntPitch];
 	UpdatePixCnt(C4Rect(0, 0, Width, Height));
+	SolidityBits.Init(Width, Height);
+	UpdateSolidityBits(C4Rect(0, 0, Width, Height));
+	SyncHashTilesPitch = (Width + C4LS_SyncHashTileSize - 1) / C4LS_SyncHashTileSize;
+	SyncHashTiles.assign(SyncHashTilesPitch * ((Height + C4LS_SyncHashTileSize - 1) / C4LS_SyncHashTileSize), 0);
+	SyncHash = 0;
+	UpdateSyncHashTiles(C4Rect(0, 0, Width, Height));
 	ClearMatCount();
 	UpdateMatCnt(C4Rect(0, 0, Width, Height), true);
 
@@ -844,6 +858,17 @@ bool C4Landscape::_SetPix(int32_t x, int32_t y, uint8_t npix)
 
 	// set 8bpp-surface only!
 	Surface8->SetPix(x, y, npix);
+	if ((Pix2Dens[npix] >= C4M_Solid) != (Pix2Dens[opix] >= C4M_Solid))
+		SolidityBits.Set(x, y, Pix2Dens[npix] >= C4M_Solid);
+	// note for diff
+	if (!DiffTiles.empty()) DiffTiles[(y / C4LS_DiffTileSize) * DiffTilesPitch + x / C4LS_DiffTileSize] = true;
+	// update sync hash
+	if (!SyncHashTiles.empty())
+	{
+		const uint64_t change = C4SyncHash::Pixel(x, y, opix) ^ C4SyncHash::Pixel(x, y, npix);
+		SyncHashTiles[(y / C4LS_SyncHashTileSize) * SyncHashTilesPitch + x / C4LS_SyncHashTileSize] ^= change;
+		SyncHash ^= change;
+	}
 	// success
 	return true;
 }
@@ -1476,20 +1501,36 @@ bool C4Landscape::SaveDiff(C4Group &hGroup, bool fSyncSave)
 	assert(pInitial);
 	if (!pInitial) return false;
 
-	// If it shouldn't be sync-save: Clear all bytes that have not changed
+	// If it shouldn't be sync-save: Only save changed pixels, all others are 0xff
+	// Only tiles that have been written to since SaveInitial can contain changes
+	CSurface8 Diff;
 	bool fChanged = false;
 	if (!fSyncSave)
-		for (int y = 0; y < Height; y++)
-			for (int x = 0; x < Width; x++)
-				if (pInitial[y * Width + x] == _GetPix(x, y))
-					Surface8->SetPix(x, y, 0xff);
-				else
-					fChanged = true;
+		for (int32_t iTileY = 0; iTileY * C4LS_DiffTileSize < Height; iTileY++)
+			for (int32_t iTileX = 0; iTileX < DiffTilesPitch; iTileX++)
+			{
+				if (!DiffTiles[iTileY * DiffTilesPitch + iTileX]) continue;
+				const int32_t iX2 = std::min<int32_t>((iTileX + 1) * C4LS_DiffTileSize, Width);
+				const int32_t iY2 = std::min<int32_t>((iTileY + 1) * C4LS_DiffTileSize, Height);
+				for (int32_t y = iTileY * C4LS_DiffTileSize; y < iY2; y++)
+					for (int32_t x = iTileX * C4LS_DiffTileSize; x < iX2; x++)
+					{
+						const uint8_t byPix = _GetPix(x, y);
+						if (pInitial[y * Width + x] == byPix) continue;
+						if (!fChanged)
+						{
+							if (!Diff.Create(Width, Height)) return false;
+							std::memset(Diff.Bits, 0xff, Diff.Pitch * Diff.Hgt);
+							fChanged = true;
+						}
+						Diff.Bits[y * Diff.Pitch + x] = byPix;
+					}
+			}
 
 	if (fSyncSave || fChanged)
 	{
 		// Save landscape surface
-		if (!Surface8->Save(Config.AtTempPath(C4CFN_TempLandscape)))
+		if (!(fSyncSave ? Surface8 : &Diff)->Save(Config.AtTempPath(C4CFN_TempLandscape), Surface8->pPal->Colors))
 			return false;
 
 		// Move temp file to group
@@ -1498,14 +1539,6 @@ bool C4Landscape::SaveDiff(C4Group &hGroup, bool fSyncSave)
 			return false;
 	}
 
-	// Restore landscape pixels
-	if (!fSyncSave)
-		if (pInitial)
-			for (int y = 0; y < Height; y++)
-				for (int x = 0; x < Width; x++)
-					if (_GetPix(x, y) == 0xff)
-						Surface8->SetPix(x, y, pInitial[y * Width + x]);
-
 	// Save changed map, too
 	if (fMapChanged && Map)
 		if (!SaveMap(hGroup)) return false;
@@ -1523,9 +1556,15 @@ bool C4Landscape::SaveInitial()
 	pInitial = new uint8_t[Width * Height];
 
 	// Save material data
-	for (int y = 0; y < Height; y++)
-		for (int x = 0; x < Width; x++)
-			pInitial[y * Width + x] = _GetPix(x, y);
+	if (Surface8->Pitch == Width)
+		std::memcpy(pInitial, Surface8->Bits, Width * Height);
+	else
+		for (int32_t y = 0; y < Height; y++)
+			std::memcpy(pInitial + y * Width, Surface8->Bits + y * Surface8->Pitch, Width);
+
+	// Nothing has changed yet
+	DiffTilesPitch = (Width + C4LS_DiffTileSize - 1) / C4LS_DiffTileSize;
+	DiffTiles.assign(DiffTilesPitch * ((Height + C4LS_DiffTileSize - 1) / C4LS_DiffTileSize), false);
 
 	return true;
 }
@@ -1648,6 +1687,9 @@ void C4Landscape::Default()
 	Map = nullptr;
 	Width = Height = 0;
 	MapWidth = MapHeight = MapZoom = 0;
+	DiffTilesPitch = 0;
+	SyncHashTilesPitch = 0;
+	SyncHash = 0;
 	ClearMatCount();
 	ClearBlastMatCount();
 	ScanX = 0;
@@ -2816,6 +2858,8 @@ void C4Landscape::HandleTexMapUpdate()
 {
 	// Pixel maps must be update
 	UpdatePixMaps();
+	// densities may have changed
+	UpdateSolidityBits(C4Rect(0, 0, Width, Height));
 	// Update landscape palette
 	Mat2Pal();
 }
@@ -2867,6 +2911,11 @@ void C4Landscape::PrepareChange(C4Rect BoundingBox, const bool updateMatCnt)
 
 void C4Landscape::FinishChange(C4Rect BoundingBox, const bool updateMatAndPixCnt)
 {
+	// note for diff
+	const C4Rect DirtyRect{GetDirtyRect(BoundingBox)};
+	MarkDiffTiles(DirtyRect);
+	UpdateSolidityBits(DirtyRect);
+	UpdateSyncHashTiles(DirtyRect);
 	// relight
 	Relight(BoundingBox);
 	if (updateMatAndPixCnt) UpdateMatCnt(BoundingBox, true);
@@ -2882,6 +2931,46 @@ void C4Landscape::FinishChange(C4Rect BoundingBox, const bool updateMatAndPixCnt
 	C4SolidMask::CheckConsistency();
 }
 
+C4Rect C4Landscape::GetDirtyRect(C4Rect BoundingBox) const
+{
+	// the drawing functions clip inclusively, so they may touch one pixel more
+	BoundingBox.Enlarge(1);
+	BoundingBox.Intersect(C4Rect(0, 0, Width, Height));
+	return BoundingBox;
+}
+
+void C4Landscape::MarkDiffTiles(const C4Rect &BoundingBox)
+{
+	if (DiffTiles.empty() || !BoundingBox.Wdt || !BoundingBox.Hgt) return;
+	for (int32_t y = BoundingBox.y / C4LS_DiffTileSize; y <= (BoundingBox.y + BoundingBox.Hgt - 1) / C4LS_DiffTileSize; y++)
+		for (int32_t x = BoundingBox.x / C4LS_DiffTileSize; x <= (BoundingBox.x + BoundingBox.Wdt - 1) / C4LS_DiffTileSize; x++)
+			DiffTiles[y * DiffTilesPitch + x] = true;
+}
+
+void C4Landscape::UpdateSolidityBits(const C4Rect &Rect)
+{
+	for (int32_t y = Rect.y; y < Rect.y + Rect.Hgt; y++)
+		for (int32_t x = Rect.x; x < Rect.x + Rect.Wdt; x++)
+			SolidityBits.Set(x, y, _GetDensity(x, y) >= C4M_Solid);
+}
+
+void C4Landscape::UpdateSyncHashTiles(const C4Rect &Rect)
+{
+	if (SyncHashTiles.empty() || !Rect.Wdt || !Rect.Hgt) return;
+	// rehash all touched tiles completely
+	for (int32_t ty = Rect.y / C4LS_SyncHashTileSize; ty <= (Rect.y + Rect.Hgt - 1) / C4LS_SyncHashTileSize; ty++)
+		for (int32_t tx = Rect.x / C4LS_SyncHashTileSize; tx <= (Rect.x + Rect.Wdt - 1) / C4LS_SyncHashTileSize; tx++)
+		{
+			uint64_t hash = 0;
+			for (int32_t y = ty * C4LS_SyncHashTileSize; y < std::min<int32_t>((ty + 1) * C4LS_SyncHashTileSize, Height); y++)
+				for (int32_t x = tx * C4LS_SyncHashTileSize; x < std::min<int32_t>((tx + 1) * C4LS_SyncHashTileSize, Width); x++)
+					hash ^= C4SyncHash::Pixel(x, y, _GetPix(x, y));
+			uint64_t &tile = SyncHashTiles[ty * SyncHashTilesPitch + tx];
+			SyncHash ^= tile ^ hash;
+			tile = hash;
+		}
+}
+
 void C4Landscape::UpdatePixCnt(const C4Rect &Rect, bool fCheck)
 {
 	int32_t PixCntWidth = (Width + 16) / 17;
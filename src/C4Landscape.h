@@ -21,10 +21,12 @@
 #include "C4Id.h"
 #include "C4Sky.h"
 #include "C4Shape.h"
+#include "C4SolidityBitplane.h"
 
 #include <StdSurface8.h>
 
 #include <cstdint>
+#include <vector>
 
 const uint8_t GBM        = 128,
               GBM_ColNum = 64,
@@ -41,6 +43,8 @@ const int32_t C4LSC_Undefined = 0,
               C4LSC_Exact = 3;
 
 const int32_t C4LS_MaxRelights = 50;
+const int32_t C4LS_DiffTileSize = 64; // edge length of the tiles tracked for SaveDiff
+const int32_t C4LS_SyncHashTileSize = 64; // edge length of the tiles hashed for sync checks
 
 class C4MapCreatorS2;
 class C4Object;
@@ -78,7 +82,13 @@ protected:
 	CSurface8 *Surface8;
 	int32_t Pix2Mat[256], Pix2Dens[256], Pix2Place[256];
 	int32_t PixCntPitch;
+	std::vector<bool> DiffTiles; // tiles that may differ from pInitial
+	int32_t DiffTilesPitch;
 	uint8_t *PixCnt;
+	C4SolidityBitplane SolidityBits; // pixels with a density of at least C4M_Solid
+	std::vector<uint64_t> SyncHashTiles; // XOR sums of C4SyncHash::Pixel per tile
+	int32_t SyncHashTilesPitch;
+	uint64_t SyncHash; // XOR sum of all tile hashes
 	C4Rect Relights[C4LS_MaxRelights];
 
 public:
@@ -175,6 +185,11 @@ public:
 		return Pix2Mat[GetPix(x, y)];
 	}
 
+	const C4SolidityBitplane &GetSolidityBits() const { return SolidityBits; }
+	uint64_t GetSyncHash() const { return SyncHash; }
+	const std::vector<uint64_t> &GetSyncHashTiles() const { return SyncHashTiles; }
+	int32_t GetSyncHashTilesPitch() const { return SyncHashTilesPitch; }
+
 	inline int32_t GetDensity(int32_t x, int32_t y) // get landscape density (bounds checked)
 	{
 		return Pix2Dens[GetPix(x, y)];
@@ -243,6 +258,11 @@ protected:
 	void UpdateMatCnt(C4Rect Rect, bool fPlus);
 	void PrepareChange(C4Rect BoundingBox, bool updateMatCnt = true);
 	void FinishChange(C4Rect BoundingBox, bool updateMatAndPixCnt = true);
+	C4Rect GetDirtyRect(C4Rect BoundingBox) const; // pixels a change inside BoundingBox may have touched
+	// these take rects inside the landscape
+	void MarkDiffTiles(const C4Rect &BoundingBox);
+	void UpdateSolidityBits(const C4Rect &Rect);
+	void UpdateSyncHashTiles(const C4Rect &Rect);
 	static bool DrawLineLandscape(int32_t iX, int32_t iY, int32_t iGrade);
 
 public:
@@ -22,9 +22,14 @@
 #include <C4Random.h>
 
 #include <C4Game.h>
+#include <C4ParallelRows.h>
+#include <C4ThreadPool.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <thread>
 
 // C4MCCallbackArray
 
@@ -34,6 +39,7 @@ C4MCCallbackArray::C4MCCallbackArray(C4AulFunc *pSFunc, C4MapCreatorS2 *pMapCrea
 	pSF = pSFunc;
 	// zero fields
 	pMap = nullptr; pNext = nullptr;
+	fTempMap = false;
 	// store and add in map creator
 	if (this->pMapCreator = pMapCreator)
 		pMapCreator->CallbackArrays.Add(this);
@@ -46,27 +52,32 @@ C4MCCallbackArray::~C4MCCallbackArray()
 	delete[] pMap;
 }
 
+bool C4MCCallbackArray::CreateMap()
+{
+	// already created?
+	if (pMap) return true;
+	// safety
+	if (!pMapCreator) return false;
+	// get current map size
+	C4MCMap *pCurrMap = pMapCreator->pCurrentMap;
+	if (!pCurrMap) return false;
+	iWdt = pCurrMap->Wdt; iHgt = pCurrMap->Hgt;
+	// create bitmap
+	int32_t iSize = (iWdt * iHgt + 7) / 8;
+	pMap = new uint8_t[iSize]{};
+	// done
+	return true;
+}
+
 void C4MCCallbackArray::EnablePixel(int32_t iX, int32_t iY)
 {
 	// array not yet created? then do that now!
-	if (!pMap)
-	{
-		// safety
-		if (!pMapCreator) return;
-		// get current map size
-		C4MCMap *pCurrMap = pMapCreator->pCurrentMap;
-		if (!pCurrMap) return;
-		iWdt = pCurrMap->Wdt; iHgt = pCurrMap->Hgt;
-		// create bitmap
-		int32_t iSize = (iWdt * iHgt + 7) / 8;
-		pMap = new uint8_t[iSize]{};
-		// done
-	}
+	if (!CreateMap()) return;
 	// safety: do not set outside map!
 	if (iX < 0 || iY < 0 || iX >= iWdt || iY >= iHgt) return;
-	// set in map
+	// set in map; neighbouring pixels share a byte, so this must be atomic for parallel rendering
 	int32_t iIndex = iX + iY * iWdt;
-	pMap[iIndex / 8] |= 1 << (iIndex % 8);
+	std::atomic_ref<uint8_t>{pMap[iIndex / 8]}.fetch_or(static_cast<uint8_t>(1 << (iIndex % 8)), std::memory_order_relaxed);
 	// done
 }
 
@@ -117,6 +128,29 @@ void C4MCCallbackArrayList::Clear()
 	pFirst = nullptr;
 }
 
+void C4MCCallbackArrayList::CreateTempMaps()
+{
+	for (C4MCCallbackArray *pArray = pFirst; pArray; pArray = pArray->pNext)
+		if (!pArray->pMap && pArray->CreateMap())
+			pArray->fTempMap = true;
+}
+
+void C4MCCallbackArrayList::DropEmptyTempMaps()
+{
+	// arrays that got no pixel would not have been created at all
+	for (C4MCCallbackArray *pArray = pFirst; pArray; pArray = pArray->pNext)
+	{
+		if (!pArray->fTempMap) continue;
+		pArray->fTempMap = false;
+		const int32_t iSize = (pArray->iWdt * pArray->iHgt + 7) / 8;
+		if (std::all_of(pArray->pMap, pArray->pMap + iSize, [](const uint8_t byte) { return !byte; }))
+		{
+			delete[] pArray->pMap;
+			pArray->pMap = nullptr;
+		}
+	}
+}
+
 void C4MCCallbackArrayList::Execute(int32_t iMapZoom)
 {
 	// execute all arrays
@@ -639,12 +673,41 @@ void C4MCMap::Default()
 		Wdt = (std::min)(Wdt * (std::min)(MapCreator->PlayerCount, C4S_MaxMapPlayerExtend), MapCreator->Landscape->MapWdt.Max);
 }
 
-bool C4MCMap::RenderTo(uint8_t *pToBuf, int32_t iPitch)
+bool AlgoScript(C4MCOverlay *pOvrl, int32_t iX, int32_t iY);
+
+bool C4MCMap::CanRenderParallel()
 {
-	// set current render target
-	if (MapCreator) MapCreator->pCurrentMap = this;
+#ifdef DEBUGREC
+	// debug records are written in pixel order
+	return false;
+#else
+	if (!MapCreator) return false;
+	// script algorithms execute script, which must stay on the main thread
+	// other algorithms only read the overlay tree
+	C4MCNode *pNode = this;
+	while (pNode)
+	{
+		if (C4MCOverlay *pOvrl = pNode->Overlay())
+			if (pOvrl->Algorithm && pOvrl->Algorithm->Function == &AlgoScript)
+				return false;
+		// next node in depth-first order
+		if (pNode->Child0)
+			pNode = pNode->Child0;
+		else
+		{
+			while (pNode != this && !pNode->Next) pNode = pNode->Owner;
+			pNode = (pNode == this) ? nullptr : pNode->Next;
+		}
+	}
+	return true;
+#endif
+}
+
+void C4MCMap::RenderRows(uint8_t *pToBuf, int32_t iPitch, int32_t iFirstRow, int32_t iRowCount)
+{
+	pToBuf += iFirstRow * iPitch;
 	// draw pixel by pixel
-	for (int32_t iY = 0; iY < Hgt; iY++)
+	for (int32_t iY = iFirstRow; iY < iFirstRow + iRowCount; iY++)
 	{
 		for (int32_t iX = 0; iX < Wdt; iX++)
 		{
@@ -663,6 +726,25 @@ bool C4MCMap::RenderTo(uint8_t *pToBuf, int32_t iPitch)
 		// next line
 		pToBuf += iPitch - Wdt;
 	}
+}
+
+bool C4MCMap::RenderTo(uint8_t *pToBuf, int32_t iPitch, int32_t iThreadCount)
+{
+	// set current render target
+	if (MapCreator) MapCreator->pCurrentMap = this;
+	if (!iThreadCount) iThreadCount = static_cast<int32_t>(std::thread::hardware_concurrency());
+	if (iThreadCount > 1 && C4ThreadPool::Global && CanRenderParallel())
+	{
+		// every pixel only depends on its position, so bands of rows can be rendered concurrently
+		// callback bitmaps must exist beforehand, so the bands only set bits in them
+		MapCreator->CallbackArrays.CreateTempMaps();
+		C4ParallelRows(Hgt, C4MC_RenderBandHeight, iThreadCount,
+			[](auto &&worker) { C4ThreadPool::Global->SubmitCallback(std::forward<decltype(worker)>(worker)); },
+			[this, pToBuf, iPitch](const int32_t iFirstRow, const int32_t iRowCount) { RenderRows(pToBuf, iPitch, iFirstRow, iRowCount); });
+		MapCreator->CallbackArrays.DropEmptyTempMaps();
+	}
+	else
+		RenderRows(pToBuf, iPitch, 0, Hgt);
 	// reset render target
 	if (MapCreator) MapCreator->pCurrentMap = nullptr;
 	// success
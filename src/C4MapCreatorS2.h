@@ -28,6 +28,7 @@
 
 #define C4MC_SizeRes 100 // positions in percent
 #define C4MC_ZoomRes 100 // zoom resolution (-100 to +99)
+#define C4MC_RenderBandHeight 16 // rows per band when rendering on multiple threads
 
 // string consts
 #define C4MC_Overlay "overlay" // overlay node
@@ -120,13 +121,17 @@ protected:
 	uint8_t *pMap; // bitmap whether or not to call the function for a map pixel
 	int32_t iWdt, iHgt; // size of the bitmap, when created
 	C4AulFunc *pSF; // script func to be called
+	bool fTempMap; // bitmap has been created in advance and is dropped again if nothing is enabled
 
 	C4MCCallbackArray *pNext; // next array in linked list
 
 public:
-	void EnablePixel(int32_t iX, int32_t iY); // enable pixel in map; create map if necessary
+	void EnablePixel(int32_t iX, int32_t iY); // enable pixel in map; create map if necessary; may be called from multiple threads once the map exists
 	void Execute(int32_t iMapZoom); // evaluate the array
 
+protected:
+	bool CreateMap(); // create map for the size of the current map, if not done yet
+
 	friend class C4MCCallbackArrayList;
 };
 
@@ -144,6 +149,8 @@ public:
 	void Add(C4MCCallbackArray *pNewArray); // add given array to list
 	void Clear(); // clear the list
 	void Execute(int32_t iMapZoom); // execute all arrays
+	void CreateTempMaps(); // create all maps in advance, so EnablePixel doesn't need to
+	void DropEmptyTempMaps(); // drop maps created in advance that are still empty
 };
 
 // generic map creator tree node
@@ -334,9 +341,11 @@ public:
 
 protected:
 	void Default(); // set default values for default presets
+	bool CanRenderParallel(); // whether pixels may be rendered concurrently
+	void RenderRows(uint8_t *pToBuf, int32_t iPitch, int32_t iFirstRow, int32_t iRowCount); // render given rows to buffer
 
 public:
-	bool RenderTo(uint8_t *pToBuf, int32_t iPitch); // render to buffer
+	bool RenderTo(uint8_t *pToBuf, int32_t iPitch, int32_t iThreadCount = 0); // render to buffer; 0 threads uses all cores
 	void SetSize(int32_t iWdt, int32_t iHgt);
 
 public:
@@ -24,6 +24,9 @@
 #include <C4Game.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
+#include <vector>
+
 // Note: creation optimized using advancing CreatePtr, so sequential
 // creation does not keep rescanning the complete set for a free
 // slot. (This had caused extreme delays.) This had the effect that
@@ -35,6 +38,12 @@
 // running slower and smoother, overall MM counts are much lower,
 // hardly ever exceeding 1000. October 1997
 
+// Note: slots in use are tracked in a bitmap, so execution and creation
+// skip free slots without changing the order in which slots are used.
+// If all slots are in use, the set grows instead of dropping movers.
+// Growing never moves existing movers, so a mover may create new movers
+// (directly or through material reactions) while it is being executed.
+
 C4MassMoverSet::C4MassMoverSet()
 {
 	Default();
@@ -49,43 +58,41 @@ void C4MassMoverSet::Clear() {}
 
 void C4MassMoverSet::Execute()
 {
-	C4MassMover *cmm;
-	// Init counts
-	Count = 0;
-	// Execute & count
+	// Execute from the top down
 	for (int32_t speed = 2; speed > 0; speed--)
-	{
-		cmm = &(Set[C4MassMoverChunk - 1]);
-		for (int32_t cnt = 0; cnt < C4MassMoverChunk; cnt++, cmm--)
-			if (cmm->Mat != MNone)
-			{
-				Count++; cmm->Execute();
-			}
-	}
+		for (int32_t cnt = Set.PrevUsed(Set.Size()); cnt >= 0; cnt = Set.PrevUsed(cnt))
+			ExecuteSlot(cnt);
+}
+
+void C4MassMoverSet::ExecuteSlot(int32_t iSlot)
+{
+	C4MassMover &rMover = Set[iSlot];
+	rMover.Execute();
+	if (rMover.Mat == MNone) SetUsed(iSlot, false);
 }
 
 bool C4MassMoverSet::Create(int32_t x, int32_t y, bool fExecute)
 {
-	if (Count == C4MassMoverChunk) return false;
 #ifdef DEBUGREC
 	C4RCMassMover rc;
 	rc.x = x; rc.y = y;
 	AddDbgRec(RCT_MMC, &rc, sizeof(rc));
 #endif
-	int32_t cptr = CreatePtr;
-	do
+	// next free slot after CreatePtr, wrapping around
+	const int32_t iSize = Set.Size();
+	int32_t cptr = Set.NextFree(CreatePtr + 1, iSize);
+	if (cptr == -1) cptr = Set.NextFree(0, std::min(CreatePtr + 1, iSize));
+	// all in use: add a slot
+	if (cptr == -1)
 	{
-		cptr++;
-		if (cptr >= C4MassMoverChunk) cptr = 0;
-		if (Set[cptr].Mat == MNone)
-		{
-			if (!Set[cptr].Init(x, y)) return false;
-			CreatePtr = cptr;
-			if (fExecute) Set[cptr].Execute();
-			return true;
-		}
-	} while (cptr != CreatePtr);
-	return false;
+		cptr = iSize;
+		Resize(iSize + 1);
+	}
+	if (!Set[cptr].Init(x, y)) return false;
+	SetUsed(cptr, true);
+	CreatePtr = cptr;
+	if (fExecute) ExecuteSlot(cptr);
+	return true;
 }
 
 bool C4MassMover::Init(int32_t tx, int32_t ty)
@@ -96,7 +103,6 @@ bool C4MassMover::Init(int32_t tx, int32_t ty)
 	// Check mat
 	Mat = GBackMat(tx, ty);
 	x = tx; y = ty;
-	Game.MassMover.Count++;
 	return (Mat != MNone);
 }
 
@@ -107,7 +113,6 @@ void C4MassMover::Cease()
 	rc.x = x; rc.y = y;
 	AddDbgRec(RCT_MMD, &rc, sizeof(rc));
 #endif
-	Game.MassMover.Count--;
 	Mat = MNone;
 }
 
@@ -172,30 +177,40 @@ bool C4MassMover::Corrosion(int32_t dx, int32_t dy)
 
 void C4MassMoverSet::Default()
 {
-	int32_t cnt;
-	for (cnt = 0; cnt < C4MassMoverChunk; cnt++) Set[cnt].Mat = MNone;
+	Set.Clear();
+	Resize(C4MassMoverChunk);
 	Count = 0;
 	CreatePtr = 0;
 }
 
+void C4MassMoverSet::Resize(int32_t iSize)
+{
+	C4MassMover empty{};
+	empty.Mat = MNone;
+	Set.Resize(iSize, empty);
+}
+
+void C4MassMoverSet::SetUsed(int32_t iSlot, bool fUsed)
+{
+	Set.SetUsed(iSlot, fUsed);
+	Count += fUsed ? 1 : -1;
+}
+
 bool C4MassMoverSet::Save(C4Group &hGroup)
 {
-	int32_t cnt;
 	// Consolidate
 	Consolidate();
-	// Recount
-	Count = 0;
-	for (cnt = 0; cnt < C4MassMoverChunk; cnt++)
-		if (Set[cnt].Mat != MNone)
-			Count++;
 	// All empty: delete component
 	if (!Count)
 	{
 		hGroup.Delete(C4CFN_MassMover);
 		return true;
 	}
-	// Save set
-	if (!hGroup.Add(C4CFN_MassMover, Set, Count * sizeof(C4MassMover)))
+	// Save set; consolidated movers are the first Count slots
+	std::vector<C4MassMover> buf;
+	buf.reserve(Count);
+	for (int32_t cnt = 0; cnt < Count; cnt++) buf.push_back(Set[cnt]);
+	if (!hGroup.Add(C4CFN_MassMover, buf.data(), buf.size() * sizeof(C4MassMover)))
 		return false;
 	// Success
 	return true;
@@ -211,37 +226,32 @@ bool C4MassMoverSet::Load(C4Group &hGroup)
 	if ((iBinSize % iMoverSize) != 0) return false;
 
 	// load new
-	Count = iBinSize / iMoverSize;
-	if (!hGroup.Read(Set, iBinSize)) return false;
+	const auto iCount = static_cast<int32_t>(iBinSize / iMoverSize);
+	std::vector<C4MassMover> buf(iCount);
+	if (!hGroup.Read(buf.data(), iBinSize)) return false;
+	Resize(std::max(iCount, C4MassMoverChunk));
+	for (int32_t cnt = 0; cnt < iCount; cnt++)
+		if (buf[cnt].Mat != MNone)
+		{
+			Set[cnt] = buf[cnt];
+			SetUsed(cnt, true);
+		}
 	return true;
 }
 
 void C4MassMoverSet::Consolidate()
 {
-	// Consolidate set
-	int32_t iSpot, iPtr, iConsolidated;
-	for (iSpot = -1, iPtr = 0, iConsolidated = 0; iPtr < C4MassMoverChunk; iPtr++)
-	{
-		// Empty: set new spot if needed
-		if (Set[iPtr].Mat == MNone)
-		{
-			if (iSpot == -1) iSpot = iPtr;
-		}
-		// Full: move down to empty spot if possible
-		else if (iSpot != -1)
-		{
-			// Move to spot
-			Set[iSpot] = Set[iPtr];
-			Set[iPtr].Mat = MNone;
-			iConsolidated++;
-			// Advance empty spot (as far as ptr)
-			for (; iSpot < iPtr; iSpot++)
-				if (Set[iSpot].Mat == MNone)
-					break;
-			// No empty spot below ptr
-			if (iSpot == iPtr) iSpot = -1;
-		}
-	}
+	// Consolidate set: move all used slots down, keeping their order
+	int32_t iPtr = 0;
+	for (int32_t cnt = 0; cnt < Set.Size(); cnt++)
+		if (Set[cnt].Mat != MNone)
+			Set[iPtr++] = Set[cnt];
+	// Drop added slots again, so the slot count only depends on the number of movers
+	Set.ClearUsed();
+	Count = 0;
+	Resize(iPtr);
+	Resize(std::max(iPtr, C4MassMoverChunk));
+	for (int32_t cnt = 0; cnt < iPtr; cnt++) SetUsed(cnt, true);
 	// Reset create ptr
 	CreatePtr = 0;
 }
@@ -256,5 +266,5 @@ void C4MassMoverSet::Copy(C4MassMoverSet &rSet)
 	Clear();
 	Count = rSet.Count;
 	CreatePtr = rSet.CreatePtr;
-	for (int32_t cnt = 0; cnt < C4MassMoverChunk; cnt++) Set[cnt] = rSet.Set[cnt];
+	Set = rSet.Set;
 }
@@ -19,10 +19,11 @@
 #pragma once
 
 #include "C4ForwardDeclarations.h"
+#include "C4SlotSet.h"
 
 #include <cstdint>
 
-const int32_t C4MassMoverChunk = 10000;
+const int32_t C4MassMoverChunk = 10000; // initial number of slots; more are added if all are in use
 
 class C4MassMoverSet;
 
@@ -51,7 +52,7 @@ public:
 	int32_t CreatePtr;
 
 protected:
-	C4MassMover Set[C4MassMoverChunk];
+	C4SlotSet<C4MassMover> Set; // movers may add slots while being executed, so slots must not move
 
 public:
 	void Copy(C4MassMoverSet &rSet);
@@ -65,4 +66,7 @@ public:
 
 protected:
 	void Consolidate();
+	void Resize(int32_t iSize);
+	void SetUsed(int32_t iSlot, bool fUsed);
+	void ExecuteSlot(int32_t iSlot);
 };
@@ -452,7 +452,9 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		LogNTr("/observer [client] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETTHESPECIFIEDCLIENTTOOB));
 		LogNTr("/fast [x] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETTOFASTMODESKIPPINGXFRA));
 		LogNTr("/slow - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETTONORMALSPEEDMODE));
+		LogNTr("/seek [x] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SEEKTOFRAMEXOFTHEREPLAY));
 		LogNTr("/chart - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_DISPLAYNETWORKSTATISTICS));
+		LogNTr("/profile [file] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_PROFILESCRIPTS));
 		LogNTr("/nodebug - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_PREVENTDEBUGMODEINTHISROU));
 		LogNTr("/set comment [comment] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETANEWNETWORKCOMMENT));
 		LogNTr("/set password [password] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETANEWNETWORKPASSWORD));
@@ -608,6 +610,13 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		Game.FrameSkip = 1;
 		return true;
 	}
+	// seek in replay
+	if (SEqual(szCmdName, "seek"))
+	{
+		if (!Game.IsRunning || !Game.Control.isReplay()) return false;
+		if (!*pCmdPar) return false;
+		return Game.Control.SeekReplay(atoi(pCmdPar));
+	}
 
 	if (SEqual(szCmdName, "nodebug"))
 	{
@@ -698,6 +707,16 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 	if (Game.IsRunning) if (SEqual(szCmdName, "chart"))
 		return Game.ToggleChart();
 
+	// script profiler
+	if (Game.IsRunning) if (SEqual(szCmdName, "profile"))
+	{
+		if (!C4AulProfiler::IsProfiling())
+			C4AulProfiler::StartProfiling(&Game.ScriptEngine);
+		else
+			C4AulProfiler::StopProfiling(*pCmdPar ? pCmdPar : Config.AtUserPath(C4CFN_ScriptProfile));
+		return true;
+	}
+
 	// custom command
 	if (Game.IsRunning && GetCommand(szCmdName))
 	{
@@ -113,6 +113,14 @@ bool C4Object::Contact(int32_t iCNAT)
 {
 	if (Def->ContactFunctionCalls)
 	{
+		switch (iCNAT)
+		{
+		case CNAT_Left:   return static_cast<bool>(Call(PSFSlot_ContactLeft));
+		case CNAT_Right:  return static_cast<bool>(Call(PSFSlot_ContactRight));
+		case CNAT_Top:    return static_cast<bool>(Call(PSFSlot_ContactTop));
+		case CNAT_Bottom: return static_cast<bool>(Call(PSFSlot_ContactBottom));
+		case CNAT_Center: return static_cast<bool>(Call(PSFSlot_ContactCenter));
+		}
 		return static_cast<bool>(Call(std::format(PSF_Contact, CNATName(iCNAT)).c_str()));
 	}
 	return false;
@@ -125,6 +133,18 @@ void C4Object::DoMotion(int32_t mx, int32_t my)
 	motion_x += mx; motion_y += my;
 }
 
+void C4Object::SkipFreeMotion(int32_t tx, int32_t ty)
+{
+	// the stepwise movement checks the first step with the own SolidMask still put
+	if (pSolidMaskData && pSolidMaskData->IsPut()) return;
+	const int32_t dx = Sign(tx - x), dy = Sign(ty - y);
+	// The last free step is left to the regular contact check, so the shape
+	// and contact values end up exactly as if every step had been checked.
+	// Free steps have no further effects, because contact calls are only done on contact.
+	const int32_t iSteps = Shape.GetFreeSteps(x, y, dx, dy, Abs(tx - x) + Abs(ty - y)) - 1;
+	if (iSteps > 0) DoMotion(dx * iSteps, dy * iSteps);
+}
+
 void C4Object::TargetBounds(int32_t &ctco, int32_t limit_low, int32_t limit_hi, int32_t cnat_low, int32_t cnat_hi)
 {
 	if (ctco < limit_low)
@@ -265,6 +285,7 @@ void C4Object::DoMovement()
 		// Move to target
 		while (x != ctcox)
 		{
+			SkipFreeMotion(ctcox, y);
 			// Next step
 			ctx = x + Sign(ctcox - x);
 
@@ -292,6 +313,7 @@ void C4Object::DoMovement()
 		// Move to target
 		while (y != ctcoy)
 		{
+			SkipFreeMotion(x, ctcoy);
 			// Next step
 			cty = y + Sign(ctcoy - y);
 			if (iContact = ContactCheck(x, cty))
@@ -472,9 +494,9 @@ void C4Object::DoMovement()
 	if (fAnyContact)
 	{
 		C4AulParSet pars(C4VInt(fixtoi(oldxdir, 100)), C4VInt(fixtoi(oldydir, 100)));
-		if (old_ocf & OCF_HitSpeed1) Call(PSF_Hit,  pars);
-		if (old_ocf & OCF_HitSpeed2) Call(PSF_Hit2, pars);
-		if (old_ocf & OCF_HitSpeed3) Call(PSF_Hit3, pars);
+		if (old_ocf & OCF_HitSpeed1) Call(PSFSlot_Hit,  pars);
+		if (old_ocf & OCF_HitSpeed2) Call(PSFSlot_Hit2, pars);
+		if (old_ocf & OCF_HitSpeed3) Call(PSFSlot_Hit3, pars);
 	}
 
 	// Rotation gfx
@@ -602,8 +624,8 @@ bool C4Object::ExecMovement() // Every Tick1 by Execute
 			{
 				fRemove = false;
 				if (x > GBackWdt || y > GBackHgt) fRemove = true; // except if they are really out of the viewport to the right...
-				else if (x < 0 && Local[0].Data) fRemove = true; // ...or it's not HUD horizontally and it's out to the left
-				else if (!Local[0].Data && x < -GBackWdt) fRemove = true; // ...or it's HUD horizontally and it's out to the left
+				else if (x < 0 && Local[0]._getRaw()) fRemove = true; // ...or it's not HUD horizontally and it's out to the left
+				else if (!Local[0]._getRaw() && x < -GBackWdt) fRemove = true; // ...or it's HUD horizontally and it's out to the left
 			}
 			if (fRemove)
 			{
@@ -68,6 +68,8 @@
 #endif
 
 #include <algorithm>
+#include <array>
+#include <limits>
 #include <cinttypes>
 #include <functional>
 #include <utility>
@@ -443,15 +445,66 @@ C4NetIOPacket::C4NetIOPacket(const void *pnData, size_t inSize, bool fCopy, cons
 C4NetIOPacket::C4NetIOPacket(const StdBuf &Buf, const C4NetIO::addr_t &naddr)
 	: StdBuf(Buf), addr(naddr) {}
 
+C4NetIOPacket::C4NetIOPacket(const StdSharedBuf &Buf, const C4NetIO::addr_t &naddr)
+	: StdBuf(Buf.getRef()), addr(naddr), Shared(Buf) {}
+
+C4NetIOPacket::C4NetIOPacket(const C4NetIOPacket &Pkt2)
+	: StdBuf(Pkt2, !Pkt2.isShared()), addr(Pkt2.addr), Shared(Pkt2.Shared) {}
+
+// references are still copied, so the moved packet never depends on data it doesn't own
+C4NetIOPacket::C4NetIOPacket(C4NetIOPacket &&Pkt2)
+	: StdBuf(std::move(Pkt2), Pkt2.isRef() && !Pkt2.isShared()), addr(Pkt2.addr), Shared(std::move(Pkt2.Shared))
+{
+	if (isShared()) Pkt2.StdBuf::Clear();
+}
+
+C4NetIOPacket &C4NetIOPacket::operator=(const C4NetIOPacket &Pkt2)
+{
+	if (this == &Pkt2) return *this;
+	if (Pkt2.isShared())
+		Ref(Pkt2);
+	else
+		Copy(Pkt2);
+	addr = Pkt2.addr;
+	Shared = Pkt2.Shared;
+	return *this;
+}
+
+C4NetIOPacket &C4NetIOPacket::operator=(C4NetIOPacket &&Pkt2)
+{
+	if (this == &Pkt2) return *this;
+	if (Pkt2.isRef() && !Pkt2.isShared())
+		Copy(Pkt2);
+	else
+		StdBuf::operator=(std::move(Pkt2));
+	addr = Pkt2.addr;
+	Shared = std::move(Pkt2.Shared);
+	if (isShared()) Pkt2.StdBuf::Clear();
+	return *this;
+}
+
 C4NetIOPacket::~C4NetIOPacket()
 {
 	Clear();
 }
 
+C4NetIOPacket C4NetIOPacket::Share() const &
+{
+	if (isShared()) return *this;
+	return C4NetIOPacket(StdSharedBuf(static_cast<const StdBuf &>(*this)), addr);
+}
+
+C4NetIOPacket C4NetIOPacket::Share() &&
+{
+	if (isShared()) return std::move(*this);
+	return C4NetIOPacket(StdSharedBuf(static_cast<StdBuf &&>(*this)), addr);
+}
+
 void C4NetIOPacket::Clear()
 {
 	addr = C4NetIO::addr_t();
 	StdBuf::Clear();
+	Shared.Clear();
 }
 
 // *** C4NetIOTCP
@@ -506,6 +559,8 @@ bool C4NetIOTCP::Init(uint16_t iPort)
 		if (!Listen(iPort))
 			return false;
 
+	FDsChanged();
+
 	// ok
 	fInit = true;
 	return true;
@@ -556,8 +611,11 @@ bool C4NetIOTCP::Close()
 	// close pipe
 	close(Pipe[0]);
 	close(Pipe[1]);
+	Pipe[0] = Pipe[1] = -1;
 #endif
 
+	FDsChanged();
+
 	// ok
 	fInit = false;
 	return true;
@@ -661,6 +719,7 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 			{
 				// remove from list
 				SOCKET sock = pWait->sock; pWait->sock = INVALID_SOCKET;
+				FDsChanged();
 
 #ifdef _WIN32
 				// error?
@@ -763,8 +822,12 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 			// socket has become writeable?
 			if (it != std::ranges::end(fds) && it->revents & POLLOUT)
 #endif
+			{
 				// send remaining data
 				pPeer->Send();
+				// no need to wait for the socket any more?
+				if (!pPeer->hasWaitingData()) FDsChanged();
+			}
 
 #ifdef _WIN32
 			// socket was closed?
@@ -906,6 +969,7 @@ bool C4NetIOTCP::Close(const addr_t &addr) // (mt-safe)
 	{
 		// close socket, do callback
 		closesocket(pWait->sock); pWait->sock = INVALID_SOCKET;
+		FDsChanged();
 		if (pCB) pCB->OnDisconn(pWait->addr, this, "closed");
 	}
 	else
@@ -953,11 +1017,11 @@ bool C4NetIOTCP::SetBroadcast(const addr_t &addr, bool fSet) // (mt-safe)
 bool C4NetIOTCP::Broadcast(const C4NetIOPacket &rPacket) // (mt-safe)
 {
 	CStdShareLock PeerListLock(&PeerListCSec);
-	// just send to all clients
+	// just send to all clients (the packet is written into every output buffer directly)
 	bool fSuccess = true;
 	for (Peer *pPeer = pPeerList; pPeer; pPeer = pPeer->Next)
 		if (pPeer->Open() && pPeer->doBroadcast())
-			fSuccess &= Send(C4NetIOPacket(rPacket.getRef(), pPeer->GetAddr()));
+			fSuccess &= pPeer->Send(rPacket);
 	return fSuccess;
 }
 
@@ -1011,6 +1075,11 @@ void C4NetIOTCP::GetFDs(std::vector<pollfd> &fds)
 		}
 }
 
+int C4NetIOTCP::GetFDsRevision() // (mt-safe)
+{
+	return iFDsRevision.load(std::memory_order_acquire) & std::numeric_limits<int>::max();
+}
+
 #endif
 
 int C4NetIOTCP::GetTimeout() // (mt-safe)
@@ -1127,6 +1196,7 @@ C4NetIOTCP::Peer *C4NetIOTCP::Accept(SOCKET nsock, const addr_t &ConnectAddr) //
 	// add to list
 	pnPeer->Next = pPeerList;
 	pPeerList = pnPeer;
+	FDsChanged();
 
 	// clear add-lock
 	PeerListAddLock.Clear();
@@ -1148,6 +1218,7 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 		// close existing socket
 		closesocket(lsock);
 		lsock = INVALID_SOCKET;
+		FDsChanged();
 	}
 	iListenPort = addr_t::IPPORT_NONE;
 
@@ -1195,6 +1266,7 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 
 	// ok
 	iListenPort = inListenPort;
+	FDsChanged();
 	return true;
 }
 
@@ -1265,6 +1337,7 @@ void C4NetIOTCP::AddConnectWait(SOCKET sock, const addr_t &addr) // (mt-safe)
 	pnWait->sock = sock; pnWait->addr = addr;
 	pnWait->Next = pConnectWaits;
 	pConnectWaits = pnWait;
+	FDsChanged();
 #ifndef _WIN32
 	// unblock, so new FD can be realized
 	UnBlock();
@@ -1289,6 +1362,7 @@ void C4NetIOTCP::ClearConnectWaits() // (mt-safe)
 		{
 			closesocket(pWait->sock);
 			pWait->sock = INVALID_SOCKET;
+			FDsChanged();
 		}
 }
 
@@ -1358,14 +1432,26 @@ bool C4NetIOTCP::Peer::Send(const C4NetIOPacket &rPacket) // (mt-safe)
 	CStdLock OLock(&OCSec);
 
 	// already data pending to be sent? try to sent them first (empty buffer)
-	if (!OBuf.isNull()) Send();
+	const bool fPending = !OBuf.isNull();
+	if (fPending) Send();
 	bool fSend = OBuf.isNull();
 
 	// pack packet
 	pParent->PackPacket(rPacket, OBuf);
 
 	// (try to) send
-	return fSend ? Send() : true;
+	const bool fSuccess = fSend ? Send() : true;
+
+#ifndef _WIN32
+	// socket has to be watched for becoming writeable now, or not any more?
+	if (fPending == OBuf.isNull())
+	{
+		pParent->FDsChanged();
+		pParent->UnBlock();
+	}
+#endif
+
+	return fSuccess;
 }
 
 bool C4NetIOTCP::Peer::Send() // (mt-safe)
@@ -1473,6 +1559,7 @@ void C4NetIOTCP::Peer::Close() // (mt-safe)
 	// close socket
 	closesocket(sock);
 	sock = INVALID_SOCKET;
+	pParent->FDsChanged();
 	// set flag
 	fOpen = false;
 	// clear buffers
@@ -1495,6 +1582,11 @@ C4NetIOSimpleUDP::C4NetIOSimpleUDP()
 #ifdef _WIN32
 	, hEvent(nullptr)
 #endif
+#ifdef __linux__
+	, fBatchIO(true)
+#else
+	, fBatchIO(false)
+#endif
 {}
 
 C4NetIOSimpleUDP::~C4NetIOSimpleUDP()
@@ -1581,6 +1673,8 @@ bool C4NetIOSimpleUDP::Init(uint16_t inPort)
 		return false;
 	}
 
+	++iFDsRevision;
+
 #endif
 
 	// set flags
@@ -1679,6 +1773,9 @@ bool C4NetIOSimpleUDP::Close()
 	// close pipes
 	close(Pipe[0]);
 	close(Pipe[1]);
+	Pipe[0] = Pipe[1] = -1;
+
+	++iFDsRevision;
 #endif
 
 	// ok
@@ -1709,6 +1806,12 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime)
 	if (!fInit) { SetError("not yet initialized"); return false; }
 	ResetError();
 
+#ifdef __linux__
+	// don't keep queued datagrams waiting (an answer might be expected)
+	if (IsSendBatching() && !SendBatchPackets.empty() && !FlushSendBatch())
+		return false;
+#endif
+
 	// wait for socket / timeout
 	WaitResult eWR = WaitForSocket(iMaxTime);
 	if (eWR == WR_Error) return false;
@@ -1717,6 +1820,17 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime)
 	if (eWR == WR_Cancelled || eWR == WR_Timeout) return true;
 	assert(eWR == WR_Readable);
 
+#ifdef __linux__
+	// read packets in batches; the loop below takes over if that isn't possible
+	if (fBatchIO)
+		switch (ReceiveBatch())
+		{
+		case BR_Done: return true;
+		case BR_Error: return false;
+		case BR_Fallback: break;
+		}
+#endif
+
 	// read packets from socket
 	for (;;)
 	{
@@ -1782,6 +1896,30 @@ bool C4NetIOSimpleUDP::Send(const C4NetIOPacket &rPacket)
 {
 	if (!fInit) { SetError("not yet initialized"); return false; }
 
+#ifdef __linux__
+	if (IsSendBatching())
+		return Send(C4NetIOPacket(rPacket));
+#endif
+	return SendDatagram(rPacket);
+}
+
+bool C4NetIOSimpleUDP::Send(C4NetIOPacket &&packet)
+{
+	if (!fInit) { SetError("not yet initialized"); return false; }
+
+#ifdef __linux__
+	// queue it
+	if (IsSendBatching())
+	{
+		SendBatchPackets.emplace_back(std::move(packet));
+		return SendBatchPackets.size() < SendBatchSize || FlushSendBatch();
+	}
+#endif
+	return SendDatagram(packet);
+}
+
+bool C4NetIOSimpleUDP::SendDatagram(const C4NetIOPacket &rPacket)
+{
 	// send it
 	C4NetIO::addr_t addr = rPacket.getAddr();
 	if (::sendto(sock, rPacket.getPtr<char>(), rPacket.getSize(), 0,
@@ -1804,6 +1942,169 @@ bool C4NetIOSimpleUDP::Broadcast(const C4NetIOPacket &rPacket)
 	return C4NetIOSimpleUDP::Send(C4NetIOPacket(rPacket.getRef(), MCAddr));
 }
 
+void C4NetIOSimpleUDP::SetBatchIO(bool fEnable)
+{
+#ifdef __linux__
+	fBatchIO = fEnable;
+#endif
+}
+
+C4NetIOSimpleUDP::SendBatch::SendBatch(C4NetIOSimpleUDP &udp)
+	: udp{nullptr}
+{
+#ifdef __linux__
+	if (udp.BeginSendBatch())
+		this->udp = &udp;
+#endif
+}
+
+C4NetIOSimpleUDP::SendBatch::~SendBatch()
+{
+#ifdef __linux__
+	if (udp)
+		udp->EndSendBatch();
+#endif
+}
+
+#ifdef __linux__
+
+C4NetIOSimpleUDP::BatchResult C4NetIOSimpleUDP::ReceiveBatch()
+{
+	// big enough for any datagram, so nothing gets truncated
+	if (RecvBatchBuf.isNull())
+		RecvBatchBuf.New(RecvBatchSize * MaxDatagramSize);
+
+	std::array<addr_t, RecvBatchSize> SrcAddrs;
+	std::array<iovec, RecvBatchSize> IOVecs;
+	std::array<mmsghdr, RecvBatchSize> Msgs;
+	for (;;)
+	{
+		for (size_t i = 0; i < RecvBatchSize; i++)
+		{
+			IOVecs[i] = {RecvBatchBuf.getMPtr(i * MaxDatagramSize), MaxDatagramSize};
+			Msgs[i] = {};
+			Msgs[i].msg_hdr.msg_name = static_cast<sockaddr *>(&SrcAddrs[i]);
+			Msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in6);
+			Msgs[i].msg_hdr.msg_iov = &IOVecs[i];
+			Msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		const int iMsgCnt = ::recvmmsg(sock, Msgs.data(), RecvBatchSize, MSG_DONTWAIT, nullptr);
+		if (iMsgCnt == SOCKET_ERROR)
+		{
+			// socket drained?
+			if (HaveWouldBlockError())
+				return BR_Done;
+			// not supported by the kernel
+			if (errno == ENOSYS)
+			{
+				fBatchIO = false;
+				return BR_Fallback;
+			}
+			// the per-packet path handles the notification
+			if (HaveConnResetError())
+				return BR_Fallback;
+			SetError("could not receive data from socket", true);
+			return BR_Error;
+		}
+
+		for (int i = 0; i < iMsgCnt; i++)
+		{
+			const socklen_t iSrcAddrLen{Msgs[i].msg_hdr.msg_namelen};
+			// invalid address?
+			if ((iSrcAddrLen != sizeof(sockaddr_in) && iSrcAddrLen != sizeof(sockaddr_in6)) || SrcAddrs[i].GetFamily() == addr_t::UnknownFamily)
+			{
+				SetError("recvmmsg returned an invalid address");
+				return BR_Error;
+			}
+			// empty datagram? ignore
+			if (!Msgs[i].msg_len)
+				continue;
+			// callback (the packet only references the buffer)
+			const C4NetIOPacket Pkt(RecvBatchBuf.getPtr(i * MaxDatagramSize), Msgs[i].msg_len, false, SrcAddrs[i]);
+			if (pCB) pCB->OnPacket(Pkt, this);
+		}
+
+		// partial batch: nothing left
+		if (static_cast<size_t>(iMsgCnt) < RecvBatchSize)
+			return BR_Done;
+	}
+}
+
+bool C4NetIOSimpleUDP::BeginSendBatch()
+{
+	if (!fBatchIO) return false;
+	const std::thread::id self{std::this_thread::get_id()};
+	std::thread::id none;
+	// first batch or nested batch of the same thread?
+	if (!SendBatchThread.compare_exchange_strong(none, self) && none != self)
+		return false;
+	iSendBatchDepth++;
+	return true;
+}
+
+void C4NetIOSimpleUDP::EndSendBatch()
+{
+	assert(IsSendBatching());
+	if (--iSendBatchDepth) return;
+	FlushSendBatch();
+	SendBatchThread.store(std::thread::id{});
+}
+
+bool C4NetIOSimpleUDP::FlushSendBatch()
+{
+	bool fSuccess = true;
+	std::array<addr_t, SendBatchSize> DstAddrs;
+	std::array<iovec, SendBatchSize> IOVecs;
+	std::array<mmsghdr, SendBatchSize> Msgs;
+	for (size_t iStart = 0; iStart < SendBatchPackets.size(); )
+	{
+		// not supported by the kernel? send the rest one by one
+		if (!fBatchIO)
+		{
+			for (size_t i = iStart; i < SendBatchPackets.size(); i++)
+				fSuccess &= SendDatagram(SendBatchPackets[i]);
+			break;
+		}
+
+		const size_t iMsgCnt{std::min(SendBatchSize, SendBatchPackets.size() - iStart)};
+		for (size_t i = 0; i < iMsgCnt; i++)
+		{
+			const C4NetIOPacket &Pkt{SendBatchPackets[iStart + i]};
+			DstAddrs[i] = Pkt.getAddr();
+			IOVecs[i] = {const_cast<void *>(Pkt.getData()), Pkt.getSize()};
+			Msgs[i] = {};
+			Msgs[i].msg_hdr.msg_name = static_cast<sockaddr *>(&DstAddrs[i]);
+			Msgs[i].msg_hdr.msg_namelen = DstAddrs[i].GetAddrLen();
+			Msgs[i].msg_hdr.msg_iov = &IOVecs[i];
+			Msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		const int iSent = ::sendmmsg(sock, Msgs.data(), iMsgCnt, 0);
+		if (iSent == SOCKET_ERROR)
+		{
+			if (errno == ENOSYS)
+			{
+				fBatchIO = false;
+				continue;
+			}
+			if (!HaveWouldBlockError())
+			{
+				SetError("socket sendmmsg failed", true);
+				fSuccess = false;
+			}
+			// skip the datagram that failed, like the per-datagram path does
+			iStart++;
+			continue;
+		}
+		iStart += iSent;
+	}
+	SendBatchPackets.clear();
+	return fSuccess;
+}
+
+#endif
+
 #ifdef _WIN32
 
 void C4NetIOSimpleUDP::UnBlock() // (mt-safe)
@@ -1863,6 +2164,11 @@ void C4NetIOSimpleUDP::GetFDs(std::vector<pollfd> &fds)
 	}
 }
 
+int C4NetIOSimpleUDP::GetFDsRevision()
+{
+	return iFDsRevision.load(std::memory_order_acquire) & std::numeric_limits<int>::max();
+}
+
 enum C4NetIOSimpleUDP::WaitResult C4NetIOSimpleUDP::WaitForSocket(int iTimeout)
 {
 	std::vector<pollfd> fds;
@@ -2301,6 +2607,9 @@ bool C4NetIOUDP::Execute(int iMaxTime) // (mt-safe)
 
 	ResetError();
 
+	// answers, checks and resends are sent together at the end
+	const SendBatch Batch{*this};
+
 	// adjust maximum block time
 	int iMaxBlock = GetTimeout();
 	if (iMaxTime == TO_INF || iMaxTime > iMaxBlock) iMaxTime = iMaxBlock;
@@ -2360,6 +2669,8 @@ bool C4NetIOUDP::Send(const C4NetIOPacket &rPacket) // (mt-safe)
 bool C4NetIOUDP::Broadcast(const C4NetIOPacket &rPacket) // (mt-safe)
 {
 	CStdShareLock PeerListLock(&PeerListCSec);
+	// all peers queue the same data
+	const C4NetIOPacket SharedPacket{rPacket.Share()};
 	// search: any client reachable via multicast?
 	Peer *pPeer;
 	for (pPeer = pPeerList; pPeer; pPeer = pPeer->Next)
@@ -2370,7 +2681,7 @@ bool C4NetIOUDP::Broadcast(const C4NetIOPacket &rPacket) // (mt-safe)
 	{
 		CStdLock OutLock(&OutCSec);
 		// send it via multicast: encapsulate packet
-		Packet *pPkt = new Packet(rPacket.Duplicate(), iOPacketCounter);
+		Packet *pPkt = new Packet(C4NetIOPacket(SharedPacket), iOPacketCounter);
 		iOPacketCounter += pPkt->FragmentCnt();
 		// add to list
 		OPackets.AddPacket(pPkt);
@@ -2380,7 +2691,7 @@ bool C4NetIOUDP::Broadcast(const C4NetIOPacket &rPacket) // (mt-safe)
 	// send to all clients connected via du, too
 	for (pPeer = pPeerList; pPeer; pPeer = pPeer->Next)
 		if (pPeer->Open() && !pPeer->MultiCast() && pPeer->doBroadcast())
-			pPeer->Send(rPacket);
+			pPeer->Send(SharedPacket);
 	return true;
 }
 
@@ -2545,7 +2856,7 @@ C4NetIOUDP::Packet::Packet()
 
 C4NetIOUDP::Packet::Packet(C4NetIOPacket &&rnData, nr_t inNr)
 	: iNr(inNr),
-	Data(rnData),
+	Data(std::move(rnData)),
 	pFragmentGot(nullptr) {}
 
 C4NetIOUDP::Packet::~Packet()
@@ -2802,8 +3113,8 @@ bool C4NetIOUDP::Peer::Connect(bool fFailCallback) // (mt-safe)
 bool C4NetIOUDP::Peer::Send(const C4NetIOPacket &rPacket) // (mt-safe)
 {
 	CStdLock OutLock(&OutCSec);
-	// encapsulate packet
-	Packet *pnPacket = new Packet(rPacket.Duplicate(), iOPacketCounter);
+	// encapsulate packet (shared packets aren't copied)
+	Packet *pnPacket = new Packet(C4NetIOPacket(rPacket), iOPacketCounter);
 	iOPacketCounter += pnPacket->FragmentCnt();
 	pnPacket->GetData().SetAddr(addr);
 	// add it to outgoing packet stack
@@ -3140,6 +3451,7 @@ bool C4NetIOUDP::Peer::SendDirect(const Packet &rPacket, unsigned int iNr)
 	if (iNr + 1)
 		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr()));
 	// otherwise: send all fragments
+	const SendBatch Batch{*pParent};
 	bool fSuccess = true;
 	for (unsigned int i = 0; i < rPacket.FragmentCnt(); i++)
 		fSuccess &= SendDirect(rPacket.GetFragment(i));
@@ -3265,6 +3577,7 @@ bool C4NetIOUDP::BroadcastDirect(const Packet &rPacket, unsigned int iNr) // (mt
 	if (iNr + 1)
 		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr(), true));
 	// send all fragments
+	const SendBatch Batch{*this};
 	bool fSuccess = true;
 	for (unsigned int iFrgm = 0; iFrgm < rPacket.FragmentCnt(); iFrgm++)
 		fSuccess &= SendDirect(rPacket.GetFragment(iFrgm, true));
@@ -3295,7 +3608,8 @@ bool C4NetIOUDP::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
 #endif
 
 	// send it
-	return C4NetIOSimpleUDP::Send(C4NetIOPacket(rPacket.getRef(), toaddr));
+	rPacket.SetAddr(toaddr);
+	return C4NetIOSimpleUDP::Send(std::move(rPacket));
 }
 
 bool C4NetIOUDP::DoLoopbackTest()
@@ -26,7 +26,9 @@
 #include "StdCompiler.h"
 #include "StdScheduler.h"
 
+#include <atomic>
 #include <memory>
+#include <thread>
 #include <vector>
 
 
@@ -137,12 +139,22 @@ public:
 	C4NetIOPacket(const void *pnData, size_t inSize, bool fCopy = false, const C4NetIO::addr_t &naddr = C4NetIO::addr_t());
 	// construct from buffer (takes data, if possible)
 	explicit C4NetIOPacket(const StdBuf &Buf, const C4NetIO::addr_t &naddr = C4NetIO::addr_t());
+	// construct from shared buffer (references data)
+	explicit C4NetIOPacket(const StdSharedBuf &Buf, const C4NetIO::addr_t &naddr = C4NetIO::addr_t());
+
+	// copies are as cheap as references for shared packets and duplicate the data otherwise
+	C4NetIOPacket(const C4NetIOPacket &Pkt2);
+	C4NetIOPacket(C4NetIOPacket &&Pkt2);
+	C4NetIOPacket &operator=(const C4NetIOPacket &Pkt2);
+	C4NetIOPacket &operator=(C4NetIOPacket &&Pkt2);
 
 	~C4NetIOPacket();
 
 protected:
 	// address
 	C4NetIO::addr_t addr;
+	// owner of the data if the packet is shared
+	StdSharedBuf Shared;
 
 public:
 	const C4NetIO::addr_t &getAddr() const { return addr; }
@@ -155,6 +167,10 @@ public:
 	// Some overloads
 	C4NetIOPacket getRef()    const { return C4NetIOPacket(StdBuf::getRef(), addr); }
 	C4NetIOPacket Duplicate() const { return C4NetIOPacket(StdBuf::Duplicate(), addr); }
+	// returns a packet sharing its data with all of its copies (copies the data once unless this packet is shared already)
+	C4NetIOPacket Share() const &;
+	C4NetIOPacket Share() &&; // takes the data if possible
+	bool isShared() const { return !Shared.isNull(); }
 	// change addr
 	void SetAddr(const C4NetIO::addr_t &naddr) { addr = naddr; }
 
@@ -207,6 +223,7 @@ public:
 	virtual HANDLE GetEvent() override;
 #else
 	virtual void GetFDs(std::vector<pollfd> &fds) override;
+	virtual int GetFDsRevision() override;
 #endif
 	virtual int GetTimeout() override;
 
@@ -318,9 +335,13 @@ protected:
 	HANDLE Event;
 #else
 	// Pipe used for cancelling select
-	int Pipe[2];
+	int Pipe[2]{-1, -1};
 #endif
 
+	// changed whenever sockets are opened or closed or have their events changed (see GetFDsRevision)
+	std::atomic<int> iFDsRevision{0};
+	void FDsChanged() { iFDsRevision.fetch_add(1, std::memory_order_release); }
+
 	// *** implementation
 
 	bool Listen(uint16_t inListenPort);
@@ -363,6 +384,7 @@ public:
 	virtual bool Execute(int iMaxTime = TO_INF) override;
 
 	virtual bool Send(const C4NetIOPacket &rPacket) override;
+	bool Send(C4NetIOPacket &&packet); // doesn't copy the packet if it gets queued
 	virtual bool Broadcast(const C4NetIOPacket &rPacket) override;
 
 	virtual void UnBlock();
@@ -370,9 +392,30 @@ public:
 	virtual HANDLE GetEvent() override;
 #else
 	virtual void GetFDs(std::vector<pollfd> &fds) override;
+	virtual int GetFDsRevision() override;
 #endif
 	virtual int GetTimeout() override;
 
+	// batched socket i/o (recvmmsg / sendmmsg; linux only, one syscall per datagram otherwise)
+	void SetBatchIO(bool fEnable);
+	bool isBatchIO() const { return fBatchIO; }
+
+	// While a send batch exists, datagrams sent by the thread that created it are queued
+	// and sent together when the outermost batch of that thread is destroyed.
+	// Batches of other threads are ignored meanwhile.
+	class SendBatch
+	{
+	public:
+		SendBatch(C4NetIOSimpleUDP &udp);
+		~SendBatch();
+
+		SendBatch(const SendBatch &) = delete;
+		SendBatch &operator=(const SendBatch &) = delete;
+
+	private:
+		C4NetIOSimpleUDP *udp; // nullptr if this batch is ignored
+	};
+
 	// not implemented
 	virtual bool Connect(const addr_t &addr) override { assert(false); return false; }
 	virtual bool Close(const addr_t &addr) override { assert(false); return false; }
@@ -399,7 +442,8 @@ private:
 #ifdef _WIN32
 	HANDLE hEvent;
 #else
-	int Pipe[2];
+	int Pipe[2]{-1, -1};
+	std::atomic<int> iFDsRevision{0};
 #endif
 
 	// multicast
@@ -409,6 +453,17 @@ private:
 	// multibind
 	int fAllowReUse;
 
+	// batched i/o
+	bool fBatchIO;
+#ifdef __linux__
+	static constexpr size_t RecvBatchSize = 16, SendBatchSize = 64;
+	static constexpr size_t MaxDatagramSize = 65536;
+	StdBuf RecvBatchBuf; // received packets reference this buffer
+	std::atomic<std::thread::id> SendBatchThread;
+	int iSendBatchDepth{0};
+	std::vector<C4NetIOPacket> SendBatchPackets; // only used by SendBatchThread
+#endif
+
 protected:
 	// multicast address
 	const addr_t &getMCAddr() const { return MCAddr; }
@@ -425,6 +480,17 @@ private:
 	enum WaitResult { WR_Timeout, WR_Readable, WR_Cancelled, WR_Error = -1, };
 	WaitResult WaitForSocket(int iTimeout);
 
+	bool SendDatagram(const C4NetIOPacket &rPacket);
+
+#ifdef __linux__
+	enum BatchResult { BR_Done, BR_Fallback, BR_Error };
+	BatchResult ReceiveBatch();
+	bool BeginSendBatch();
+	void EndSendBatch();
+	bool IsSendBatching() const { return SendBatchThread.load(std::memory_order_relaxed) == std::this_thread::get_id(); }
+	bool FlushSendBatch();
+#endif
+
 	// *** callbacks
 public:
 	virtual void SetCallback(CBClass *pnCallback) override { pCB = pnCallback; }
@@ -394,10 +394,12 @@ bool C4Network2IO::Broadcast(const C4NetIOPacket &rPkt)
 {
 	bool fSuccess = true;
 	// There is no broadcasting atm, emulate it
+	// All connections queue and log the same data, so it's only copied once
+	const C4NetIOPacket SharedPkt{rPkt.Share()};
 	CStdLock ConnListLock(&ConnListCSec);
 	for (C4Network2IOConnection *pConn = pConnList; pConn; pConn = pConn->pNext)
 		if (pConn->isOpen() && pConn->isBroadcastTarget())
-			fSuccess &= pConn->Send(rPkt);
+			fSuccess &= pConn->Send(SharedPkt);
 	assert(fSuccess);
 	return fSuccess;
 }
@@ -547,6 +547,8 @@ bool C4Network2Res::SetDerived(const char *strName, const char *strFilePath, boo
 
 void C4Network2Res::ChangeID(int32_t inID)
 {
+	// cached chunks contain the old ID
+	if (pParent) pParent->ChunkCache.Remove(this);
 	Core.SetID(inID);
 }
 
@@ -854,12 +856,19 @@ bool C4Network2Res::SendChunk(uint32_t iChunk, int32_t iToClient)
 	if (!pConn) return false;
 	// save last request time
 	iLastReqTime = time(nullptr);
-	// create packet
-	CStdLock FileLock(&FileCSec);
-	C4Network2ResChunk ResChunk;
-	ResChunk.Set(this, iChunk);
+	// packed recently? (the packet is shared, not copied)
+	C4NetIOPacket Pkt = pParent->ChunkCache.Get(this, iChunk);
+	if (Pkt.isNull())
+	{
+		// create packet
+		CStdLock FileLock(&FileCSec);
+		C4Network2ResChunk ResChunk;
+		const bool fChunkSet = ResChunk.Set(this, iChunk);
+		Pkt = MkC4NetIOPacket(PID_NetResData, ResChunk).Share();
+		if (fChunkSet) pParent->ChunkCache.Add(this, iChunk, Pkt);
+	}
 	// send
-	bool fSuccess = pConn->Send(MkC4NetIOPacket(PID_NetResData, ResChunk));
+	bool fSuccess = pConn->Send(Pkt);
 	pConn->DelRef();
 	return fSuccess;
 }
@@ -983,6 +992,7 @@ bool C4Network2Res::NeedsDiscover()
 void C4Network2Res::Clear()
 {
 	CStdLock FileLock(&FileCSec);
+	if (pParent) pParent->ChunkCache.Remove(this);
 	// delete files
 	if (fTempFile)
 		if (FileExists(szFile))
@@ -1327,6 +1337,45 @@ void C4Network2ResChunk::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(Data, "Data"));
 }
 
+// *** C4Network2ResChunkCache
+
+C4NetIOPacket C4Network2ResChunkCache::Get(const C4Network2Res *pRes, uint32_t iChunk)
+{
+	CStdLock CacheLock(&CacheCSec);
+	const auto it = std::find_if(Entries.begin(), Entries.end(), [pRes, iChunk](const Entry &entry) { return entry.pRes == pRes && entry.iChunk == iChunk; });
+	if (it == Entries.end())
+	{
+		++iMissCnt;
+		return C4NetIOPacket();
+	}
+	++iHitCnt;
+	// move to front
+	Entries.splice(Entries.begin(), Entries, it);
+	return it->Pkt;
+}
+
+void C4Network2ResChunkCache::Add(const C4Network2Res *pRes, uint32_t iChunk, const C4NetIOPacket &Pkt)
+{
+	CStdLock CacheLock(&CacheCSec);
+	Entries.push_front({pRes, iChunk, Pkt.Share()});
+	// drop least recently used
+	while (Entries.size() > C4NetResChunkCacheSize)
+		Entries.pop_back();
+}
+
+void C4Network2ResChunkCache::Remove(const C4Network2Res *pRes)
+{
+	CStdLock CacheLock(&CacheCSec);
+	Entries.remove_if([pRes](const Entry &entry) { return entry.pRes == pRes; });
+}
+
+void C4Network2ResChunkCache::Clear()
+{
+	CStdLock CacheLock(&CacheCSec);
+	Entries.clear();
+	iHitCnt = iMissCnt = 0;
+}
+
 // *** C4Network2ResList
 
 C4Network2ResList::C4Network2ResList()
@@ -1532,6 +1581,7 @@ void C4Network2ResList::Clear()
 		pRes->Remove();
 		pRes->iLastReqTime = 0;
 	}
+	ChunkCache.Clear();
 	iClientID = C4ClientIDUnknown;
 	iLastDiscover = iLastStatus = 0;
 	logger.reset();
@@ -23,6 +23,7 @@
 #include <StdSync.h>
 
 #include <atomic>
+#include <list>
 
 const uint32_t C4NetResChunkSize = 100U * 1024U;
 
@@ -33,7 +34,8 @@ const int32_t C4NetResDiscoverTimeout = 10, // (s)
               C4NetResMaxLoad = 20,
               C4NetResLoadTimeout = 60, // (s)
               C4NetResDeleteTime = 60, // (s)
-              C4NetResMaxBigicon = 20; // maximum size, in KB, of bigicon
+              C4NetResMaxBigicon = 20, // maximum size, in KB, of bigicon
+              C4NetResChunkCacheSize = 64; // packed chunks kept for further requests
 
 const int32_t C4NetResIDAnonymous = -2;
 
@@ -314,6 +316,27 @@ public:
 	virtual void CompileFunc(StdCompiler *pComp) override;
 };
 
+// LRU cache of packed chunk packets, so chunks requested by several clients
+// are only read and packed once. The packets share their data with all copies.
+class C4Network2ResChunkCache
+{
+public:
+	C4NetIOPacket Get(const C4Network2Res *pRes, uint32_t iChunk); // null packet if not cached
+	void Add(const C4Network2Res *pRes, uint32_t iChunk, const C4NetIOPacket &Pkt);
+	void Remove(const C4Network2Res *pRes);
+	void Clear();
+
+	uint32_t getHitCnt()  const { return iHitCnt; }
+	uint32_t getMissCnt() const { return iMissCnt; }
+
+private:
+	struct Entry { const C4Network2Res *pRes; uint32_t iChunk; C4NetIOPacket Pkt; };
+	std::list<Entry> Entries; // most recently used first
+	CStdCSec CacheCSec;
+
+	std::atomic<uint32_t> iHitCnt{0}, iMissCnt{0};
+};
+
 class C4Network2ResList : protected CStdCSecExCallback // run by network thread
 {
 	friend class C4Network2Res;
@@ -334,6 +357,9 @@ protected:
 	// timings
 	time_t iLastDiscover, iLastStatus;
 
+	// chunks sent recently
+	C4Network2ResChunkCache ChunkCache;
+
 	// object used for network i/o
 	C4Network2IO *pIO;
 
@@ -378,6 +404,8 @@ public:
 	// for C4Network2Res
 	C4Network2IO *getIOClass() { return pIO; }
 
+	const C4Network2ResChunkCache &getChunkCache() const { return ChunkCache; }
+
 	int32_t GetClientProgress(int32_t clientID);
 
 	const std::shared_ptr<spdlog::logger> &GetLogger() const noexcept { return logger; }
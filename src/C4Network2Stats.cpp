@@ -290,7 +290,7 @@ void C4GraphCollection::SetMultiplier(ValueType fToVal)
 		for (iterator i = begin(); i != end(); ++i)(*i)->SetMultiplier(fToVal);
 }
 
-C4Network2Stats::C4Network2Stats() : pSec1Timer(nullptr)
+C4Network2Stats::C4Network2Stats() : pSec1Timer(nullptr), iLastChunkCacheHits(0), iLastChunkCacheMisses(0)
 {
 	// set self (needed in CreateGraph-fns)
 	Game.pNetworkStatistics = this;
@@ -306,6 +306,7 @@ C4Network2Stats::C4Network2Stats() : pSec1Timer(nullptr)
 	statNetO.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_OUTPUT));
 	statNetO.SetColorDw(0xff0000);
 	graphNetIO.AddGraph(&statNetI); graphNetIO.AddGraph(&statNetO);
+	statChunkCache.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_CHUNKCACHE));
 	statControls.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_CONTROL));
 	statControls.SetAverageTime(100);
 	statActions.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_APM));
@@ -333,6 +334,11 @@ void C4Network2Stats::ExecuteSecond()
 	statFPS.RecordValue(C4Graph::ValueType(Game.FPS));
 	statNetI.RecordValue(C4Graph::ValueType(Game.Network.NetIO.getProtIRate(P_TCP) + Game.Network.NetIO.getProtIRate(P_UDP)));
 	statNetO.RecordValue(C4Graph::ValueType(Game.Network.NetIO.getProtORate(P_TCP) + Game.Network.NetIO.getProtORate(P_UDP)));
+	// chunk cache hit rate of this second
+	const C4Network2ResChunkCache &ChunkCache = Game.Network.ResList.getChunkCache();
+	const uint32_t iHits = ChunkCache.getHitCnt() - iLastChunkCacheHits, iMisses = ChunkCache.getMissCnt() - iLastChunkCacheMisses;
+	statChunkCache.RecordValue(C4Graph::ValueType(iHits + iMisses ? iHits * 100 / (iHits + iMisses) : 0));
+	iLastChunkCacheHits = ChunkCache.getHitCnt(); iLastChunkCacheMisses = ChunkCache.getMissCnt();
 	// pings for all clients
 	C4Network2Client *pClient = nullptr;
 	while (pClient = Game.Network.Clients.GetNextClient(pClient)) if (pClient->getStatPing())
@@ -374,6 +380,7 @@ C4Graph *C4Network2Stats::GetGraphByName(const StdStrBuf &rszName, bool &rfIsTem
 	if (SEqualNoCase(rszName.getData(), "oc")) return &statObjCount;
 	if (SEqualNoCase(rszName.getData(), "fps")) return &statFPS;
 	if (SEqualNoCase(rszName.getData(), "netio")) return &graphNetIO;
+	if (SEqualNoCase(rszName.getData(), "chunkcache")) return &statChunkCache;
 	if (SEqualNoCase(rszName.getData(), "pings")) return &statPings;
 	if (SEqualNoCase(rszName.getData(), "control")) return &statControls;
 	if (SEqualNoCase(rszName.getData(), "apm")) return &statActions;
@@ -179,6 +179,10 @@ private:
 	C4TableGraph statNetI, statNetO;
 	C4GraphCollection graphNetIO;
 
+	// resource chunks served from cache (percent of requests)
+	C4TableGraph statChunkCache;
+	uint32_t iLastChunkCacheHits, iLastChunkCacheMisses;
+
 protected:
 	C4GraphCollection statPings; // for all clients
 
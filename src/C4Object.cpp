@@ -29,6 +29,7 @@
 #include <C4Record.h>
 #endif
 #include <C4SolidMask.h>
+#include <C4SyncHash.h>
 #include <C4Random.h>
 #include <C4Wrappers.h>
 #include <C4Player.h>
@@ -73,6 +74,7 @@ void C4Action::GetBridgeData(int32_t &riBridgeTime, bool &rfMoveClonk, bool &rfW
 C4Object::C4Object()
 {
 	Default();
+	HandleSlot = ObjectHandles.Register(this);
 }
 
 void C4Object::Default()
@@ -143,7 +145,6 @@ void C4Object::Default()
 	pGraphics = nullptr;
 	pDrawTransform = nullptr;
 	pEffects = nullptr;
-	FirstRef = nullptr;
 	pGfxOverlay = nullptr;
 	iLastAttachMovementFrame = -1;
 }
@@ -165,7 +166,11 @@ bool C4Object::Init(C4Def *pDef, C4Object *pCreator,
 	Def = pDef;
 	Category = Def->Category;
 	Def->Count++;
-	if (pCreator) pLayer = pCreator->pLayer;
+	if (pCreator)
+	{
+		pLayer = pCreator->pLayer;
+		RegisterReference(pLayer);
+	}
 
 	// graphics
 	pGraphics = &Def->Graphics;
@@ -226,6 +231,8 @@ bool C4Object::Init(C4Def *pDef, C4Object *pCreator,
 C4Object::~C4Object()
 {
 	Clear();
+	ClearReferrers();
+	ObjectHandles.Release(HandleSlot);
 
 #ifndef NDEBUG
 	// debug: mustn't be listed in any list now
@@ -249,7 +256,7 @@ void C4Object::AssignRemoval(bool fExitContents)
 	// Destruction call in container
 	if (Contained)
 	{
-		Contained->Call(PSF_ContentsDestruction, {C4VObj(this)});
+		Contained->Call(PSFSlot_ContentsDestruction, {C4VObj(this)});
 		if (!Status) return;
 	}
 	// Destruction call
@@ -307,7 +314,7 @@ void C4Object::AssignRemoval(bool fExitContents)
 	if (Info) Info->Retire();
 	Info = nullptr;
 	// Object system operation
-	while (FirstRef) FirstRef->Set0();
+	ObjectHandles.Invalidate(HandleSlot);
 	Game.ClearPointers(this);
 	ClearCommands();
 	if (pSolidMaskData) pSolidMaskData->Remove(true, false);
@@ -341,6 +348,14 @@ void C4Object::UpdateShape(bool bUpdateVertices)
 	UpdatePos();
 }
 
+uint64_t C4Object::GetSyncHash() const
+{
+	uint64_t hash = C4SyncHash::Mix(static_cast<uint32_t>(Number));
+	for (const int32_t iValue : {fix_x.val, fix_y.val, fix_r.val, xdir.val, ydir.val, rdir.val, Action.Act, Action.Dir, Action.Phase, static_cast<int32_t>(OCF)})
+		hash = C4SyncHash::Combine(hash, static_cast<uint32_t>(iValue));
+	return hash;
+}
+
 void C4Object::UpdatePos()
 {
 	// get new area covered
@@ -913,7 +928,7 @@ bool C4Object::ExecLife()
 				// Take breath
 				int32_t takebreath = GetPhysical()->Breath - Breath;
 				if (takebreath > GetPhysical()->Breath / 2)
-					Call(PSF_DeepBreath);
+					Call(PSFSlot_DeepBreath);
 				Breath += takebreath;
 			}
 		}
@@ -1067,9 +1082,12 @@ void C4Object::Execute()
 	// Movement
 	ExecMovement();
 	if (!Status) return;
-	// particles
-	if (BackParticles) BackParticles.Exec(this);
-	if (FrontParticles) FrontParticles.Exec(this);
+	// particles; executed by the particle system after all objects otherwise
+	if (!Game.Particles.ExecutesObjectParticles())
+	{
+		if (BackParticles) BackParticles.Exec(this);
+		if (FrontParticles) FrontParticles.Exec(this);
+	}
 	// effects
 	if (pEffects)
 	{
@@ -1170,7 +1188,7 @@ void C4Object::AssignDeath(bool fForced)
 	if (!pPlr || !(Category & C4D_Living) || !pPlr->FoWViewObjs.IsContained(this))
 		SetPlrViewRange(0);
 	// Engine script call
-	Call(PSF_Death, {C4VInt(iDeathCausingPlayer)});
+	Call(PSFSlot_Death, {C4VInt(iDeathCausingPlayer)});
 	// Update OCF. Done here because previously it would have been done in the next frame
 	// Whats worse: Having the OCF change because of some unrelated script-call like
 	// SetCategory, or slightly breaking compatibility?
@@ -1200,6 +1218,7 @@ bool C4Object::ChangeDef(C4ID idNew)
 	LocalNamed.SetNameList(&pDef->Script.LocalNamed);
 	// new def: Needs to be resorted
 	Unsorted = true;
+	Game.Objects.UpdateTypeIndex(this);
 	// graphics change
 	pGraphics = &pDef->Graphics;
 	// blit mode adjustment
@@ -1285,7 +1304,7 @@ void C4Object::DoDamage(int32_t iChange, int32_t iCausedBy, int32_t iCause)
 	// Change value
 	Damage = std::max<int32_t>(Damage + iChange, 0);
 	// Engine script call
-	Call(PSF_Damage, {C4VInt(iChange), C4VInt(iCausedBy)});
+	Call(PSFSlot_Damage, {C4VInt(iChange), C4VInt(iCausedBy)});
 }
 
 // returns x * y, but returns std::numeric_limits<T>::min() or std::numeric_limits<T>::max() in case of a negative or positive overflow respectively
@@ -1479,7 +1498,7 @@ void C4Object::DoCon(int32_t iChange, bool fInitial, bool fNoComponentChange)
 	// Completion (after bottom y-adjust for correct position)
 	if (!fWasFull && (Con >= FullCon))
 	{
-		Call(PSF_Completion);
+		Call(PSFSlot_Completion);
 		Call(PSF_Initialize);
 	}
 
@@ -1530,8 +1549,8 @@ bool C4Object::Exit(int32_t iX, int32_t iY, int32_t iR, C4Fixed iXDir, C4Fixed i
 	UpdateFace(true);
 	SetOCF();
 	// Engine calls
-	if (fCalls) pContainer->Call(PSF_Ejection, {C4VObj(this)});
-	if (fCalls) Call(PSF_Departure, {C4VObj(pContainer)});
+	if (fCalls) pContainer->Call(PSFSlot_Ejection, {C4VObj(this)});
+	if (fCalls) Call(PSFSlot_Departure, {C4VObj(pContainer)});
 	// Success (if the obj wasn't "re-entered" by script)
 	return !Contained;
 }
@@ -1548,14 +1567,14 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	// No target or target is self
 	if (!pTarget || (pTarget == this)) return false;
 	// check if entrance is allowed
-	if (Call(PSF_RejectEntrance, {C4VObj(pTarget)})) return false;
+	if (Call(PSFSlot_RejectEntrance, {C4VObj(pTarget)})) return false;
 	// check if we end up in an endless container-recursion
 	for (C4Object *pCnt = pTarget->Contained; pCnt; pCnt = pCnt->Contained)
 		if (pCnt == this) return false;
 	// Check RejectCollect, if desired
 	if (pfRejectCollect)
 	{
-		if (pTarget->Call(PSF_RejectCollection, {C4VID(Def->id), C4VObj(this)}))
+		if (pTarget->Call(PSFSlot_RejectCollection, {C4VID(Def->id), C4VObj(this)}))
 		{
 			*pfRejectCollect = true;
 			return false;
@@ -1596,10 +1615,10 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	Contained->UpdateMass();
 	Contained->SetOCF();
 	// Collection call
-	if (fCalls) pTarget->Call(PSF_Collection2, {C4VObj(this)});
+	if (fCalls) pTarget->Call(PSFSlot_Collection2, {C4VObj(this)});
 	if (!Contained || !Contained->Status || !pTarget->Status) return true;
 	// Entrance call
-	if (fCalls) Call(PSF_Entrance, {C4VObj(Contained)});
+	if (fCalls) Call(PSFSlot_Entrance, {C4VObj(Contained)});
 	if (!Contained || !Contained->Status || !pTarget->Status) return true;
 	// Base auto sell contents
 	if (ValidPlr(Contained->Base))
@@ -1637,7 +1656,7 @@ bool C4Object::ActivateEntrance(int32_t by_plr, C4Object *by_obj)
 	}
 	// Try entrance activation
 	if (OCF & OCF_Entrance)
-		if (Call(PSF_ActivateEntrance, {C4VObj(by_obj)}))
+		if (Call(PSFSlot_ActivateEntrance, {C4VObj(by_obj)}))
 			return true;
 	// Failure
 	return false;
@@ -1801,7 +1820,7 @@ bool C4Object::Push(C4Fixed txdir, C4Fixed dforce, bool fStraighten)
 		if (ContactCheck(x, y)) // Resets t_contact
 		{
 			GameMsgObject(LoadResStr(C4ResStrTableKey::IDS_OBJ_STUCK, GetName()).c_str(), this);
-			Call(PSF_Stuck);
+			Call(PSFSlot_Stuck);
 		}
 
 	return true;
@@ -1831,7 +1850,7 @@ bool C4Object::Lift(C4Fixed tydir, C4Fixed dforce)
 		if (ContactCheck(x, y)) // Resets t_contact
 		{
 			GameMsgObject(LoadResStr(C4ResStrTableKey::IDS_OBJ_STUCK, GetName()).c_str(), this);
-			Call(PSF_Stuck);
+			Call(PSFSlot_Stuck);
 		}
 	return true;
 }
@@ -1869,7 +1888,12 @@ bool C4Object::ActivateMenu(int32_t iMenu, int32_t iMenuSelect,
 	// Close any other menu
 	if (Menu && Menu->IsActive()) if (!Menu->TryClose(true, false)) return false;
 	// Create menu
-	if (!Menu) Menu = new C4ObjectMenu; else Menu->ClearItems(true);
+	if (!Menu)
+	{
+		Menu = new C4ObjectMenu;
+		Game.Objects.AddMenuObject(this);
+	}
+	else Menu->ClearItems(true);
 	// Open menu
 	switch (iMenu)
 	{
@@ -1877,7 +1901,7 @@ bool C4Object::ActivateMenu(int32_t iMenu, int32_t iMenuSelect,
 		// No target specified: use own container as target
 		if (!pTarget) if (!(pTarget = Contained)) break;
 		// Opening contents menu blocked by RejectContents
-		if (pTarget->Call(PSF_RejectContents)) return false;
+		if (pTarget->Call(PSFSlot_RejectContents)) return false;
 		// Create symbol
 		fctSymbol.Create(C4SymbolSize, C4SymbolSize);
 		pTarget->Def->Draw(fctSymbol, false, pTarget->Color, pTarget);
@@ -1920,7 +1944,7 @@ bool C4Object::ActivateMenu(int32_t iMenu, int32_t iMenuSelect,
 		// No target specified
 		if (!pTarget) break;
 		// Opening contents menu blocked by RejectContents
-		if (pTarget->Call(PSF_RejectContents)) return false;
+		if (pTarget->Call(PSFSlot_RejectContents)) return false;
 		// Create symbol & init
 		fctSymbol.Create(C4SymbolSize, C4SymbolSize);
 		pTarget->Def->Draw(fctSymbol, false, pTarget->Color, pTarget);
@@ -2194,12 +2218,89 @@ void C4Object::ClearPointers(C4Object *pObj)
 	}
 }
 
+bool C4Object::HasPointers(C4Object *pObj)
+{
+	if (Action.Target == pObj || Action.Target2 == pObj || pLayer == pObj) return true;
+	for (C4Effect *pEff = pEffects; pEff; pEff = pEff->pNext)
+		if (pEff->pCommandTarget == pObj) return true;
+	for (C4Command *cCom = Command; cCom; cCom = cCom->Next)
+		if (cCom->cObj == pObj || cCom->Target == pObj || cCom->Target2 == pObj) return true;
+	for (C4GraphicsOverlay *pGfxOvrl = pGfxOverlay; pGfxOvrl; pGfxOvrl = pGfxOvrl->GetNext())
+		if (pGfxOvrl->GetOverlayObject() == pObj) return true;
+	return false;
+}
+
+void C4Object::RegisterReference(C4Object *pTarget)
+{
+	// the removed object itself is always cleared
+	if (!pTarget || pTarget == this) return;
+	if (std::ranges::find(ReferencedObjects, pTarget) != ReferencedObjects.end()) return;
+	ReferencedObjects.push_back(pTarget);
+	pTarget->Referrers.push_back(this);
+}
+
+void C4Object::ReleaseReference(C4Object *pTarget)
+{
+	if (!pTarget || HasPointers(pTarget)) return;
+	const auto it = std::ranges::find(ReferencedObjects, pTarget);
+	if (it == ReferencedObjects.end()) return;
+	ReferencedObjects.erase(it);
+	std::erase(pTarget->Referrers, this);
+}
+
+void C4Object::SetActionTargets(C4Object *pTarget, C4Object *pTarget2)
+{
+	C4Object *const pOldTarget{Action.Target}, *const pOldTarget2{Action.Target2};
+	Action.Target = pTarget;
+	Action.Target2 = pTarget2;
+	RegisterReference(pTarget);
+	RegisterReference(pTarget2);
+	ReleaseReference(pOldTarget);
+	ReleaseReference(pOldTarget2);
+}
+
+void C4Object::RegisterReferences()
+{
+	RegisterReference(Action.Target);
+	RegisterReference(Action.Target2);
+	RegisterReference(pLayer);
+	for (C4Effect *pEff = pEffects; pEff; pEff = pEff->pNext)
+		RegisterReference(pEff->pCommandTarget);
+	for (C4Command *cCom = Command; cCom; cCom = cCom->Next)
+	{
+		RegisterReference(cCom->Target);
+		RegisterReference(cCom->Target2);
+	}
+	for (C4GraphicsOverlay *pGfxOvrl = pGfxOverlay; pGfxOvrl; pGfxOvrl = pGfxOvrl->GetNext())
+		RegisterReference(pGfxOvrl->GetOverlayObject());
+}
+
+void C4Object::ClearReferrers()
+{
+	for (C4Object *pTarget : ReferencedObjects)
+		std::erase(pTarget->Referrers, this);
+	for (C4Object *pReferrer : Referrers)
+		std::erase(pReferrer->ReferencedObjects, this);
+	ReferencedObjects.clear();
+	Referrers.clear();
+	Game.Objects.RemoveMenuObject(this);
+}
+
 C4Value C4Object::Call(const char *szFunctionCall, const C4AulParSet &pPars, bool fPassError, bool convertNilToIntBool)
 {
 	if (!Status || !Def || !szFunctionCall[0]) return C4VNull;
 	return Def->Script.ObjectCall(this, this, szFunctionCall, pPars, fPassError, convertNilToIntBool);
 }
 
+C4Value C4Object::Call(const C4PSFSlot slot, const C4AulParSet &pPars, bool fPassError, bool convertNilToIntBool)
+{
+	if (!Status || !Def) return C4VNull;
+	// definition doesn't implement this callback: nothing to do
+	C4AulScriptFunc *const pFn{Def->Script.GetCallback(slot)};
+	if (!pFn) return C4VNull;
+	return pFn->Exec(this, pPars, fPassError, true, convertNilToIntBool);
+}
+
 bool C4Object::SetPhase(int32_t iPhase)
 {
 	if (Action.Act <= ActIdle) return false;
@@ -2906,6 +3007,9 @@ void C4Object::DenumeratePointers()
 	if (pGfxOverlay)
 		for (C4GraphicsOverlay *pGfxOvrl = pGfxOverlay; pGfxOvrl; pGfxOvrl = pGfxOvrl->GetNext())
 			pGfxOvrl->DenumeratePointers();
+
+	RegisterReferences();
+	if (Menu) Game.Objects.AddMenuObject(this);
 }
 
 bool DrawCommandQuery(int32_t controller, C4ScriptHost &scripthost, int32_t *mask, int com)
@@ -3200,7 +3304,7 @@ void C4Object::Clear()
 	}
 	delete pDrawTransform;   pDrawTransform   = nullptr;
 	delete pGfxOverlay;      pGfxOverlay      = nullptr;
-	while (FirstRef) FirstRef->Set0();
+	ObjectHandles.Invalidate(HandleSlot);
 }
 
 bool C4Object::ContainedControl(uint8_t byCom)
@@ -3231,7 +3335,7 @@ bool C4Object::ContainedControl(uint8_t byCom)
 		if (Contained && !(byCom & (COM_Single | COM_Double)) && pPlr->ControlStyle)
 		{
 			int32_t PressedComs = pPlr->PressedComs;
-			Contained->Call(PSF_ContainedControlUpdate, {C4VObj(this), C4VInt(Coms2ComDir(PressedComs)),
+			Contained->Call(PSFSlot_ContainedControlUpdate, {C4VObj(this), C4VInt(Coms2ComDir(PressedComs)),
 				C4VBool(!!(PressedComs & (1 << COM_Dig))), C4VBool(!!(PressedComs & (1 << COM_Throw)))});
 		}
 	}
@@ -3273,7 +3377,7 @@ bool C4Object::ContainedControl(uint8_t byCom)
 		if (Contained && !(byCom & (COM_Single | COM_Double)) && pPlr->ControlStyle)
 		{
 			int32_t PressedComs = pPlr->PressedComs;
-			Contained->Call(PSF_ContainedControlUpdate, {C4VObj(this), C4VInt(Coms2ComDir(PressedComs)),
+			Contained->Call(PSFSlot_ContainedControlUpdate, {C4VObj(this), C4VInt(Coms2ComDir(PressedComs)),
 				C4VBool(!!(PressedComs & (1 << COM_Dig))), C4VBool(!!(PressedComs & (1 << COM_Throw)))});
 		}
 	}
@@ -3301,7 +3405,7 @@ bool C4Object::CallControl(C4Player *pPlr, uint8_t byCom, const C4AulParSet &pPa
 	if (pPlr->ControlStyle)
 	{
 		int32_t PressedComs = pPlr->PressedComs;
-		Call(PSF_ControlUpdate, {pPars[0]._getBool() ? pPars[0] : C4VObj(this),
+		Call(PSFSlot_ControlUpdate, {pPars[0]._getBool() ? pPars[0] : C4VObj(this),
 			C4VInt(Coms2ComDir(PressedComs)),
 			C4VBool(!!(PressedComs & (1 << COM_Dig))),
 			C4VBool(!!(PressedComs & (1 << COM_Throw))),
@@ -3845,15 +3949,15 @@ void C4Object::DrawSelectMark(C4FacetEx &cgo)
 
 void C4Object::ClearCommands()
 {
-	C4Command *pNext;
 	while (Command)
 	{
-		pNext = Command->Next;
-		if (!Command->iExec)
-			delete Command;
+		C4Command *const pCom{Command};
+		Command = pCom->Next;
+		pCom->ReleaseTargets();
+		if (!pCom->iExec)
+			delete pCom;
 		else
-			Command->iExec = 2;
-		Command = pNext;
+			pCom->iExec = 2;
 	}
 }
 
@@ -3867,6 +3971,7 @@ void C4Object::ClearCommand(C4Command *pUntil)
 		// Next one to clear after this
 		else pNext = pCom->Next;
 		Command = pCom->Next;
+		pCom->ReleaseTargets();
 		if (!pCom->iExec)
 			delete pCom;
 		else
@@ -3920,7 +4025,7 @@ void C4Object::SetCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int3
 		if (!CloseMenu(false)) return;
 	// Script overload
 	if (fControl)
-		if (Call(PSF_ControlCommand, {C4VString(CommandName(iCommand)),
+		if (Call(PSFSlot_ControlCommand, {C4VString(CommandName(iCommand)),
 			C4VObj(pTarget),
 			iTx,
 			C4VInt(iTy),
@@ -3932,7 +4037,7 @@ void C4Object::SetCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int3
 		if (Contained->Def->VehicleControl & C4D_VehicleControl_Inside)
 		{
 			Contained->Controller = Controller;
-			if (Contained->Call(PSF_ControlCommand, {C4VString(CommandName(iCommand)),
+			if (Contained->Call(PSFSlot_ControlCommand, {C4VString(CommandName(iCommand)),
 				C4VObj(pTarget),
 				iTx,
 				C4VInt(iTy),
@@ -3946,7 +4051,7 @@ void C4Object::SetCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int3
 		if (Action.Target) if (Action.Target->Def->VehicleControl & C4D_VehicleControl_Outside)
 		{
 			Action.Target->Controller = Controller;
-			if (Action.Target->Call(PSF_ControlCommand, {C4VString(CommandName(iCommand)),
+			if (Action.Target->Call(PSFSlot_ControlCommand, {C4VString(CommandName(iCommand)),
 				C4VObj(pTarget),
 				iTx,
 				C4VInt(iTy),
@@ -3973,7 +4078,7 @@ bool C4Object::ExecuteCommand()
 	if (Command) Command->Execute();
 	// Command finished: engine call
 	if (Command && Command->Finished)
-		Call(PSF_ControlCommandFinished, {C4VString(CommandName(Command->Command)), C4VObj(Command->Target), Command->Tx, C4VInt(Command->Ty), C4VObj(Command->Target2), C4Value(Command->Data, C4V_Any)});
+		Call(PSFSlot_ControlCommandFinished, {C4VString(CommandName(Command->Command)), C4VObj(Command->Target), Command->Tx, C4VInt(Command->Ty), C4VObj(Command->Target2), C4Value(Command->Data, C4V_Any)});
 	// Clear finished commands
 	while (Command && Command->Finished) ClearCommand(Command);
 	// Done
@@ -4064,6 +4169,14 @@ void C4Object::DrawCommand(C4Facet &cgoBar, int32_t iAlign, const char *szFuncti
 		pRegions->Add(cgoLeft.X, cgoLeft.Y, cgoLeft.Wdt * 2, cgoLeft.Hgt, cpDesc ? cpDesc : GetName(), iCom);
 }
 
+void C4Object::SetCategory(int32_t Category)
+{
+	this->Category = Category;
+	Game.Objects.UpdateTypeIndex(this);
+	Resort();
+	SetOCF();
+}
+
 void C4Object::Resort()
 {
 	// Flag resort
@@ -4119,8 +4232,7 @@ bool C4Object::SetAction(int32_t iAct, C4Object *pTarget, C4Object *pTarget2, in
 	Action.Phase = Action.PhaseDelay = 0;
 
 	// Set target if specified
-	if (pTarget) Action.Target = pTarget;
-	if (pTarget2) Action.Target2 = pTarget2;
+	SetActionTargets(pTarget ? pTarget : Action.Target, pTarget2 ? pTarget2 : Action.Target2);
 
 	// Set Action Facet
 	UpdateActionFace();
@@ -4251,7 +4363,7 @@ int32_t C4Object::GetProcedure()
 void GrabLost(C4Object *cObj)
 {
 	// Grab lost script call on target (quite hacky stuff...)
-	cObj->Action.Target->Call(PSF_GrabLost);
+	cObj->Action.Target->Call(PSFSlot_GrabLost);
 	// Clear commands down to first PushTo (if any) in command stack
 	for (C4Command *pCom = cObj->Command; pCom; pCom = pCom->Next)
 		if (pCom->Next && pCom->Next->Command == C4CMD_PushTo)
@@ -5155,7 +5267,7 @@ void C4Object::ExecAction()
 			// Grab lost action
 			GrabLost(this);
 			// Lose target
-			Action.Target = nullptr;
+			SetActionTargets(nullptr, Action.Target2);
 			// Done
 			return;
 		}
@@ -5260,7 +5372,7 @@ void C4Object::ExecAction()
 		if (Def->LiftTop)
 			if (Action.Target->y <= (y + Def->LiftTop))
 				if (Action.ComDir == COMD_Up)
-					Call(PSF_LiftTop);
+					Call(PSFSlot_LiftTop);
 		// General
 		DoGravity(this);
 		break;
@@ -5296,7 +5408,7 @@ void C4Object::ExecAction()
 			if (Status)
 			{
 				SetAction(ActIdle);
-				Call(PSF_AttachTargetLost);
+				Call(PSFSlot_AttachTargetLost);
 			}
 			return;
 		}
@@ -5321,7 +5433,7 @@ void C4Object::ExecAction()
 				if (Status)
 				{
 					SetAction(ActIdle);
-					Call(PSF_AttachTargetLost);
+					Call(PSFSlot_AttachTargetLost);
 				}
 				return;
 			}
@@ -5347,7 +5459,7 @@ void C4Object::ExecAction()
 		if (!Action.Target2 || (Action.Target2->Con < FullCon)) fBroke = true;
 		if (fBroke)
 		{
-			Call(PSF_LineBreak, {C4VBool(true)});
+			Call(PSFSlot_LineBreak, {C4VBool(true)});
 			AssignRemoval();
 			return;
 		}
@@ -5412,7 +5524,7 @@ void C4Object::ExecAction()
 		// Line fBroke
 		if (fBroke)
 		{
-			Call(PSF_LineBreak);
+			Call(PSFSlot_LineBreak);
 			AssignRemoval();
 			return;
 		}
@@ -5682,11 +5794,11 @@ bool C4Object::Collect(C4Object *pObj)
 	// Cancel attach (hacky)
 	ObjectComCancelAttach(pObj);
 	// Container Collection call
-	Call(PSF_Collection, {C4VObj(pObj)});
+	Call(PSFSlot_Collection, {C4VObj(pObj)});
 	// Object Hit call
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(PSF_Hit);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(PSF_Hit2);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(PSF_Hit3);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(PSFSlot_Hit);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(PSFSlot_Hit2);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(PSFSlot_Hit3);
 	// post-copy the motion of the new container
 	if (pObj->Contained == this) pObj->CopyMotion(this);
 	// done, success
@@ -5925,7 +6037,9 @@ bool C4Object::RemoveGraphicsOverlay(int32_t iOverlayID)
 		// remove it
 		if (pPrevOverlay) pPrevOverlay->SetNext(pOverlay->GetNext()); else pGfxOverlay = pOverlay->GetNext();
 		pOverlay->SetNext(nullptr); // prevents deletion of following overlays
+		C4Object *const pOverlayObj{pOverlay->GetOverlayObject()};
 		delete pOverlay;
+		ReleaseReference(pOverlayObj);
 		// removed
 		return true;
 	}
@@ -5956,7 +6070,7 @@ bool C4Object::StatusActivate()
 	UpdateGraphics(false);
 	UpdateFace(true);
 	UpdatePos();
-	Call(PSF_UpdateTransferZone);
+	Call(PSFSlot_UpdateTransferZone);
 	// done, success
 	return true;
 }
@@ -6086,27 +6200,6 @@ void C4Object::UpdateInLiquid()
 	}
 }
 
-void C4Object::AddRef(C4Value *pRef)
-{
-	pRef->NextRef = FirstRef;
-	FirstRef = pRef;
-}
-
-void C4Object::DelRef(const C4Value *pRef, C4Value *pNextRef)
-{
-	// References to objects never have HasBaseArray set
-	if (pRef == FirstRef)
-		FirstRef = pNextRef;
-	else
-	{
-		C4Value *pVal = FirstRef;
-		while (pVal->NextRef && pVal->NextRef != pRef)
-			pVal = pVal->NextRef;
-		assert(pVal->NextRef);
-		pVal->NextRef = pNextRef;
-	}
-}
-
 StdStrBuf C4Object::GetInfoString()
 {
 	StdStrBuf sResult;
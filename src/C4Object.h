@@ -27,12 +27,14 @@
 #include "C4ObjectInfo.h"
 #include "C4Particles.h"
 #include "C4Player.h"
+#include "C4Script.h"
 #include "C4Sector.h"
 #include "C4Value.h"
 #include "C4ValueList.h"
 
 #include <array>
 #include <string>
+#include <vector>
 
 /* Object status */
 
@@ -196,10 +198,13 @@ public:
 
 	StdStrBuf nInfo;
 
-	C4Value *FirstRef; // No-Save
+	std::uint32_t HandleSlot; // slot in ObjectHandles - No-Save
 
 	class C4GraphicsOverlay *pGfxOverlay; // singly linked list of overlay graphics
 
+	// back references for ClearPointers: objects that may point to this object, and the objects this object is registered with - NoSave
+	std::vector<C4Object *> Referrers, ReferencedObjects;
+
 protected:
 	std::string CustomName;
 	bool OnFire;
@@ -238,6 +243,7 @@ public:
 
 	bool CallControl(C4Player *pPlr, uint8_t byCom, const C4AulParSet &pPars = C4AulParSet{});
 	C4Value Call(const char *szFunctionCall, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false, bool convertNilToIntBool = true);
+	C4Value Call(C4PSFSlot slot, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false, bool convertNilToIntBool = true); // engine callback resolved at link time
 
 	bool ContainedControl(uint8_t byCom);
 
@@ -272,6 +278,12 @@ public:
 	void DrawFace(C4FacetEx &cgo, int32_t cgoX, int32_t cgoY, int32_t iPhaseX = 0, int32_t iPhaseY = 0);
 	void Execute();
 	void ClearPointers(C4Object *ptr);
+	bool HasPointers(C4Object *ptr); // whether ClearPointers(ptr) would clear anything besides the menu
+	void RegisterReference(C4Object *pTarget); // register as referrer of pTarget after storing a pointer to it
+	void ReleaseReference(C4Object *pTarget); // unregister from pTarget after dropping a pointer to it, unless another one is left
+	void SetActionTargets(C4Object *pTarget, C4Object *pTarget2); // set the action targets and update the registrations
+	void RegisterReferences(); // register as referrer of everything pointed to
+	void ClearReferrers(); // remove from the back references in both directions
 	bool ExecMovement();
 	bool ExecFire(int32_t iIndex, int32_t iCausedByPlr);
 	void ExecAction();
@@ -287,6 +299,7 @@ public:
 	void UpdateOCF(); // Update fluctuant OCF
 	void UpdateShape(bool bUpdateVertices = true);
 	void UpdatePos(); // pos/shape changed
+	uint64_t GetSyncHash() const; // hash of position, movement, action and OCF for sync checks
 	void UpdateSolidMask(bool fRestoreAttachedObjects);
 	void UpdateMass();
 	void ComponentConCutoff();
@@ -308,7 +321,7 @@ public:
 	bool SetAction(int32_t iAct, C4Object *pTarget = nullptr, C4Object *pTarget2 = nullptr, int32_t iCalls = SAC_StartCall | SAC_AbortCall, bool fForce = false);
 	bool SetActionByName(const char *szActName, C4Object *pTarget = nullptr, C4Object *pTarget2 = nullptr, int32_t iCalls = SAC_StartCall | SAC_AbortCall, bool fForce = false);
 	void SetDir(int32_t tdir);
-	void SetCategory(int32_t Category) { this->Category = Category; Resort(); SetOCF(); }
+	void SetCategory(int32_t Category);
 	int32_t GetProcedure();
 	bool Enter(C4Object *pTarget, bool fCalls = true, bool fCopyMotion = true, bool *pfRejectCollect = nullptr);
 	bool Exit(int32_t iX = 0, int32_t iY = 0, int32_t iR = 0, C4Fixed iXDir = Fix0, C4Fixed iYDir = Fix0, C4Fixed iRDir = Fix0, bool fCalls = true);
@@ -316,6 +329,7 @@ public:
 	void ForcePosition(int32_t tx, int32_t ty);
 	void MovePosition(int32_t dx, int32_t dy);
 	void DoMotion(int32_t mx, int32_t my);
+	void SkipFreeMotion(int32_t tx, int32_t ty); // move towards tx/ty up to the last step known to be free of contact
 	bool ActivateEntrance(int32_t by_plr, C4Object *by_obj);
 	bool Incinerate(int32_t iCausedBy, bool fBlasted = false, C4Object *pIncineratingObject = nullptr);
 	bool Extinguish(int32_t iFireNumber);
@@ -422,8 +436,7 @@ public:
 
 	bool AdjustWalkRotation(int32_t iRangeX, int32_t iRangeY, int32_t iSpeed);
 
-	void AddRef(C4Value *pRef);
-	void DelRef(const C4Value *pRef, C4Value *pNextRef);
+	C4ObjectHandle GetHandle() const { return ObjectHandles.GetHandle(HandleSlot); }
 
 	StdStrBuf GetInfoString(); // return def desc plus effects
 
@@ -49,7 +49,7 @@ bool ObjectActionJump(C4Object *cObj, C4Fixed xdir, C4Fixed ydir, bool fByCom)
 {
 	// scripted jump?
 	assert(cObj);
-	if (cObj->Call(PSF_OnActionJump, {C4VInt(fixtoi(xdir, 100)), C4VInt(fixtoi(ydir, 100)), C4VBool(fByCom)})) return true;
+	if (cObj->Call(PSFSlot_OnActionJump, {C4VInt(fixtoi(xdir, 100)), C4VInt(fixtoi(ydir, 100)), C4VBool(fByCom)})) return true;
 	// hardcoded jump by action
 	if (!cObj->SetActionByName("Jump")) return false;
 	cObj->xdir = xdir; cObj->ydir = ydir;
@@ -249,11 +249,11 @@ bool ObjectComGrab(C4Object *cObj, C4Object *pTarget)
 	if (!pTarget) return false;
 	if (cObj->GetProcedure() != DFA_WALK) return false;
 	if (!ObjectActionPush(cObj, pTarget)) return false;
-	cObj->Call(PSF_Grab, {C4VObj(pTarget), C4VBool(true)});
+	cObj->Call(PSFSlot_Grab, {C4VObj(pTarget), C4VBool(true)});
 	if (pTarget->Status && cObj->Status)
 	{
 		pTarget->Controller = cObj->Controller;
-		pTarget->Call(PSF_Grabbed, {C4VObj(cObj), C4VBool(true)});
+		pTarget->Call(PSFSlot_Grabbed, {C4VObj(cObj), C4VBool(true)});
 	}
 	return true;
 }
@@ -267,9 +267,9 @@ bool ObjectComUnGrab(C4Object *cObj)
 		if (ObjectActionStand(cObj))
 		{
 			if (!cObj->CloseMenu(false)) return false;
-			cObj->Call(PSF_Grab, {C4VObj(pTarget), C4VBool(false)});
+			cObj->Call(PSFSlot_Grab, {C4VObj(pTarget), C4VBool(false)});
 			if (pTarget && pTarget->Status && cObj->Status)
-				pTarget->Call(PSF_Grabbed, {C4VObj(cObj), C4VBool(false)});
+				pTarget->Call(PSFSlot_Grabbed, {C4VObj(cObj), C4VBool(false)});
 			return true;
 		}
 	}
@@ -371,8 +371,7 @@ C4Object *CreateLine(C4ID idType, int32_t iOwner, C4Object *pFrom, C4Object *pTo
 	pLine->Shape.VtxY[0] = pFrom->y + pFrom->Shape.Hgt / 4;
 	pLine->Shape.VtxX[1] = pTo->x;
 	pLine->Shape.VtxY[1] = pTo->y + pTo->Shape.Hgt / 4;
-	pLine->Action.Target = pFrom;
-	pLine->Action.Target2 = pTo;
+	pLine->SetActionTargets(pFrom, pTo);
 	return pLine;
 }
 
@@ -419,8 +418,9 @@ bool ObjectComLineConstruction(C4Object *cObj)
 		}
 		// Attach line to collected linekit
 		StartSoundEffect("Connect", false, 100, cObj);
-		if (cline->Action.Target  == tstruct) cline->Action.Target  = linekit;
-		if (cline->Action.Target2 == tstruct) cline->Action.Target2 = linekit;
+		cline->SetActionTargets(
+			cline->Action.Target  == tstruct ? linekit : cline->Action.Target,
+			cline->Action.Target2 == tstruct ? linekit : cline->Action.Target2);
 		// Message
 		GameMsgObject(LoadResStr(C4ResStrTableKey::IDS_OBJ_DISCONNECT, cline->GetName(), tstruct->GetName()).c_str(), tstruct);
 		return true;
@@ -474,8 +474,9 @@ bool ObjectComLineConstruction(C4Object *cObj)
 
 		// Connect line to structure
 		StartSoundEffect("Connect", false, 100, cObj);
-		if (cline->Action.Target == linekit) cline->Action.Target = tstruct;
-		if (cline->Action.Target2 == linekit) cline->Action.Target2 = tstruct;
+		cline->SetActionTargets(
+			cline->Action.Target  == linekit ? tstruct : cline->Action.Target,
+			cline->Action.Target2 == linekit ? tstruct : cline->Action.Target2);
 		linekit->Exit();
 		linekit->AssignRemoval();
 
@@ -615,9 +616,9 @@ bool ObjectComPut(C4Object *cObj, C4Object *pTarget, C4Object *pThing)
 	bool fRejectCollect;
 	if (!pThing->Enter(pTarget, true, true, &fRejectCollect)) return false;
 	// Put call to object script
-	cObj->Call(PSF_Put);
+	cObj->Call(PSFSlot_Put);
 	// Target collection call
-	pTarget->Call(PSF_Collection, {C4VObj(pThing), C4VBool(true)});
+	pTarget->Call(PSFSlot_Collection, {C4VObj(pThing), C4VBool(true)});
 	// Success
 	return true;
 }
@@ -739,7 +740,7 @@ bool ObjectComPunch(C4Object *cObj, C4Object *pTarget, int32_t punch)
 		if (pTarget->GetPhysical()->Fight)
 			punch = BoundBy<int32_t>(5 * cObj->GetPhysical()->Fight / pTarget->GetPhysical()->Fight, 0, 10);
 	if (!punch) return true;
-	bool fBlowStopped = static_cast<bool>(pTarget->Call(PSF_QueryCatchBlow, {C4VObj(cObj)}));
+	bool fBlowStopped = static_cast<bool>(pTarget->Call(PSFSlot_QueryCatchBlow, {C4VObj(cObj)}));
 	if (fBlowStopped && punch > 1) punch = punch / 2; // half damage for caught blow, so shield+armor help in fistfight and vs monsters
 	pTarget->DoEnergy(-punch, false, C4FxCall_EngGetPunched, cObj->Controller);
 	int32_t tdir = +1; if (cObj->Action.Dir == DIR_Left) tdir = -1;
@@ -751,7 +752,7 @@ bool ObjectComPunch(C4Object *cObj, C4Object *pTarget, int32_t punch)
 		if (ObjectActionTumble(pTarget, pTarget->Action.Dir, FIXED100(150) * tdir, itofix(-2)))
 		{
 			pTarget->LastEnergyLossCausePlayer = cObj->Controller; // for kill tracing when pushing enemies off a cliff
-			pTarget->Call(PSF_CatchBlow, {C4VInt(punch), C4VObj(cObj)});
+			pTarget->Call(PSFSlot_CatchBlow, {C4VInt(punch), C4VObj(cObj)});
 			return true;
 		}
 
@@ -759,7 +760,7 @@ bool ObjectComPunch(C4Object *cObj, C4Object *pTarget, int32_t punch)
 	if (ObjectActionGetPunched(pTarget, FIXED100(250) * tdir, Fix0))
 	{
 		pTarget->LastEnergyLossCausePlayer = cObj->Controller; // for kill tracing when pushing enemies off a cliff
-		pTarget->Call(PSF_CatchBlow, {C4VInt(punch), C4VObj(cObj)});
+		pTarget->Call(PSFSlot_CatchBlow, {C4VInt(punch), C4VObj(cObj)});
 		return true;
 	}
 
@@ -0,0 +1,48 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4ObjectHandle.h>
+
+#include <cassert>
+
+std::uint32_t C4ObjectHandleTable::Register(C4Object *const obj)
+{
+	if (FreeSlots.empty())
+	{
+		Entries.push_back({obj, 1});
+		return static_cast<std::uint32_t>(Entries.size() - 1);
+	}
+
+	const std::uint32_t slot{FreeSlots.back()};
+	FreeSlots.pop_back();
+	assert(!Entries[slot].Obj);
+	Entries[slot].Obj = obj;
+	return slot;
+}
+
+void C4ObjectHandleTable::Invalidate(const std::uint32_t slot)
+{
+	assert(slot && slot < Entries.size());
+	++Entries[slot].Generation;
+	++InvalidationCount;
+}
+
+void C4ObjectHandleTable::Release(const std::uint32_t slot)
+{
+	Invalidate(slot);
+	Entries[slot].Obj = nullptr;
+	FreeSlots.push_back(slot);
+}
@@ -0,0 +1,63 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// Generational handles for objects held by script values
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class C4Object;
+
+// Refers to an object until the object is removed
+struct C4ObjectHandle
+{
+	std::uint32_t Slot;
+	std::uint32_t Generation;
+
+	bool operator==(const C4ObjectHandle &other) const noexcept = default;
+};
+
+// Every object owns a slot for its whole lifetime. Increasing the generation
+// of a slot invalidates all handles to it, so values holding a removed object
+// don't need to be tracked and reset; they resolve to nil when read.
+class C4ObjectHandleTable
+{
+	struct Entry
+	{
+		C4Object *Obj;
+		std::uint32_t Generation;
+	};
+
+	// slot 0 is never used, so handles are never all zero
+	std::vector<Entry> Entries{Entry{nullptr, 0}};
+	std::vector<std::uint32_t> FreeSlots;
+	std::uint32_t InvalidationCount{0};
+
+public:
+	std::uint32_t Register(C4Object *obj);
+	void Invalidate(std::uint32_t slot); // handles of the slot resolve to nil; new ones can be taken
+	void Release(std::uint32_t slot); // the object is deleted
+
+	C4ObjectHandle GetHandle(std::uint32_t slot) const { return {slot, Entries[slot].Generation}; }
+	bool IsValid(C4ObjectHandle handle) const { return handle.Slot < Entries.size() && Entries[handle.Slot].Generation == handle.Generation; }
+	C4Object *Get(C4ObjectHandle handle) const { return IsValid(handle) ? Entries[handle.Slot].Obj : nullptr; }
+
+	// changes whenever handles have been invalidated
+	std::uint32_t GetInvalidationCount() const { return InvalidationCount; }
+};
+
+extern C4ObjectHandleTable ObjectHandles;
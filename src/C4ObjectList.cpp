@@ -50,6 +50,7 @@ void C4ObjectList::Clear()
 	}
 	First = Last = nullptr;
 	pEnumerated.reset();
+	UpdateNumberIndex();
 }
 
 const int MaxTempListID = 500;
@@ -430,10 +431,47 @@ void C4ObjectList::Enumerate()
 			cLnk->Obj->EnumeratePointers();
 }
 
+void C4ObjectList::EnableNumberIndex()
+{
+	if (!pNumberIndex)
+	{
+		pNumberIndex = std::make_unique<NumberIndex>();
+		UpdateNumberIndex();
+	}
+}
+
+void C4ObjectList::UpdateNumberIndex()
+{
+	if (!pNumberIndex) return;
+	pNumberIndex->Objects.clear();
+	pNumberIndex->Members.clear();
+	for (C4ObjectLink *cLnk = First; cLnk; cLnk = cLnk->Next)
+		AddToNumberIndex(cLnk->Obj);
+}
+
+void C4ObjectList::AddToNumberIndex(C4Object *pObj)
+{
+	if (!pNumberIndex) return;
+	pNumberIndex->Members.insert(pObj);
+	// on duplicate numbers, the first indexed object wins
+	pNumberIndex->Objects.try_emplace(pObj->Number, pObj);
+}
+
+void C4ObjectList::RemoveFromNumberIndex(C4Object *pObj)
+{
+	if (!pNumberIndex) return;
+	pNumberIndex->Members.erase(pObj);
+	if (const auto it = pNumberIndex->Objects.find(pObj->Number); it != pNumberIndex->Objects.end() && it->second == pObj)
+		pNumberIndex->Objects.erase(it);
+}
+
 int32_t C4ObjectList::ObjectNumber(C4Object *pObj)
 {
 	C4ObjectLink *cLnk;
 	if (!pObj) return 0;
+	// indexed: check membership without dereferencing pObj, which might be a dangling pointer
+	if (pNumberIndex)
+		return pNumberIndex->Members.contains(pObj) ? pObj->Number : 0;
 	for (cLnk = First; cLnk; cLnk = cLnk->Next)
 		if (cLnk->Obj == pObj)
 			return cLnk->Obj->Number;
@@ -443,6 +481,7 @@ int32_t C4ObjectList::ObjectNumber(C4Object *pObj)
 bool C4ObjectList::IsContained(C4Object *pObj)
 {
 	C4ObjectLink *cLnk;
+	if (pNumberIndex) return pNumberIndex->Members.contains(pObj);
 	for (cLnk = First; cLnk; cLnk = cLnk->Next)
 		if (cLnk->Obj == pObj)
 			return true;
@@ -543,6 +582,11 @@ void C4ObjectList::CompileFunc(StdCompiler *pComp, bool fSaveRefs, bool fSkipPla
 
 C4Object *C4ObjectList::ObjectPointer(int32_t iNumber)
 {
+	if (pNumberIndex)
+	{
+		const auto it = pNumberIndex->Objects.find(iNumber);
+		return it != pNumberIndex->Objects.end() ? it->second : nullptr;
+	}
 	C4ObjectLink *cLnk;
 	for (cLnk = First; cLnk; cLnk = cLnk->Next)
 		if (cLnk->Obj->Number == iNumber)
@@ -615,6 +659,7 @@ void C4ObjectList::RemoveLink(C4ObjectLink *pLnk)
 {
 	if (pLnk->Prev) pLnk->Prev->Next = pLnk->Next; else First = pLnk->Next;
 	if (pLnk->Next) pLnk->Next->Prev = pLnk->Prev; else Last = pLnk->Prev;
+	RemoveFromNumberIndex(pLnk->Obj);
 }
 
 void C4ObjectList::InsertLink(C4ObjectLink *pLnk, C4ObjectLink *pAfter)
@@ -633,6 +678,7 @@ void C4ObjectList::InsertLink(C4ObjectLink *pLnk, C4ObjectLink *pAfter)
 		if (First) First->Prev = pLnk; else Last = pLnk;
 		First = pLnk;
 	}
+	AddToNumberIndex(pLnk->Obj);
 }
 
 void C4ObjectList::InsertLinkBefore(C4ObjectLink *pLnk, C4ObjectLink *pBefore)
@@ -651,6 +697,7 @@ void C4ObjectList::InsertLinkBefore(C4ObjectLink *pLnk, C4ObjectLink *pBefore)
 		if (Last) Last->Next = pLnk; else First = pLnk;
 		Last = pLnk;
 	}
+	AddToNumberIndex(pLnk->Obj);
 }
 
 void C4NotifyingObjectList::InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore)
@@ -729,13 +776,14 @@ void C4ObjectList::Default()
 	First = Last = nullptr;
 	Mass = 0;
 	pEnumerated.reset();
+	UpdateNumberIndex();
 }
 
 void C4ObjectList::UpdateTransferZones()
 {
 	C4Object *cobj; C4ObjectLink *clnk;
 	for (clnk = First; clnk && (cobj = clnk->Obj); clnk = clnk->Next)
-		cobj->Call(PSF_UpdateTransferZone);
+		cobj->Call(PSFSlot_UpdateTransferZone);
 }
 
 void C4ObjectList::ResetAudibility()
@@ -19,6 +19,8 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "C4Id.h"
@@ -44,6 +46,17 @@ class C4ObjectList
 {
 	std::unique_ptr<std::vector<int32_t>> pEnumerated;
 
+	// optional lookup index for lists with many objects, see EnableNumberIndex
+	struct NumberIndex
+	{
+		std::unordered_map<int32_t, C4Object *> Objects; // object by number
+		std::unordered_set<const C4Object *> Members; // all objects linked into the list
+	};
+	std::unique_ptr<NumberIndex> pNumberIndex;
+
+	void AddToNumberIndex(C4Object *pObj);
+	void RemoveFromNumberIndex(C4Object *pObj);
+
 public:
 	C4ObjectList();
 	C4ObjectList(const C4ObjectList &List);
@@ -89,6 +102,8 @@ public:
 	void Clear();
 	void Enumerate();
 	void Denumerate();
+	void EnableNumberIndex(); // keep an index for ObjectPointer/ObjectNumber/IsContained lookups in constant time
+	void UpdateNumberIndex(); // rebuild the number index; must be called after links or object numbers were modified directly
 	void Copy(const C4ObjectList &rList);
 	void DrawAll(C4FacetEx &cgo, int iPlayer = -1); // draw all objects, including bg
 	void DrawIfCategory(C4FacetEx &cgo, int iPlayer, uint32_t dwCat, bool fInvert); // draw all objects that match dwCat (or don't match if fInvert)
@@ -0,0 +1,177 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+// objects of a key of C4ObjectTypeIndex by label, so in list order
+template<typename Object>
+using C4ObjectTypeIndexObjects = std::map<std::uint64_t, Object *>;
+
+// Index of the objects of a list by id and by category bit, each in list order.
+// Objects are ordered by labels that increase in list order. Labels are spaced,
+// so an object inserted into the list can usually be labeled between its neighbours.
+// Otherwise, the labels of a window of neighbours around it are spread out again;
+// the window grows until its labels are not crowded anymore.
+// Link needs Obj, Prev and Next members; Object needs id and Category members.
+template<typename Object, typename Link, typename ID>
+class C4ObjectTypeIndex
+{
+public:
+	using Objects = C4ObjectTypeIndexObjects<Object>;
+
+private:
+	static constexpr std::uint64_t LabelGap{std::uint64_t{1} << 32};
+	static constexpr std::uint64_t MaxLabel{std::numeric_limits<std::uint64_t>::max()};
+
+	struct Entry
+	{
+		ID id;
+		std::uint32_t Category;
+		std::uint64_t Label;
+	};
+
+	std::unordered_map<ID, Objects> byID;
+	std::array<Objects, 32> byCategory;
+	std::unordered_map<const Object *, Entry> entries; // id and category the objects are indexed with
+
+public:
+	std::size_t Size() const { return entries.size(); }
+	bool Contains(const Object *const obj) const { return entries.contains(obj); }
+
+	const Objects &ByID(const ID id) const
+	{
+		static const Objects None;
+		const auto it = byID.find(id);
+		return it != byID.end() ? it->second : None;
+	}
+
+	const Objects &ByCategory(const std::uint32_t categoryBit) const
+	{
+		assert(std::has_single_bit(categoryBit));
+		return byCategory[std::countr_zero(categoryBit)];
+	}
+
+	void Clear()
+	{
+		byID.clear();
+		for (auto &objects : byCategory) objects.clear();
+		entries.clear();
+	}
+
+	// index all objects of the list starting at first
+	void Rebuild(const Link *const first)
+	{
+		Clear();
+		std::uint64_t label{0};
+		for (const Link *link{first}; link; link = link->Next)
+			Add(link->Obj, label += LabelGap);
+	}
+
+	// index the object of a link that has just been inserted into the list; all other links must be indexed
+	void Insert(const Link *const link)
+	{
+		assert(!Contains(link->Obj));
+		const std::uint64_t lo{LabelOf(link->Prev, 0)};
+		const std::uint64_t hi{LabelOf(link->Next, MaxLabel)};
+		// objects appended to the list keep the full gap to the next appended ones
+		const std::uint64_t label{lo + (link->Next ? (hi - lo) / 2 : std::min(LabelGap, (hi - lo) / 2))};
+		Add(link->Obj, label != lo ? label : Relabel(link));
+	}
+
+	// remove an object that is about to be removed from the list or has been indexed with another id or category
+	void Remove(const Object *const obj)
+	{
+		const auto it = entries.find(obj);
+		if (it == entries.end()) return;
+		const Entry entry{it->second};
+		entries.erase(it);
+
+		if (const auto objects = byID.find(entry.id); objects != byID.end())
+		{
+			objects->second.erase(entry.Label);
+			if (objects->second.empty()) byID.erase(objects);
+		}
+		for (std::uint32_t dwBits{entry.Category}; dwBits; dwBits &= dwBits - 1)
+			byCategory[std::countr_zero(dwBits)].erase(entry.Label);
+	}
+
+private:
+	// label of a neighbour, or the bound if there is none
+	std::uint64_t LabelOf(const Link *const link, const std::uint64_t bound) const
+	{
+		if (!link) return bound;
+		const auto it = entries.find(link->Obj);
+		// links modified directly must be followed by Rebuild; until then, the order doesn't matter
+		assert(it != entries.end());
+		return it != entries.end() ? it->second.Label : bound;
+	}
+
+	void Add(Object *const obj, const std::uint64_t label)
+	{
+		const auto dwCategory = static_cast<std::uint32_t>(obj->Category);
+		entries.insert_or_assign(obj, Entry{obj->id, dwCategory, label});
+		byID[obj->id].emplace(label, obj);
+		for (std::uint32_t dwBits{dwCategory}; dwBits; dwBits &= dwBits - 1)
+			byCategory[std::countr_zero(dwBits)].emplace(label, obj);
+	}
+
+	// spread out the labels around a link that doesn't fit between its neighbours; returns the label for the link
+	std::uint64_t Relabel(const Link *const link)
+	{
+		// find a window whose labels leave each link a gap larger than the number of links in it
+		const Link *first{link}, *last{link};
+		std::uint64_t count{1}, lo, hi;
+		for (std::uint64_t extend{1};; extend *= 2)
+		{
+			for (std::uint64_t i{0}; i < extend && first->Prev; ++i, ++count) first = first->Prev;
+			for (std::uint64_t i{0}; i < extend && last->Next; ++i, ++count) last = last->Next;
+			lo = LabelOf(first->Prev, 0);
+			hi = LabelOf(last->Next, MaxLabel);
+			if ((hi - lo) / (count + 1) > count || (!first->Prev && !last->Next)) break;
+		}
+
+		// labels of the same bucket must not collide while being changed, so remove all first
+		std::vector<Object *> window;
+		window.reserve(count);
+		for (const Link *other{first};; other = other->Next)
+		{
+			window.push_back(other->Obj);
+			if (other != link) Remove(other->Obj);
+			if (other == last) break;
+		}
+		const std::uint64_t step{(hi - lo) / (count + 1)};
+		std::uint64_t label{lo}, linkLabel{0};
+		for (Object *const obj : window)
+		{
+			label += step;
+			if (obj == link->Obj)
+				linkLabel = label;
+			else
+				Add(obj, label);
+		}
+		return linkLabel;
+	}
+};
@@ -23,14 +23,35 @@
 #include <C4Random.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
+
 static const C4Fixed WindDrift_Factor = itofix(1, 800);
 
-void C4PXS::Execute()
+bool C4PXSSystem::ExecutePXS(const size_t iPXS)
 {
+	// work on copies, because reactions may create new PXS
+	int32_t iMat = Mat[iPXS];
+	C4Fixed x = X[iPXS], y = Y[iPXS], xdir = XDir[iPXS], ydir = YDir[iPXS];
+	const auto Update = [&, this](C4Fixed nx, C4Fixed ny)
+	{
+		Mat[iPXS] = iMat;
+		X[iPXS] = nx; Y[iPXS] = ny; XDir[iPXS] = xdir; YDir[iPXS] = ydir;
+		return true;
+	};
+	const auto Deactivate = [&]
+	{
+#ifdef DEBUGREC_PXS
+		C4RCExecPXS rc;
+		rc.x = x; rc.y = y; rc.iMat = iMat;
+		rc.pos = 2;
+		AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
+#endif
+		return false;
+	};
 #ifdef DEBUGREC_PXS
 	{
 		C4RCExecPXS rc;
-		rc.x = x; rc.y = y; rc.iMat = Mat;
+		rc.x = x; rc.y = y; rc.iMat = iMat;
 		rc.pos = 0;
 		AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 	}
@@ -38,30 +59,31 @@ void C4PXS::Execute()
 	int32_t inmat;
 
 	// Safety
-	if (!MatValid(Mat))
-	{
-		Deactivate(); return;
-	}
+	if (!MatValid(iMat))
+		return Deactivate();
 
 	// Out of bounds
 	if ((x < 0) || (x >= GBackWdt) || (y < -10) || (y >= GBackHgt))
-	{
-		Deactivate(); return;
-	}
+		return Deactivate();
 
 	// Material conversion
 	int32_t iX = fixtoi(x), iY = fixtoi(y);
 	inmat = GBackMat(iX, iY);
-	C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(Mat, inmat);
-	if (pReact && (*pReact->pFunc)(pReact, iX, iY, iX, iY, xdir, ydir, Mat, inmat, meePXSPos, nullptr))
+	// most PXS are falling through sky, which usually has no reaction
+	if (inmat != MNone || MatInfos[iMat].AirReaction)
 	{
-		Deactivate(); return;
+		C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(iMat, inmat);
+		if (pReact && (*pReact->pFunc)(pReact, iX, iY, iX, iY, xdir, ydir, iMat, inmat, meePXSPos, nullptr))
+			return Deactivate();
 	}
 
+	// the reaction may have changed the material
+	const MatInfo &Info = MatInfos[iMat];
+
 	// Gravity
 	ydir += GravAccel;
 
-	if (GBackDensity(iX, iY + 1) < Game.Material.Map[Mat].Density)
+	if (GBackDensity(iX, iY + 1) < Info.Density)
 	{
 		// Air speed: Wind plus some random
 		int32_t iWind = GBackWind(iX, iY);
@@ -69,9 +91,8 @@ void C4PXS::Execute()
 		C4Fixed tydir = FIXED256(Random(1200) - 600);
 
 		// Air friction, based on WindDrift. MaxSpeed is ignored.
-		int32_t iWindDrift = (std::max)(Game.Material.Map[Mat].WindDrift - 20, 0);
-		xdir += ((txdir - xdir) * iWindDrift) * WindDrift_Factor;
-		ydir += ((tydir - ydir) * iWindDrift) * WindDrift_Factor;
+		xdir += ((txdir - xdir) * Info.WindDrift) * WindDrift_Factor;
+		ydir += ((tydir - ydir) * Info.WindDrift) * WindDrift_Factor;
 	}
 
 	C4Fixed ctcox = x + xdir;
@@ -83,10 +104,7 @@ void C4PXS::Execute()
 	if (Inside<int32_t>(iToX, 0, GBackWdt - 1) && Inside<int32_t>(iToY, 0, GBackHgt - 1))
 		// Check path
 		if (Game.Landscape._PathFree(iX, iY, iToX, iToY))
-		{
-			x = ctcox; y = ctcoy;
-			return;
-		}
+			return Update(ctcox, ctcoy);
 
 	// Test path to target position
 	bool fStopMovement = false;
@@ -96,50 +114,33 @@ void C4PXS::Execute()
 		int32_t inX = iX + Sign(iToX - iX), inY = iY + Sign(iToY - iY);
 		// Contact?
 		inmat = GBackMat(inX, inY);
-		C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(Mat, inmat);
+		C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(iMat, inmat);
 		if (pReact)
-			if ((*pReact->pFunc)(pReact, iX, iY, inX, inY, xdir, ydir, Mat, inmat, meePXSMove, &fStopMovement))
+			if ((*pReact->pFunc)(pReact, iX, iY, inX, inY, xdir, ydir, iMat, inmat, meePXSMove, &fStopMovement))
 			{
 				// destructive contact
-				Deactivate();
-				return;
+				return Deactivate();
 			}
 			else
 			{
 				// no destructive contact, but speed or position changed: Stop moving for now
 				if (fStopMovement)
-				{
-					x = itofix(iX); y = itofix(iY);
-					return;
-				}
+					return Update(itofix(iX), itofix(iY));
 				// there was a reaction func, but it didn't do anything - continue movement
 			}
 		iX = inX; iY = inY;
 	} while (iX != iToX || iY != iToY);
 
 	// No contact? Free movement
-	x = ctcox; y = ctcoy;
 #ifdef DEBUGREC_PXS
 	{
 		C4RCExecPXS rc;
-		rc.x = x; rc.y = y; rc.iMat = Mat;
+		rc.x = ctcox; rc.y = ctcoy; rc.iMat = iMat;
 		rc.pos = 1;
 		AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 	}
 #endif
-	return;
-}
-
-void C4PXS::Deactivate()
-{
-#ifdef DEBUGREC_PXS
-	C4RCExecPXS rc;
-	rc.x = x; rc.y = y; rc.iMat = Mat;
-	rc.pos = 2;
-	AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
-#endif
-	Mat = MNone;
-	Game.PXS.Delete(this);
+	return Update(ctcox, ctcoy);
 }
 
 C4PXSSystem::C4PXSSystem()
@@ -155,82 +156,97 @@ C4PXSSystem::~C4PXSSystem()
 void C4PXSSystem::Default()
 {
 	Count = 0;
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		Chunk[cnt] = nullptr;
-		iChunkPXS[cnt] = 0;
-	}
+	Clear();
 }
 
 void C4PXSSystem::Clear()
 {
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		delete[] Chunk[cnt];
-		Chunk[cnt] = nullptr;
-		iChunkPXS[cnt] = 0;
-	}
+	Mat.clear();
+	X.clear(); Y.clear();
+	XDir.clear(); YDir.clear();
+	Chunks.clear();
+	FirstFree = 0;
+	MatInfos.clear();
 }
 
-C4PXS *C4PXSSystem::New()
+void C4PXSSystem::SetChunkCount(const size_t iChunks)
 {
-	unsigned int cnt, cnt2;
-	C4PXS *pxp;
-	// Check chunks for available space
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		// Create new chunk if necessary
-		if (!Chunk[cnt])
-		{
-			Chunk[cnt] = new C4PXS[PXSChunkSize];
-			iChunkPXS[cnt] = 0;
-		}
-		// Check this chunk for space
-		if (iChunkPXS[cnt] < PXSChunkSize)
-			for (cnt2 = 0, pxp = Chunk[cnt]; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat == MNone)
-				{
-					// count theam
-					iChunkPXS[cnt]++;
-					return pxp;
-				}
-	}
-	return nullptr;
+	const size_t iSlots = iChunks * PXSChunkSize;
+	Mat.resize(iSlots, MNone);
+	X.resize(iSlots, Fix0); Y.resize(iSlots, Fix0);
+	XDir.resize(iSlots, Fix0); YDir.resize(iSlots, Fix0);
+	Chunks.resize(iChunks);
+	FirstFree = (std::min)(FirstFree, iSlots);
+}
+
+size_t C4PXSSystem::New()
+{
+	// the first free slot is used, so the order is the same on all clients
+	size_t iPXS = FirstFree;
+	while (iPXS < Mat.size() && Mat[iPXS] != MNone) iPXS++;
+	// all chunks full? Add one
+	if (iPXS == Mat.size())
+		SetChunkCount(Chunks.size() + 1);
+	ChunkInfo &Chunk = Chunks[iPXS / PXSChunkSize];
+	Chunk.Allocated = true;
+	Chunk.PXSCount++;
+	FirstFree = iPXS + 1;
+	return iPXS;
+}
+
+void C4PXSSystem::Delete(const size_t iPXS)
+{
+	Mat[iPXS] = MNone;
+	Chunks[iPXS / PXSChunkSize].PXSCount--;
+	FirstFree = (std::min)(FirstFree, iPXS);
 }
 
 bool C4PXSSystem::Create(int32_t mat, C4Fixed ix, C4Fixed iy, C4Fixed ixdir, C4Fixed iydir)
 {
-	C4PXS *pxp;
 	if (!MatValid(mat)) return false;
-	if (!(pxp = New())) return false;
-	pxp->Mat = mat;
-	pxp->x = ix; pxp->y = iy;
-	pxp->xdir = ixdir; pxp->ydir = iydir;
+	const size_t iPXS = New();
+	Mat[iPXS] = mat;
+	X[iPXS] = ix; Y[iPXS] = iy;
+	XDir[iPXS] = ixdir; YDir[iPXS] = iydir;
 	return true;
 }
 
 void C4PXSSystem::Execute()
 {
-	// Execute all chunks
+	// Update material info
+	MatInfos.resize(Game.Material.Num);
+	for (int32_t cnt = 0; cnt < Game.Material.Num; cnt++)
+	{
+		const C4Material &Material = Game.Material.Map[cnt];
+		MatInfos[cnt].Density = Material.Density;
+		MatInfos[cnt].WindDrift = (std::max)(Material.WindDrift - 20, 0);
+		MatInfos[cnt].AirReaction = Game.Material.GetReactionUnsafe(cnt, MNone) != nullptr;
+	}
+
+	// Execute all chunks in slot order
+	// PXS created by reactions in a later slot are executed in this frame as well
 	Count = 0;
-	for (unsigned int cchunk = 0; cchunk < PXSMaxChunk; cchunk++)
-		if (Chunk[cchunk])
-			// empty chunk?
-			if (!iChunkPXS[cchunk])
-			{
-				delete[] Chunk[cchunk]; Chunk[cchunk] = nullptr;
-			}
-			else
+	for (size_t iChunk = 0; iChunk < Chunks.size(); iChunk++)
+	{
+		if (!Chunks[iChunk].Allocated) continue;
+		// empty chunk?
+		if (!Chunks[iChunk].PXSCount)
+		{
+			Chunks[iChunk].Allocated = false;
+			continue;
+		}
+		for (size_t cnt = iChunk * PXSChunkSize; cnt < (iChunk + 1) * PXSChunkSize; cnt++)
+			if (Mat[cnt] != MNone)
 			{
-				// Execute chunk pxs, check for empty
-				C4PXS *pxp = Chunk[cchunk];
-				for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-					if (pxp->Mat != MNone)
-					{
-						pxp->Execute();
-						Count++;
-					}
+				if (!ExecutePXS(cnt)) Delete(cnt);
+				Count++;
 			}
+	}
+
+	// release dropped chunks at the end
+	size_t iChunks = Chunks.size();
+	while (iChunks && !Chunks[iChunks - 1].Allocated) iChunks--;
+	if (iChunks < Chunks.size()) SetChunkCount(iChunks);
 }
 
 void C4PXSSystem::Draw(C4FacetEx &cgo)
@@ -241,33 +257,28 @@ void C4PXSSystem::Draw(C4FacetEx &cgo)
 
 	// First pass: draw old-style PXS (lines/pixels)
 	int32_t cgox = cgo.X - cgo.TargetX, cgoy = cgo.Y - cgo.TargetY;
-	unsigned int cnt;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
+	for (size_t cnt = 0; cnt < Mat.size(); cnt++)
+		if (Mat[cnt] != MNone && VisibleRect.Contains(fixtoi(X[cnt]), fixtoi(Y[cnt])))
 		{
-			C4PXS *pxp = Chunk[cnt];
-			for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat != MNone && VisibleRect.Contains(fixtoi(pxp->x), fixtoi(pxp->y)))
-				{
-					C4Material *pMat = &Game.Material.Map[pxp->Mat];
-					if (pMat->PXSFace.Surface && Config.Graphics.PXSGfx)
-						continue;
-					// old-style: unicolored pixels or lines
-					uint32_t dwMatClr = Game.Landscape.GetPal()->GetClr(Mat2PixColDefault(pxp->Mat));
-					if (fixtoi(pxp->xdir) || fixtoi(pxp->ydir))
-					{
-						// lines for stuff that goes whooosh!
-						int len = fixtoi(Abs(pxp->xdir) + Abs(pxp->ydir));
-						dwMatClr = uint32_t(std::max<int>(dwMatClr >> 24, 195 - (195 - (dwMatClr >> 24)) / len)) << 24 | (dwMatClr & 0xffffff);
-						Application.DDraw->DrawLineDw(cgo.Surface,
-							fixtof(pxp->x - pxp->xdir) + cgox, fixtof(pxp->y - pxp->ydir) + cgoy,
-							fixtof(pxp->x) + cgox, fixtof(pxp->y) + cgoy,
-							dwMatClr);
-					}
-					else
-						// single pixels for slow stuff
-						Application.DDraw->DrawPix(cgo.Surface, fixtof(pxp->x) + cgox, fixtof(pxp->y) + cgoy, dwMatClr);
-				}
+			C4Material *pMat = &Game.Material.Map[Mat[cnt]];
+			if (pMat->PXSFace.Surface && Config.Graphics.PXSGfx)
+				continue;
+			const C4Fixed &x = X[cnt], &y = Y[cnt], &xdir = XDir[cnt], &ydir = YDir[cnt];
+			// old-style: unicolored pixels or lines
+			uint32_t dwMatClr = Game.Landscape.GetPal()->GetClr(Mat2PixColDefault(Mat[cnt]));
+			if (fixtoi(xdir) || fixtoi(ydir))
+			{
+				// lines for stuff that goes whooosh!
+				int len = fixtoi(Abs(xdir) + Abs(ydir));
+				dwMatClr = uint32_t(std::max<int>(dwMatClr >> 24, 195 - (195 - (dwMatClr >> 24)) / len)) << 24 | (dwMatClr & 0xffffff);
+				Application.DDraw->DrawLineDw(cgo.Surface,
+					fixtof(x - xdir) + cgox, fixtof(y - ydir) + cgoy,
+					fixtof(x) + cgox, fixtof(y) + cgoy,
+					dwMatClr);
+			}
+			else
+				// single pixels for slow stuff
+				Application.DDraw->DrawPix(cgo.Surface, fixtof(x) + cgox, fixtof(y) + cgoy, dwMatClr);
 		}
 
 	// PXS graphics disabled?
@@ -275,28 +286,24 @@ void C4PXSSystem::Draw(C4FacetEx &cgo)
 		return;
 
 	// Second pass: draw new-style PXS (graphics)
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
+	for (size_t cnt = 0; cnt < Mat.size(); cnt++)
+		if (Mat[cnt] != MNone && VisibleRect.Contains(fixtoi(X[cnt]), fixtoi(Y[cnt])))
 		{
-			C4PXS *pxp = Chunk[cnt];
-			for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat != MNone && VisibleRect.Contains(fixtoi(pxp->x), fixtoi(pxp->y)))
-				{
-					C4Material *pMat = &Game.Material.Map[pxp->Mat];
-					if (!pMat->PXSFace.Surface)
-						continue;
-					// new-style: graphics
-					int32_t pnx, pny;
-					pMat->PXSFace.GetPhaseNum(pnx, pny);
-					int32_t fcWdt = pMat->PXSFace.Wdt; int32_t fcWdtH = (std::max)(fcWdt / 3, 1);
-					// calculate draw width and tile to use (random-ish)
-					int32_t z = 1 + ((cnt2 / std::max<int32_t>(pnx * pny, 1)) ^ 341) % pMat->PXSGfxSize;
-					pny = (cnt2 / pnx) % pny; pnx = cnt2 % pnx;
-					// draw
-					Application.DDraw->ActivateBlitModulation((std::min)((fcWdtH - z) * 16, 255) << 24 | 0xffffff);
-					pMat->PXSFace.DrawX(cgo.Surface, fixtoi(pxp->x) + cgox + z * pMat->PXSGfxRt.tx / fcWdt, fixtoi(pxp->y) + cgoy + z * pMat->PXSGfxRt.ty / fcWdt, z, z * pMat->PXSFace.Hgt / fcWdt, pnx, pny);
-					Application.DDraw->DeactivateBlitModulation();
-				}
+			C4Material *pMat = &Game.Material.Map[Mat[cnt]];
+			if (!pMat->PXSFace.Surface)
+				continue;
+			// new-style: graphics
+			int32_t pnx, pny;
+			pMat->PXSFace.GetPhaseNum(pnx, pny);
+			int32_t fcWdt = pMat->PXSFace.Wdt; int32_t fcWdtH = (std::max)(fcWdt / 3, 1);
+			// calculate draw width and tile to use (random-ish)
+			const auto iTile = static_cast<int32_t>(cnt % PXSChunkSize);
+			int32_t z = 1 + ((iTile / std::max<int32_t>(pnx * pny, 1)) ^ 341) % pMat->PXSGfxSize;
+			pny = (iTile / pnx) % pny; pnx = iTile % pnx;
+			// draw
+			Application.DDraw->ActivateBlitModulation((std::min)((fcWdtH - z) * 16, 255) << 24 | 0xffffff);
+			pMat->PXSFace.DrawX(cgo.Surface, fixtoi(X[cnt]) + cgox + z * pMat->PXSGfxRt.tx / fcWdt, fixtoi(Y[cnt]) + cgoy + z * pMat->PXSGfxRt.ty / fcWdt, z, z * pMat->PXSFace.Hgt / fcWdt, pnx, pny);
+			Application.DDraw->DeactivateBlitModulation();
 		}
 }
 
@@ -317,14 +324,8 @@ void C4PXSSystem::Cast(int32_t mat, int32_t num, int32_t tx, int32_t ty, int32_t
 
 bool C4PXSSystem::Save(C4Group &hGroup)
 {
-	unsigned int cnt;
-
 	// Check used chunk count
-	int32_t iChunks = 0;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
-			iChunks++;
-	if (!iChunks)
+	if (std::ranges::none_of(Chunks, [](const ChunkInfo &Chunk) { return Chunk.Allocated && Chunk.PXSCount; }))
 	{
 		hGroup.Delete(C4CFN_PXS);
 		return true;
@@ -337,10 +338,21 @@ bool C4PXSSystem::Save(C4Group &hGroup)
 	int32_t iNumFormat = 1;
 	if (!hTempFile.Write(&iNumFormat, sizeof(iNumFormat)))
 		return false;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt]) // must save all chunks in order to keep order consistent on all clients
-			if (!hTempFile.Write(Chunk[cnt], PXSChunkSize * sizeof(C4PXS)))
+	std::vector<C4PXS> Chunk(PXSChunkSize);
+	for (size_t iChunk = 0; iChunk < Chunks.size(); iChunk++)
+		if (Chunks[iChunk].Allocated) // must save all chunks in order to keep order consistent on all clients
+		{
+			for (size_t cnt = 0; cnt < PXSChunkSize; cnt++)
+			{
+				const size_t iPXS = iChunk * PXSChunkSize + cnt;
+				C4PXS &pxs = Chunk[cnt];
+				pxs.Mat = Mat[iPXS];
+				pxs.x = X[iPXS]; pxs.y = Y[iPXS];
+				pxs.xdir = XDir[iPXS]; pxs.ydir = YDir[iPXS];
+			}
+			if (!hTempFile.Write(Chunk.data(), PXSChunkSize * sizeof(C4PXS)))
 				return false;
+		}
 
 	if (!hTempFile.Close())
 		return false;
@@ -356,7 +368,7 @@ bool C4PXSSystem::Save(C4Group &hGroup)
 bool C4PXSSystem::Load(C4Group &hGroup)
 {
 	// load new
-	size_t iBinSize, iChunkNum, cnt2;
+	size_t iBinSize, iChunkNum;
 	size_t iChunkSize = PXSChunkSize * sizeof(C4PXS);
 	if (!hGroup.AccessEntry(C4CFN_PXS, &iBinSize)) return false;
 	// clear previous
@@ -373,21 +385,25 @@ bool C4PXSSystem::Load(C4Group &hGroup)
 	else if (iBinSize % iChunkSize != 0) return false;
 	// calc chunk count
 	iChunkNum = iBinSize / iChunkSize;
-	if (iChunkNum > PXSMaxChunk) return false;
-	for (uint32_t cnt = 0; cnt < iChunkNum; cnt++)
+	SetChunkCount(iChunkNum);
+	std::vector<C4PXS> Chunk(PXSChunkSize);
+	for (size_t iChunk = 0; iChunk < iChunkNum; iChunk++)
 	{
-		Chunk[cnt] = new C4PXS[PXSChunkSize];
-		if (!hGroup.Read(Chunk[cnt], iChunkSize)) return false;
-		// count the PXS, Peter!
-		// convert num format, if neccessary
-		C4PXS *pxp; iChunkPXS[cnt] = 0;
-		for (cnt2 = 0, pxp = Chunk[cnt]; cnt2 < PXSChunkSize; cnt2++, pxp++)
-			if (pxp->Mat != MNone)
-			{
-				++iChunkPXS[cnt];
-				// convert number format
-				if (iNumForm == 2) { FLOAT_TO_FIXED(&pxp->x); FLOAT_TO_FIXED(&pxp->y); FLOAT_TO_FIXED(&pxp->xdir); FLOAT_TO_FIXED(&pxp->ydir); }
-			}
+		if (!hGroup.Read(Chunk.data(), iChunkSize)) return false;
+		Chunks[iChunk].Allocated = true;
+		for (size_t cnt = 0; cnt < PXSChunkSize; cnt++)
+		{
+			C4PXS &pxs = Chunk[cnt];
+			if (pxs.Mat == MNone) continue;
+			// count the PXS, Peter!
+			Chunks[iChunk].PXSCount++;
+			// convert number format
+			if (iNumForm == 2) { FLOAT_TO_FIXED(&pxs.x); FLOAT_TO_FIXED(&pxs.y); FLOAT_TO_FIXED(&pxs.xdir); FLOAT_TO_FIXED(&pxs.ydir); }
+			const size_t iPXS = iChunk * PXSChunkSize + cnt;
+			Mat[iPXS] = pxs.Mat;
+			X[iPXS] = pxs.x; Y[iPXS] = pxs.y;
+			XDir[iPXS] = pxs.xdir; YDir[iPXS] = pxs.ydir;
+		}
 	}
 	return true;
 }
@@ -400,32 +416,27 @@ void C4PXSSystem::Synchronize()
 void C4PXSSystem::SyncClearance()
 {
 	// consolidate chunks; remove empty chunks
-	C4PXS **pDestChunk = Chunk;
-	int32_t iDestChunk = 0;
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		if (Chunk[cnt] && iChunkPXS[cnt])
+	size_t iDestChunk = 0;
+	for (size_t iChunk = 0; iChunk < Chunks.size(); iChunk++)
+		if (Chunks[iChunk].Allocated && Chunks[iChunk].PXSCount)
 		{
-			*pDestChunk++ = Chunk[cnt];
-			iChunkPXS[iDestChunk++] = iChunkPXS[cnt];
-		}
-		else
-		{
-			delete[] Chunk[cnt];
-			Chunk[cnt] = nullptr;
+			if (iDestChunk != iChunk)
+			{
+				const size_t iFrom = iChunk * PXSChunkSize, iTo = iDestChunk * PXSChunkSize;
+				std::copy_n(Mat.begin() + iFrom, PXSChunkSize, Mat.begin() + iTo);
+				std::copy_n(X.begin() + iFrom, PXSChunkSize, X.begin() + iTo);
+				std::copy_n(Y.begin() + iFrom, PXSChunkSize, Y.begin() + iTo);
+				std::copy_n(XDir.begin() + iFrom, PXSChunkSize, XDir.begin() + iTo);
+				std::copy_n(YDir.begin() + iFrom, PXSChunkSize, YDir.begin() + iTo);
+				Chunks[iDestChunk] = Chunks[iChunk];
+			}
+			iDestChunk++;
 		}
-	}
-}
-
-void C4PXSSystem::Delete(C4PXS *pPXS)
-{
-	// find chunk
-	unsigned int cnt;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
-			if (pPXS >= Chunk[cnt] && pPXS < Chunk[cnt] + PXSChunkSize)
-				break;
-	// decrease pxs counter
-	if (cnt < PXSMaxChunk)
-		iChunkPXS[cnt]--;
+	SetChunkCount(iDestChunk);
+	FirstFree = 0;
+	// release memory of PXS that are gone
+	Mat.shrink_to_fit();
+	X.shrink_to_fit(); Y.shrink_to_fit();
+	XDir.shrink_to_fit(); YDir.shrink_to_fit();
+	Chunks.shrink_to_fit();
 }
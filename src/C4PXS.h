@@ -22,8 +22,13 @@
 #include <C4Material.h>
 #include "Fixed.h"
 
+#include <cstddef>
+#include <vector>
+
+// layout of a single PXS in PXS.c4b
 class C4PXS
 {
+public:
 	C4PXS() : Mat(MNone), x(Fix0), y(Fix0), xdir(Fix0), ydir(Fix0) {}
 
 	friend class C4PXSSystem;
@@ -31,13 +36,9 @@ class C4PXS
 protected:
 	int32_t Mat;
 	C4Fixed x, y, xdir, ydir;
-
-protected:
-	void Execute();
-	void Deactivate();
 };
 
-const size_t PXSChunkSize = 500, PXSMaxChunk = 20;
+const size_t PXSChunkSize = 500; // PXS per chunk in PXS.c4b
 
 class C4PXSSystem
 {
@@ -49,11 +50,28 @@ public:
 	int32_t Count;
 
 protected:
-	C4PXS *Chunk[PXSMaxChunk];
-	size_t iChunkPXS[PXSMaxChunk];
+	// all PXS slots, stored as separate arrays in chunks of PXSChunkSize; free slots have Mat == MNone
+	std::vector<int32_t> Mat;
+	std::vector<C4Fixed> X, Y, XDir, YDir;
+
+	struct ChunkInfo
+	{
+		bool Allocated{false}; // empty chunks are dropped when they are executed and created again by New()
+		size_t PXSCount{0};
+	};
+	std::vector<ChunkInfo> Chunks;
+	size_t FirstFree{0}; // there is no free slot before this one
+
+	// per-material values needed by every PXS, cached for the current frame
+	struct MatInfo
+	{
+		int32_t Density;
+		int32_t WindDrift;
+		bool AirReaction; // whether the material reacts with sky
+	};
+	std::vector<MatInfo> MatInfos;
 
 public:
-	void Delete(C4PXS *pPXS);
 	void Default();
 	void Clear();
 	void Execute();
@@ -66,5 +84,8 @@ public:
 	bool Save(C4Group &hGroup);
 
 protected:
-	C4PXS *New();
+	bool ExecutePXS(size_t iPXS); // returns false if the PXS has been deactivated
+	size_t New(); // returns the first free slot
+	void Delete(size_t iPXS);
+	void SetChunkCount(size_t iChunks);
 };
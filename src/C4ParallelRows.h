@@ -0,0 +1,64 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Splits the rows [0, height) into bands of bandHeight rows and calls renderBand(firstRow, rowCount) for each of them.
+// The bands are distributed over threadCount threads, one of which is the calling thread;
+// submitWorker is called for each additional thread with a callable that it has to run once, at any time - even after C4ParallelRows has returned.
+// Returns after all bands have been rendered. renderBand must only touch the rows it has been given.
+template<typename SubmitWorker, typename RenderBand>
+void C4ParallelRows(const std::int32_t height, const std::int32_t bandHeight, const std::int32_t threadCount, SubmitWorker &&submitWorker, RenderBand &&renderBand)
+{
+	if (height <= 0) return;
+	const std::int32_t bandCount{(height + bandHeight - 1) / bandHeight};
+	// shared with the workers, as they might only start after all bands are done
+	struct Counters
+	{
+		std::atomic<std::int32_t> NextBand{0};
+		std::atomic<std::int32_t> DoneBands{0};
+	};
+	const auto counters = std::make_shared<Counters>();
+	// bands are handed out in order, so neighbouring rows are likely rendered by the same thread
+	// a band can only be taken while the calling thread still waits for it, so renderBand is alive whenever it is called
+	const auto renderBands = [counters, height, bandHeight, bandCount, render = &renderBand]
+	{
+		for (std::int32_t band; (band = counters->NextBand.fetch_add(1, std::memory_order_relaxed)) < bandCount; )
+		{
+			const std::int32_t firstRow{band * bandHeight};
+			(*render)(firstRow, std::min(bandHeight, height - firstRow));
+			if (counters->DoneBands.fetch_add(1, std::memory_order_acq_rel) + 1 == bandCount)
+			{
+				counters->DoneBands.notify_all();
+			}
+		}
+	};
+
+	const std::int32_t workerCount{std::clamp(threadCount - 1, 0, bandCount - 1)};
+	for (std::int32_t i{0}; i < workerCount; ++i)
+	{
+		submitWorker(renderBands);
+	}
+	renderBands();
+	for (std::int32_t done; (done = counters->DoneBands.load(std::memory_order_acquire)) != bandCount; )
+	{
+		counters->DoneBands.wait(done, std::memory_order_acquire);
+	}
+}
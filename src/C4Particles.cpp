@@ -26,6 +26,12 @@
 #include <C4Game.h>
 #include <C4Components.h>
 #include <C4Wrappers.h>
+#include "C4ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
 
 void C4ParticleDefCore::CompileFunc(StdCompiler *pComp)
 {
@@ -518,6 +524,103 @@ int32_t C4ParticleSystem::Push(C4ParticleDef *pOfDef, float dxdir, float dydir)
 	return iNumPushed;
 }
 
+bool C4ParticleSystem::ExecutesObjectParticles() const
+{
+	return Config.Graphics.ParallelParticles && C4ThreadPool::Global;
+}
+
+void C4ParticleSystem::Execute()
+{
+	if (ExecutesObjectParticles())
+		ExecuteParallel();
+	else
+		GlobalParticles.Exec();
+}
+
+void C4ParticleSystem::ExecuteParallel()
+{
+	// Particles are not synchronized, but script creates them and changes the landscape
+	// while objects are executed. So all particles are executed here, after the objects,
+	// while the main thread waits for the jobs and nothing else modifies the game.
+	// Exec procs only change their own particle; list changes are done afterwards.
+	std::size_t jobCount{0};
+	const auto addJobs = [this, &jobCount](C4ParticleList &list, C4Object *const obj)
+	{
+		int32_t count{0};
+		for (C4Particle *pPrt = list.pFirst; pPrt; pPrt = pPrt->pNext)
+		{
+			if (!count)
+			{
+				if (jobCount == ExecJobs.size()) ExecJobs.emplace_back();
+				ExecJob &job{ExecJobs[jobCount++]};
+				job.List = &list;
+				job.Obj = obj;
+				job.First = pPrt;
+				job.Count = 0;
+				job.Dead.clear();
+			}
+			++ExecJobs[jobCount - 1].Count;
+			if (++count == C4Px_BufSize) count = 0;
+		}
+	};
+
+	addJobs(GlobalParticles, nullptr);
+	for (C4ObjectLink *pLnk = Game.Objects.First; pLnk; pLnk = pLnk->Next)
+	{
+		C4Object *const pObj{pLnk->Obj};
+		if (!pObj->Status) continue;
+		addJobs(pObj->BackParticles, pObj);
+		addJobs(pObj->FrontParticles, pObj);
+	}
+	if (!jobCount) return;
+
+	// the main thread takes part, so a single job needs no workers
+	// it only waits for the jobs to be done, not for busy pool threads to pick up their task
+	const auto counters = std::make_shared<ExecJobCounters>();
+	const std::size_t workerCount{std::min<std::size_t>(jobCount - 1, std::max(std::thread::hardware_concurrency(), 2u) - 1)};
+	for (std::size_t i{0}; i < workerCount; ++i)
+	{
+		C4ThreadPool::Global->SubmitCallback([this, counters, jobCount]
+		{
+			RunExecJobs(*counters, jobCount);
+		});
+	}
+	RunExecJobs(*counters, jobCount);
+	for (std::size_t done; (done = counters->Done.load(std::memory_order_acquire)) != jobCount; )
+	{
+		counters->Done.wait(done, std::memory_order_acquire);
+	}
+
+	// sorry, life is over for you :P
+	for (std::size_t i{0}; i < jobCount; ++i)
+	{
+		ExecJob &job{ExecJobs[i]};
+		for (C4Particle *const pPrt : job.Dead)
+		{
+			--pPrt->pDef->Count;
+			pPrt->MoveList(*job.List, FreeParticles);
+		}
+	}
+}
+
+void C4ParticleSystem::RunExecJobs(ExecJobCounters &counters, const std::size_t jobCount)
+{
+	// a job can only be taken while ExecuteParallel waits for it
+	for (std::size_t i; (i = counters.Next.fetch_add(1, std::memory_order_relaxed)) < jobCount; )
+	{
+		ExecJob &job{ExecJobs[i]};
+		C4Particle *pPrt{job.First};
+		for (int32_t n{0}; n < job.Count; ++n, pPrt = pPrt->pNext)
+		{
+			if (!pPrt->pDef->ExecProc(pPrt, job.Obj)) job.Dead.push_back(pPrt);
+		}
+		if (counters.Done.fetch_add(1, std::memory_order_acq_rel) + 1 == jobCount)
+		{
+			counters.Done.notify_all();
+		}
+	}
+}
+
 bool fxSmokeInit(C4Particle *pPrt, C4Object *pTarget)
 {
 	// init lifetime
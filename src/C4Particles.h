@@ -33,6 +33,10 @@
 #include <C4Group.h>
 #include <C4Shape.h>
 
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
 // class predefs
 class C4ParticleDefCore;
 class C4ParticleDef;
@@ -178,6 +182,27 @@ protected:
 	C4ParticleProc GetProc(const char *szName); // get init/exec proc for a particle type
 	C4ParticleDrawProc GetDrawProc(const char *szName); // get draw proc for a particle type
 
+	// a run of particles of one list executed by a single thread
+	struct ExecJob
+	{
+		C4ParticleList *List;
+		C4Object *Obj;
+		C4Particle *First;
+		int32_t Count;
+		std::vector<C4Particle *> Dead; // particles whose exec proc failed; removed after all jobs are done
+	};
+	std::vector<ExecJob> ExecJobs; // kept across frames to reuse the allocations
+
+	// shared with the pool threads; workers that start after all jobs have been taken only touch these
+	struct ExecJobCounters
+	{
+		std::atomic<std::size_t> Next{0}; // next job to take
+		std::atomic<std::size_t> Done{0}; // jobs finished
+	};
+
+	void ExecuteParallel();
+	void RunExecJobs(ExecJobCounters &counters, std::size_t jobCount); // take and execute jobs until none are left
+
 public:
 	C4ParticleList FreeParticles; // list of free particles
 	C4ParticleList GlobalParticles; // list of free particles
@@ -208,6 +233,9 @@ public:
 
 	int32_t Push(C4ParticleDef *pOfDef, float dxdir, float dydir); // add movement to all particles of type
 
+	void Execute(); // execute global particles and, if ExecutesObjectParticles(), the particles of all objects
+	bool ExecutesObjectParticles() const; // whether object particles are executed here instead of in C4Object::Execute
+
 	bool IsFireParticleLoaded() { return pFire1 && pFire2; }
 
 	friend class C4ParticleDef;
@@ -20,6 +20,7 @@
 #include <C4Include.h>
 #include <C4Record.h>
 
+#include <C4Application.h>
 #include <C4Console.h>
 #include <C4PlayerInfo.h>
 #include <C4GameSave.h>
@@ -29,7 +30,10 @@
 
 #include <StdFile.h>
 
+#include <algorithm>
 #include <format>
+#include <iterator>
+#include <string>
 
 #define IMMEDIATEREC
 
@@ -91,6 +95,7 @@ void C4RecordChunk::Delete()
 	case RCT_End:                                        break;
 	case RCT_Frame:                                      break;
 	case RCT_File:    delete pFileData;                  break;
+	case RCT_Keyframe: delete pFileData; pFileData = nullptr; break;
 	default:          delete pDbg;      pDbg  = nullptr; break;
 	}
 }
@@ -106,6 +111,7 @@ void C4RecordChunk::CompileFunc(StdCompiler *pComp)
 	case RCT_End: break;
 	case RCT_Frame: break;
 	case RCT_File: pComp->Value(Filename); pComp->Value(mkPtrAdaptNoNull(pFileData)); break;
+	case RCT_Keyframe: pComp->Value(mkPtrAdaptNoNull(pFileData)); break;
 	default: pComp->Value(mkPtrAdaptNoNull(pDbg)); break;
 	}
 }
@@ -171,6 +177,7 @@ bool C4Record::Start(bool fInitial)
 	fStreaming = false;
 	fRecording = true;
 	iLastFrame = 0;
+	iLastKeyframe = Game.FrameCounter;
 	return true;
 }
 
@@ -257,12 +264,47 @@ bool C4Record::Rec(uint32_t iFrame, const StdBuf &sBuf, C4RecordChunkType eType)
 	// immediate rec: always flush
 	CtrlRec.Flush();
 #endif
-	// Stream
+	// Stream; keyframes are left out, because stream records are reconstructed from their start anyway
 	if (fStreaming)
-		Stream(Head, sBuf);
+	{
+		if (eType == RCT_Keyframe)
+			Stream({Head.iFrm, RCT_Frame}, StdBuf());
+		else
+			Stream(Head, sBuf);
+	}
 	return true;
 }
 
+bool C4Record::IsKeyframeDue(const int32_t iFrame) const
+{
+#ifdef DEBUGREC
+	// saving the game state would add debugrecs that the replay does not contain
+	return false;
+#else
+	return fRecording && Config.General.RecordKeyframeInterval > 0 && iFrame - iLastKeyframe >= Config.General.RecordKeyframeInterval;
+#endif
+}
+
+bool C4Record::RecKeyframe(const int32_t iFrame)
+{
+	if (!fRecording) return false;
+	iLastKeyframe = iFrame;
+
+	// save the game state without scenario; it is merged into a copy of the record when seeking
+	StdStrBuf sTempFilename(sFilename);
+	MakeTempFilename(&sTempFilename);
+	C4GameSaveRecord saveRec(false, Index, Game.Parameters.isLeague(), false);
+	if (!saveRec.Save(sTempFilename.getData())) return false;
+	saveRec.Close();
+
+	// the saved group is packed already
+	StdBuf Keyframe;
+	const bool fLoaded = Keyframe.LoadFromFile(sTempFilename.getData());
+	EraseItem(sTempFilename.getData());
+	if (!fLoaded) return false;
+	return Rec(iFrame, DecompileToBuf<StdCompilerBinWrite>(Keyframe), RCT_Keyframe);
+}
+
 void C4Record::Stream(const C4RecordChunkHead &Head, const StdBuf &sBuf)
 {
 	if (!fStreaming) return;
@@ -377,7 +419,7 @@ bool C4Record::StreamFile(const char *szLocalFilename, const char *szAddAs)
 }
 
 // set defaults
-C4Playback::C4Playback(std::shared_ptr<spdlog::logger> logger) : logger{std::move(logger)}, Finished(true),fLoadSequential(false)
+C4Playback::C4Playback(std::shared_ptr<spdlog::logger> logger) : logger{std::move(logger)}, Finished(true),fLoadSequential(false), iSeekFrame(-1)
 {
 #ifdef DEBUGREC
 	loggerDebugRec = logger->clone("DbgRec");
@@ -457,6 +499,18 @@ bool C4Playback::Open(C4Group &rGrp)
 	// reset status
 	currChunk = chunks.begin();
 	Finished = false;
+	// restarted at a keyframe for seeking?
+	if (Game.ReplaySeekFrame >= 0)
+	{
+		iSeekFrame = Game.ReplaySeekFrame;
+		Game.ReplaySeekFrame = -1;
+		StartAtKeyframe(Game.FrameCounter);
+		// the copy written for seeking is removed with the game
+		if (!ItemIdentical(Game.ReplaySeekOrigin.getData(), Game.ScenarioFilename))
+			Game.TempScenarioFile = true;
+	}
+	else
+		Game.ReplaySeekOrigin.Clear();
 	// external debugrec file
 #if defined(DEBUGREC_EXTFILE) && defined(DEBUGREC)
 #ifdef DEBUGREC_EXTFILE_WRITE
@@ -528,6 +582,9 @@ bool C4Playback::ReadBinary(const StdBuf &Buf)
 				Compiler.Value(c.Filename);
 				Compiler.Value(mkPtrAdaptNoNull(c.pFileData));
 				break;
+			case RCT_Keyframe:
+				Compiler.Value(mkPtrAdaptNoNull(c.pFileData));
+				break;
 			default:
 				// debugrec
 				if (pHead->Type >= 0x80)
@@ -652,6 +709,9 @@ StdBuf C4Playback::ReWriteBinary()
 			case RCT_End:
 				fFinished = true;
 				break;
+			case RCT_Keyframe:
+				Chunk = DecompileToBuf<StdCompilerBinWrite>(*i->pFileData);
+				break;
 			default: // debugrec
 				if (i->pDbg)
 					Chunk = DecompileToBuf<StdCompilerBinWrite>(*i->pDbg);
@@ -787,6 +847,7 @@ void C4Playback::Strip()
 		}
 		break;
 		case RCT_End:
+		case RCT_Keyframe:
 			i++;
 			break;
 		default:
@@ -807,6 +868,8 @@ bool C4Playback::ExecuteControl(C4Control *pCtrl, int iFrame)
 	// still playbacking?
 	if (currChunk == chunks.end()) return false;
 	if (Finished) { Finish(); return false; }
+	// seeking?
+	if (iSeekFrame >= 0) FastForward(iFrame);
 #ifdef DEBUGREC
 	if (DebugRec.firstPkt())
 		DebugRecError("Debug rec overflow!");
@@ -834,6 +897,10 @@ bool C4Playback::ExecuteControl(C4Control *pCtrl, int iFrame)
 			Finished = true;
 			break;
 
+		case RCT_Keyframe:
+			// only needed for seeking
+			break;
+
 #ifdef DEBUGREC
 		default: // expect it to be debug rec
 			// append to debug rec buffer
@@ -852,8 +919,135 @@ bool C4Playback::ExecuteControl(C4Control *pCtrl, int iFrame)
 	return true;
 }
 
+bool C4Playback::Seek(const int32_t iFrame)
+{
+	if (iFrame < 0 || Finished) return false;
+	// without a later keyframe to skip to, fast forwarding from here is fastest
+	const chunks_t::iterator keyframe = FindKeyframe(iFrame);
+	if (iFrame >= Game.FrameCounter && (keyframe == chunks.end() || keyframe->Frame <= Game.FrameCounter))
+	{
+		logger->info("Seeking to frame {}", iFrame);
+		iSeekFrame = iFrame;
+		Application.NextTick(false);
+		return true;
+	}
+
+	// otherwise, the replay is restarted at the keyframe or at the start of the record
+	const std::string origin{Game.ReplaySeekOrigin ? Game.ReplaySeekOrigin.getData() : Game.ScenarioFilename};
+	StdStrBuf sScenario;
+	if (keyframe == chunks.end())
+	{
+		logger->info("Seeking to frame {} from the start of the record", iFrame);
+		sScenario.Copy(origin.c_str());
+	}
+	else
+	{
+		logger->info("Seeking to frame {} from the keyframe at frame {}", iFrame, keyframe->Frame);
+		if (!WriteKeyframeScenario(origin.c_str(), *keyframe->pFileData, sScenario))
+		{
+			logger->error("Could not restore the keyframe at frame {}", keyframe->Frame);
+			return false;
+		}
+	}
+	Game.ReplaySeekOrigin.Copy(origin.c_str());
+	Game.ReplaySeekFrame = iFrame;
+	Application.SetNextMission(sScenario.getData());
+	// this deletes the playback
+	Game.Abort(true);
+	return true;
+}
+
+C4Playback::chunks_t::iterator C4Playback::FindKeyframe(const int32_t iFrame)
+{
+	// only chunks in memory are searched; sequential reading only ever holds the next few chunks
+	chunks_t::iterator keyframe = chunks.end();
+	for (chunks_t::iterator i = chunks.begin(); i != chunks.end() && i->Frame <= iFrame; ++i)
+		if (i->Type == RCT_Keyframe)
+			keyframe = i;
+	return keyframe;
+}
+
+void C4Playback::StartAtKeyframe(const int32_t iFrame)
+{
+	// restarted at the start of the record?
+	const chunks_t::iterator keyframe = std::find_if(chunks.begin(), chunks.end(),
+		[iFrame](const C4RecordChunk &chunk) { return chunk.Type == RCT_Keyframe && chunk.Frame == iFrame; });
+	if (keyframe == chunks.end()) return;
+	currChunk = std::next(keyframe);
+
+	// The keyframe has been saved while the control of its frame was executed. Only the
+	// packets after the synchronization are left to execute; everything else is already
+	// contained in the keyframe.
+	if (keyframe == chunks.begin()) return;
+	const chunks_t::iterator ctrl = std::prev(keyframe);
+	if (ctrl->Type != RCT_Ctrl || ctrl->Frame != iFrame) return;
+	C4Control &rCtrl = *ctrl->pCtrl;
+	C4IDPacket *pSync = rCtrl.firstPkt();
+	while (pSync && pSync->getPktType() != CID_Synchronize) pSync = rCtrl.nextPkt(pSync);
+	if (!pSync) return;
+	for (C4IDPacket *pPkt = rCtrl.firstPkt(), *pNext; pPkt; pPkt = pNext)
+	{
+		pNext = pPkt == pSync ? nullptr : rCtrl.nextPkt(pPkt);
+		rCtrl.Delete(pPkt);
+	}
+	if (rCtrl.firstPkt()) currChunk = ctrl;
+}
+
+bool C4Playback::WriteKeyframeScenario(const char *szOrigin, const StdBuf &Keyframe, StdStrBuf &rsFilename)
+{
+	// unpack keyframe savegame
+	StdStrBuf sKeyframe;
+	sKeyframe.Copy(Config.AtTempPath("Keyframe.tmp"));
+	MakeTempFilename(&sKeyframe);
+	if (!Keyframe.SaveToFile(sKeyframe.getData()) || !C4Group_UnpackDirectory(sKeyframe.getData()))
+	{
+		EraseItem(sKeyframe.getData());
+		return false;
+	}
+
+	// merge it into a copy of the record, like StreamToRecord does with the initial data
+	// the whole control record is kept, so the replay can seek again from there
+	for (int32_t i = 0; ; ++i)
+	{
+		rsFilename.Copy(Config.AtTempPath(std::format("ReplaySeek{}.c4s", i).c_str()));
+		if (!ItemExists(rsFilename.getData())) break;
+	}
+	C4Group Grp;
+	bool fSuccess = C4Group_CopyItem(szOrigin, rsFilename.getData()) &&
+		Grp.Open(rsFilename.getData()) &&
+		Grp.Merge(sKeyframe.getData()) &&
+		Grp.Close();
+	EraseItem(sKeyframe.getData());
+	// packed records are read as a whole, which StartAtKeyframe relies on
+	if (fSuccess && DirectoryExists(rsFilename.getData()))
+		fSuccess = C4Group_PackDirectory(rsFilename.getData());
+	if (!fSuccess) EraseItem(rsFilename.getData());
+	return fSuccess;
+}
+
+void C4Playback::FastForward(const int32_t iFrame)
+{
+	if (iFrame < iSeekFrame)
+	{
+		Game.FullSpeed = true;
+		Game.FrameSkip = 100;
+		return;
+	}
+	// target reached: back to normal speed
+	Game.FullSpeed = false;
+	Game.FrameSkip = 1;
+	iSeekFrame = -1;
+	logger->info("Reached frame {}", iFrame);
+}
+
 void C4Playback::Finish()
 {
+	// replay benchmark: report and quit
+	if (Game.Benchmark.IsRunning())
+	{
+		Game.Benchmark.Finish();
+		return;
+	}
 	Clear();
 	// finished playback: end game
 	if (Console.Active)
@@ -895,6 +1089,7 @@ const char *GetRecordChunkTypeName(C4RecordChunkType eType)
 	case RCT_Ctrl:    return "Ctrl"; // control
 	case RCT_CtrlPkt: return "CtrlPkt"; // control packet
 	case RCT_Frame:   return "Frame"; // beginning frame
+	case RCT_Keyframe: return "Keyframe"; // packed savegame
 	case RCT_End:     return "End"; // --- the end ---
 	case RCT_Log:     return "Log"; // log message
 	case RCT_File:    return "File"; // file data
@@ -57,6 +57,7 @@ enum C4RecordChunkType // record file chunk type
 	RCT_Ctrl    = 0x00, // control
 	RCT_CtrlPkt = 0x01, // control packet
 	RCT_Frame   = 0x02, // beginning frame
+	RCT_Keyframe = 0x03, // packed savegame of the synchronized game state
 	RCT_End     = 0x10, // --- the end ---
 	RCT_Log     = 0x20, // log message
 	// Streaming
@@ -120,7 +121,7 @@ struct C4RecordChunk
 		C4Control *pCtrl;
 		C4IDPacket *pPkt;
 		class C4PktDebugRec *pDbg;
-		class StdBuf *pFileData;
+		class StdBuf *pFileData; // RCT_File and RCT_Keyframe
 	};
 	StdStrBuf Filename; // RCT_File only
 
@@ -258,6 +259,7 @@ private:
 	C4Group RecordGrp; // record scenario group
 	bool fRecording; // set if recording is active
 	uint32_t iLastFrame; // frame of last chunk written
+	int32_t iLastKeyframe; // frame of last keyframe written or of the record start
 	bool fStreaming; // perdiodically sent new control to server
 	unsigned int iStreamingPos; // Position of current buffer in stream
 	StdBuf StreamingData; // accumulated control data since last stream sync
@@ -277,6 +279,9 @@ public:
 	bool Rec(C4PacketType eCtrlType, C4ControlPacket *pCtrl, int iFrame); // record control packet
 	bool Rec(uint32_t iFrame, const StdBuf &sBuf, C4RecordChunkType eType);
 
+	bool IsKeyframeDue(int32_t iFrame) const;
+	bool RecKeyframe(int32_t iFrame); // record the current game state; must be called while the game is synchronized
+
 	bool AddFile(const char *szLocalFilename, const char *szAddAs, bool fDelete = false);
 
 	bool StartStreaming(bool fInitial);
@@ -301,7 +306,12 @@ private:
 	bool fLoadSequential; // used for debugrecs: Sequential reading of files
 	StdBuf sequentialBuffer; // buffer to manage sequential reads
 	uint32_t iLastSequentialFrame; // frame number of last chunk read
+	int32_t iSeekFrame; // frame to fast forward to; -1 if not seeking
 	void Finish(); // end playback
+	chunks_t::iterator FindKeyframe(int32_t iFrame); // latest keyframe at or before the given frame
+	void StartAtKeyframe(int32_t iFrame); // skip chunks that are contained in the keyframe the game has been loaded from
+	bool WriteKeyframeScenario(const char *szOrigin, const StdBuf &Keyframe, StdStrBuf &rsFilename);
+	void FastForward(int32_t iFrame);
 #ifdef DEBUGREC
 	std::shared_ptr<spdlog::logger> loggerDebugRec;
 	C4PacketList DebugRec;
@@ -320,6 +330,7 @@ public:
 	StdBuf ReWriteBinary();
 	void Strip();
 	bool ExecuteControl(C4Control *pCtrl, int iFrame); // assign control
+	bool Seek(int32_t iFrame); // restart at the nearest keyframe if necessary and fast forward to the given frame
 	void Clear();
 #ifdef DEBUGREC
 	void Check(C4RecordChunkType eType, const uint8_t *pData, int iSize); // compare with debugrec
@@ -1110,8 +1110,7 @@ static bool FnSetActionTargets(C4AulContext *cthr, C4Object *pTarget1, C4Object
 	// safety
 	if (!pObj) pObj = cthr->Obj; if (!pObj) return false;
 	// set targets
-	pObj->Action.Target = pTarget1;
-	pObj->Action.Target2 = pTarget2;
+	pObj->SetActionTargets(pTarget1, pTarget2);
 	return true;
 }
 
@@ -1447,7 +1446,12 @@ static bool FnCreateMenu(C4AulContext *cthr, C4ID iSymbol, C4Object *pMenuObj, C
 
 	// Clear any old menu, init new menu
 	if (!pMenuObj->CloseMenu(false)) return false;
-	if (!pMenuObj->Menu) pMenuObj->Menu = new C4ObjectMenu; else pMenuObj->Menu->ClearItems(true);
+	if (!pMenuObj->Menu)
+	{
+		pMenuObj->Menu = new C4ObjectMenu;
+		Game.Objects.AddMenuObject(pMenuObj);
+	}
+	else pMenuObj->Menu->ClearItems(true);
 	pMenuObj->Menu->Init(fctSymbol, FnStringPar(szCaption), pCommandObj, iExtra, iExtraData, idMenuID ? idMenuID : iSymbol, iStyle, true);
 
 	// Set permanent
@@ -1985,102 +1989,43 @@ static C4Object *FnFindBase(C4AulContext *cthr, C4ValueInt iOwner, C4ValueInt iI
 	return Game.FindBase(iOwner, iIndex);
 }
 
-C4FindObject *CreateCriterionsFromPars(const C4Value *pPars, C4FindObject **pFOs, C4SortObject **pSOs)
+static const C4AulBCC *GetCallSite(C4AulContext *cthr)
 {
-	int i, iCnt = 0, iSortCnt = 0;
-	// Read all parameters
-	for (i = 0; i < C4AUL_MAX_Par; i++)
-	{
-		const C4Value &Data = pPars[i].GetRefVal();
-		// No data given?
-		if (!Data) break;
-		// Construct
-		C4SortObject *pSO = nullptr;
-		C4FindObject *pFO = C4FindObject::CreateByValue(Data, pSOs ? &pSO : nullptr);
-		// Add FindObject
-		if (pFO)
-		{
-			pFOs[iCnt++] = pFO;
-		}
-		// Add SortObject
-		if (pSO)
-		{
-			pSOs[iSortCnt++] = pSO;
-		}
-	}
-	// No criterions?
-	if (!iCnt)
-	{
-		for (i = 0; i < iSortCnt; ++i) delete pSOs[i];
-		return nullptr;
-	}
-	// create sort criterion
-	C4SortObject *pSO = nullptr;
-	if (iSortCnt)
-	{
-		if (iSortCnt == 1)
-			pSO = pSOs[0];
-		else
-			pSO = new C4SortObjectMultiple(iSortCnt, pSOs, false);
-	}
-	// Create search object
-	C4FindObject *pFO;
-	if (iCnt == 1)
-		pFO = pFOs[0];
-	else
-		pFO = new C4FindObjectAnd(iCnt, pFOs, false);
-	if (pSO) pFO->SetSort(pSO);
-	return pFO;
+	// position of the calling bytecode, nullptr if not called by script
+	return cthr->Caller ? cthr->Caller->CPos : nullptr;
 }
 
 static C4Value FnObjectCount2(C4AulContext *cthr, const C4Value *pPars)
 {
-	// Create FindObject-structure
-	C4FindObject *pFOs[C4AUL_MAX_Par];
-	C4FindObject *pFO = CreateCriterionsFromPars(pPars, pFOs, nullptr);
+	// Get FindObject-structure
+	const auto pFO = Game.FindObjectPlans.Acquire(GetCallSite(cthr), pPars, false);
 	// Error?
 	if (!pFO)
 		throw C4AulExecError(cthr->Obj, "ObjectCount: No valid search criterions supplied!");
 	// Search
-	int32_t iCnt = pFO->Count(Game.Objects, Game.Objects.Sectors);
-	// Free
-	delete pFO;
-	// Return
-	return C4VInt(iCnt);
+	return C4VInt(pFO->Count(Game.Objects, Game.Objects.Sectors));
 }
 
 static C4Value FnFindObject2(C4AulContext *cthr, const C4Value *pPars)
 {
-	// Create FindObject-structure
-	C4FindObject *pFOs[C4AUL_MAX_Par];
-	C4SortObject *pSOs[C4AUL_MAX_Par];
-	C4FindObject *pFO = CreateCriterionsFromPars(pPars, pFOs, pSOs);
+	// Get FindObject-structure
+	const auto pFO = Game.FindObjectPlans.Acquire(GetCallSite(cthr), pPars, true);
 	// Error?
 	if (!pFO)
 		throw C4AulExecError(cthr->Obj, "FindObject: No valid search criterions supplied!");
 	// Search
-	C4Object *pObj = pFO->Find(Game.Objects, Game.Objects.Sectors);
-	// Free
-	delete pFO;
-	// Return
-	return C4VObj(pObj);
+	return C4VObj(pFO->Find(Game.Objects, Game.Objects.Sectors));
 }
 
 static C4Value FnFindObjects(C4AulContext *cthr, const C4Value *pPars)
 {
-	// Create FindObject-structure
-	C4FindObject *pFOs[C4AUL_MAX_Par];
-	C4SortObject *pSOs[C4AUL_MAX_Par];
-	C4FindObject *pFO = CreateCriterionsFromPars(pPars, pFOs, pSOs);
+	// Get FindObject-structure
+	const auto pFO = Game.FindObjectPlans.Acquire(GetCallSite(cthr), pPars, true);
 	// Error?
 	if (!pFO)
 		throw C4AulExecError(cthr->Obj, "FindObjects: No valid search criterions supplied!");
 	// Search
-	C4ValueArray *pResult = pFO->FindMany(Game.Objects, Game.Objects.Sectors);
-	// Free
-	delete pFO;
-	// Return
-	return C4VArray(pResult);
+	return C4VArray(pFO->FindMany(Game.Objects, Game.Objects.Sectors));
 }
 
 static C4ValueInt FnObjectCount(C4AulContext *cthr, C4ID id, C4ValueInt x, C4ValueInt y, C4ValueInt wdt, C4ValueInt hgt, C4ValueInt dwOCF, C4String *szAction, C4Object *pActionTarget, C4Value vContainer, C4ValueInt iOwner)
@@ -4395,6 +4340,7 @@ static bool FnSetGraphics(C4AulContext *pCtx, C4String *pGfxName, C4Object *pObj
 		}
 		// adding/setting
 		C4GraphicsOverlay *pOverlay = pObj->GetGraphicsOverlay(iOverlayID, true);
+		C4Object *const pOldOverlayObject{pOverlay->GetOverlayObject()};
 		switch (iOverlayMode)
 		{
 		case C4GraphicsOverlay::MODE_Base:
@@ -4416,6 +4362,7 @@ static bool FnSetGraphics(C4AulContext *pCtx, C4String *pGfxName, C4Object *pObj
 		case C4GraphicsOverlay::MODE_Object:
 			if (pOverlayObject && !pOverlayObject->Status) pOverlayObject = nullptr;
 			pOverlay->SetAsObject(pOverlayObject, dwBlitMode);
+			pObj->RegisterReference(pOverlayObject);
 			break;
 
 		case C4GraphicsOverlay::MODE_ExtraGraphics:
@@ -4427,6 +4374,7 @@ static bool FnSetGraphics(C4AulContext *pCtx, C4String *pGfxName, C4Object *pObj
 			pOverlay->SetAsBase(nullptr, 0); // make invalid, so it will be removed
 			break;
 		}
+		pObj->ReleaseReference(pOldOverlayObject);
 		// remove if invalid
 		if (!pOverlay->IsValid(pObj))
 		{
@@ -5121,8 +5069,8 @@ static bool FnFightWith(C4AulContext *ctx, C4Object *pTarget, C4Object *pClonk)
 	// check OCF
 	if (~(pTarget->OCF & pClonk->OCF) & OCF_FightReady) return false;
 	// RejectFight callback
-	if (pTarget->Call(PSF_RejectFight, {C4VObj(pTarget)}, true).getBool()) return false;
-	if (pClonk->Call(PSF_RejectFight, {C4VObj(pClonk)}, true).getBool()) return false;
+	if (pTarget->Call(PSFSlot_RejectFight, {C4VObj(pTarget)}, true).getBool()) return false;
+	if (pClonk->Call(PSFSlot_RejectFight, {C4VObj(pClonk)}, true).getBool()) return false;
 	// begin fighting
 	ObjectActionFight(pClonk, pTarget);
 	ObjectActionFight(pTarget, pClonk);
@@ -5170,11 +5118,19 @@ static bool FnSetObjectLayer(C4AulContext *ctx, C4Object *pNewLayer, C4Object *p
 	// local call/safety
 	if (!pObj) if (!(pObj = ctx->Obj)) return false;
 	// set layer object
+	C4Object *pOldLayer = pObj->pLayer;
 	pObj->pLayer = pNewLayer;
+	pObj->RegisterReference(pNewLayer);
+	pObj->ReleaseReference(pOldLayer);
 	// set for all contents as well
 	for (C4ObjectLink *pLnk = pObj->Contents.First; pLnk; pLnk = pLnk->Next)
 		if ((pObj = pLnk->Obj) && pObj->Status)
+		{
+			pOldLayer = pObj->pLayer;
 			pObj->pLayer = pNewLayer;
+			pObj->RegisterReference(pNewLayer);
+			pObj->ReleaseReference(pOldLayer);
+		}
 	// success
 	return true;
 }
@@ -20,6 +20,8 @@
 
 #include "C4Value.h"
 
+#include <iterator>
+
 class C4AulScriptEngine;
 
 // ** a definition of a script constant
@@ -122,6 +124,107 @@ void InitFunctionMap(C4AulScriptEngine *pEngine); // add functions to engine
 #define PSF_OnTeamSwitch           "~OnTeamSwitch" // int iPlr1, int idNewTeam, int idOldTeam
 #define PSF_OnOwnerRemoved         "~OnOwnerRemoved"
 
+// Engine-Calls into object scripts that are resolved once per definition when linking
+// (see C4DefScriptHost::AfterLink), so C4Object::Call does not need to look them up by name.
+// Only failsafe calls are listed here; the order must match PSFSlotFunctions.
+enum C4PSFSlot
+{
+	PSFSlot_Hit,
+	PSFSlot_Hit2,
+	PSFSlot_Hit3,
+	PSFSlot_Grab,
+	PSFSlot_Grabbed,
+	PSFSlot_RejectGrabbed,
+	PSFSlot_GrabLost,
+	PSFSlot_Get,
+	PSFSlot_Put,
+	PSFSlot_Collection,
+	PSFSlot_Collection2,
+	PSFSlot_RejectCollection,
+	PSFSlot_Ejection,
+	PSFSlot_Entrance,
+	PSFSlot_Departure,
+	PSFSlot_RejectEntrance,
+	PSFSlot_ContentsDestruction,
+	PSFSlot_Completion,
+	PSFSlot_Damage,
+	PSFSlot_Incineration,
+	PSFSlot_IncinerationEx,
+	PSFSlot_Death,
+	PSFSlot_ActivateEntrance,
+	PSFSlot_LiftTop,
+	PSFSlot_ControlUpdate,
+	PSFSlot_ContainedControlUpdate,
+	PSFSlot_ControlCommand,
+	PSFSlot_ControlCommandFinished,
+	PSFSlot_DeepBreath,
+	PSFSlot_CatchBlow,
+	PSFSlot_QueryCatchBlow,
+	PSFSlot_Stuck,
+	PSFSlot_RejectContents,
+	PSFSlot_LineBreak,
+	PSFSlot_UpdateTransferZone,
+	PSFSlot_RejectFight,
+	PSFSlot_AttachTargetLost,
+	PSFSlot_OnActionJump,
+	PSFSlot_ContactLeft,
+	PSFSlot_ContactRight,
+	PSFSlot_ContactTop,
+	PSFSlot_ContactBottom,
+	PSFSlot_ContactCenter,
+	PSFSlot_Count
+};
+
+inline constexpr const char *PSFSlotFunctions[]
+{
+	PSF_Hit,
+	PSF_Hit2,
+	PSF_Hit3,
+	PSF_Grab,
+	PSF_Grabbed,
+	PSF_RejectGrabbed,
+	PSF_GrabLost,
+	PSF_Get,
+	PSF_Put,
+	PSF_Collection,
+	PSF_Collection2,
+	PSF_RejectCollection,
+	PSF_Ejection,
+	PSF_Entrance,
+	PSF_Departure,
+	PSF_RejectEntrance,
+	PSF_ContentsDestruction,
+	PSF_Completion,
+	PSF_Damage,
+	PSF_Incineration,
+	PSF_IncinerationEx,
+	PSF_Death,
+	PSF_ActivateEntrance,
+	PSF_LiftTop,
+	PSF_ControlUpdate,
+	PSF_ContainedControlUpdate,
+	PSF_ControlCommand,
+	PSF_ControlCommandFinished,
+	PSF_DeepBreath,
+	PSF_CatchBlow,
+	PSF_QueryCatchBlow,
+	PSF_Stuck,
+	PSF_RejectContents,
+	PSF_LineBreak,
+	PSF_UpdateTransferZone,
+	PSF_RejectFight,
+	PSF_AttachTargetLost,
+	PSF_OnActionJump,
+	// PSF_Contact
+	"~ContactLeft",
+	"~ContactRight",
+	"~ContactTop",
+	"~ContactBottom",
+	"~ContactCenter",
+};
+
+static_assert(std::size(PSFSlotFunctions) == PSFSlot_Count, "PSFSlotFunctions must contain one function name per C4PSFSlot");
+
 // Fx{} is automatically prefixed
 #define PSFS_FxAdd  "Add" // C4Object *pTarget, int iEffectNumber, C4String *szNewEffect, int iNewTimer, C4Value vNewEffectVar1, C4Value vNewEffectVar2, C4Value vNewEffectVar3, C4Value vNewEffectVar4
 #define PSFS_FxInfo "Info" // C4Object *pTarget, int iEffectNumber
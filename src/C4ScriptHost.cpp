@@ -176,9 +176,18 @@ void C4DefScriptHost::Default()
 {
 	C4ScriptHost::Default();
 	SFn_CalcValue = SFn_SellTo = SFn_ControlTransfer = SFn_CustomComponents = nullptr;
+	SFn_Callbacks.fill(nullptr);
 	ControlMethod[0] = ControlMethod[1] = ContainedControlMethod[0] = ContainedControlMethod[1] = ActivationControlMethod[0] = ActivationControlMethod[1] = 0;
 }
 
+void C4DefScriptHost::UnLink()
+{
+	C4AulScript::UnLink();
+	// cached functions might be deleted until the next AfterLink
+	SFn_CalcValue = SFn_SellTo = SFn_ControlTransfer = SFn_CustomComponents = nullptr;
+	SFn_Callbacks.fill(nullptr);
+}
+
 void C4DefScriptHost::AfterLink()
 {
 	C4AulScript::AfterLink();
@@ -188,6 +197,9 @@ void C4DefScriptHost::AfterLink()
 	SFn_SellTo           = GetSFunc(PSF_SellTo,              AA_PROTECTED);
 	SFn_ControlTransfer  = GetSFunc(PSF_ControlTransfer,     AA_PROTECTED);
 	SFn_CustomComponents = GetSFunc(PSF_GetCustomComponents, AA_PROTECTED);
+	// Search engine callbacks; object calls into their own script need no access check
+	for (std::size_t i = 0; i < SFn_Callbacks.size(); ++i)
+		SFn_Callbacks[i] = GetSFunc(PSFSlotFunctions[i]);
 	if (Def)
 	{
 		C4AulAccess CallAccess = AA_PRIVATE;
@@ -21,6 +21,9 @@
 #include <C4ComponentHost.h>
 
 #include <C4Aul.h>
+#include <C4Script.h>
+
+#include <array>
 
 // generic script host for objects
 class C4ScriptHost : public C4AulScript, public C4ComponentHost
@@ -69,9 +72,14 @@ public:
 
 	bool Delete() override { return false; } // do NOT delete this - it's just a class member!
 
+	C4AulScriptFunc *GetCallback(C4PSFSlot slot) const { return SFn_Callbacks[slot]; } // nullptr if the script doesn't define the callback
+
 protected:
+	void UnLink() override;
 	void AfterLink() override; // get common funcs
 
+	std::array<C4AulScriptFunc *, PSFSlot_Count> SFn_Callbacks; // engine callbacks resolved at link time
+
 public:
 	C4AulScriptFunc *SFn_CalcValue; // get object value
 	C4AulScriptFunc *SFn_SellTo; // player par(0) sold the object
@@ -406,6 +406,19 @@ bool C4Shape::ContactCheck(int32_t cx, int32_t cy)
 	return ContactCount;
 }
 
+int32_t C4Shape::GetFreeSteps(int32_t cx, int32_t cy, int32_t dx, int32_t dy, int32_t iMax)
+{
+	// The solidity bits only tell about densities of at least C4M_Solid,
+	// so they cannot prove the absence of contact with less dense materials.
+	// Positions outside the landscape are never reported as free.
+	if (ContactDensity < C4M_Solid) return 0;
+	const C4SolidityBitplane &rSolidityBits = Game.Landscape.GetSolidityBits();
+	for (int32_t cvtx = 0; cvtx < VtxNum && iMax; cvtx++)
+		if (!(VtxCNAT[cvtx] & CNAT_NoCollision))
+			iMax = rSolidityBits.GetFreeSpan(cx + VtxX[cvtx] + dx, cy + VtxY[cvtx] + dy, dx, dy, iMax);
+	return iMax;
+}
+
 int32_t C4Shape::GetVertexX(int32_t iVertex)
 {
 	if (!Inside<int32_t>(iVertex, 0, VtxNum - 1)) return 0;
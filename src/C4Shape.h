@@ -66,6 +66,7 @@ public:
 	bool AddVertex(int32_t iX, int32_t iY);
 	bool CheckContact(int32_t cx, int32_t cy);
 	bool ContactCheck(int32_t cx, int32_t cy);
+	int32_t GetFreeSteps(int32_t cx, int32_t cy, int32_t dx, int32_t dy, int32_t iMax); // number of steps by dx/dy that are known to have no contact
 	bool Attach(int32_t &cx, int32_t &cy, uint8_t cnat_pos);
 	bool LineConnect(int32_t tx, int32_t ty, int32_t cvtx, int32_t ld, int32_t oldx, int32_t oldy);
 	bool InsertVertex(int32_t iPos, int32_t tx, int32_t ty);
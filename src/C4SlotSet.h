@@ -0,0 +1,105 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// Set of slots that can be in use or free. Slots in use are tracked in a bitmap,
+// so free slots can be skipped quickly. Slots are stored in a deque, which doesn't
+// move existing slots when growing at the end, so references to slots stay valid
+// while slots are added, e.g. by the slot that is currently being executed.
+template<typename T>
+class C4SlotSet
+{
+	std::deque<T> slots;
+	std::vector<std::uint64_t> used; // one bit per slot
+
+public:
+	std::int32_t Size() const { return static_cast<std::int32_t>(slots.size()); }
+
+	T &operator[](const std::int32_t slot) { return slots[slot]; }
+	const T &operator[](const std::int32_t slot) const { return slots[slot]; }
+
+	void Clear()
+	{
+		slots.clear();
+		used.clear();
+	}
+
+	// added slots are initialized to empty and free; slots dropped when shrinking must be free
+	void Resize(const std::int32_t size, const T &empty)
+	{
+		slots.resize(size, empty);
+		used.resize((size + 63) / 64);
+		if (size % 64) used.back() &= ~(~std::uint64_t{0} << (size % 64));
+	}
+
+	void ClearUsed()
+	{
+		std::fill(used.begin(), used.end(), 0);
+	}
+
+	bool IsUsed(const std::int32_t slot) const
+	{
+		return used[slot / 64] & (std::uint64_t{1} << (slot % 64));
+	}
+
+	void SetUsed(const std::int32_t slot, const bool fUsed)
+	{
+		assert(IsUsed(slot) != fUsed);
+		const std::uint64_t dwBit{std::uint64_t{1} << (slot % 64)};
+		if (fUsed)
+			used[slot / 64] |= dwBit;
+		else
+			used[slot / 64] &= ~dwBit;
+	}
+
+	// last used slot below before, or -1
+	std::int32_t PrevUsed(const std::int32_t before) const
+	{
+		if (before <= 0) return -1;
+		std::int32_t iWord{(before - 1) / 64};
+		// mask out bits at and above before
+		std::uint64_t dwBits{used[iWord] & (~std::uint64_t{0} >> (63 - (before - 1) % 64))};
+		while (!dwBits)
+		{
+			if (!iWord) return -1;
+			dwBits = used[--iWord];
+		}
+		return iWord * 64 + 63 - std::countl_zero(dwBits);
+	}
+
+	// first free slot in [from, to), or -1
+	std::int32_t NextFree(const std::int32_t from, const std::int32_t to) const
+	{
+		if (from >= to) return -1;
+		std::int32_t iWord{from / 64};
+		// mask out bits below from
+		std::uint64_t dwBits{~used[iWord] & (~std::uint64_t{0} << (from % 64))};
+		while (!dwBits)
+		{
+			if (++iWord * 64 >= to) return -1;
+			dwBits = ~used[iWord];
+		}
+		const std::int32_t slot{iWord * 64 + std::countr_zero(dwBits)};
+		return slot < to ? slot : -1;
+	}
+};
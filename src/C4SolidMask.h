@@ -73,6 +73,7 @@ public:
 	void Put(bool fCauseInstability, C4TargetRect *pClipRect, bool fRestoreAttachment); // put mask to landscape
 	void Remove(bool fCauseInstability, bool fBackupAttachment); // remove mask from landscape
 	void Clear(); // clear any SolidMask-data
+	bool IsPut() const { return MaskPut; }
 
 	C4SolidMask(C4Object *pForObject);
 	~C4SolidMask();
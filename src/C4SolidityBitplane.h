@@ -0,0 +1,122 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+// One bit per landscape pixel that is set where the density is at least C4M_Solid.
+// The bits are stored both row by row and column by column, so runs of free
+// pixels can be scanned a word at a time in all four directions.
+class C4SolidityBitplane
+{
+	static constexpr std::int32_t WordBits{64};
+
+	std::int32_t width{0}, height{0};
+	std::int32_t rowPitch{0}, colPitch{0}; // words per row and per column
+	std::vector<std::uint64_t> rows, cols;
+
+public:
+	// resets the plane to the given size with all pixels free
+	void Init(const std::int32_t width, const std::int32_t height)
+	{
+		this->width = width;
+		this->height = height;
+		rowPitch = (width + WordBits - 1) / WordBits;
+		colPitch = (height + WordBits - 1) / WordBits;
+		rows.assign(static_cast<std::size_t>(rowPitch) * height, 0);
+		cols.assign(static_cast<std::size_t>(colPitch) * width, 0);
+	}
+
+	void Clear()
+	{
+		width = height = rowPitch = colPitch = 0;
+		rows.clear();
+		rows.shrink_to_fit();
+		cols.clear();
+		cols.shrink_to_fit();
+	}
+
+	std::int32_t GetWidth() const { return width; }
+	std::int32_t GetHeight() const { return height; }
+
+	bool Get(const std::int32_t x, const std::int32_t y) const
+	{
+		assert(x >= 0 && y >= 0 && x < width && y < height);
+		return (rows[y * rowPitch + x / WordBits] >> (x % WordBits)) & 1;
+	}
+
+	void Set(const std::int32_t x, const std::int32_t y, const bool solid)
+	{
+		assert(x >= 0 && y >= 0 && x < width && y < height);
+		SetBit(rows[y * rowPitch + x / WordBits], x % WordBits, solid);
+		SetBit(cols[x * colPitch + y / WordBits], y % WordBits, solid);
+	}
+
+	// Returns the number of consecutive free pixels starting at x/y in direction dx/dy, but at most max.
+	// Exactly one of dx and dy has to be +1 or -1, the other one 0. Pixels outside of the plane are never free.
+	std::int32_t GetFreeSpan(const std::int32_t x, const std::int32_t y, const std::int32_t dx, const std::int32_t dy, const std::int32_t max) const
+	{
+		assert(!dx != !dy);
+		if (x < 0 || y < 0 || x >= width || y >= height) return 0;
+		if (dx)
+		{
+			return GetFreeRun(&rows[y * rowPitch], x, dx, std::min(max, dx > 0 ? width - x : x + 1));
+		}
+		return GetFreeRun(&cols[x * colPitch], y, dy, std::min(max, dy > 0 ? height - y : y + 1));
+	}
+
+private:
+	static void SetBit(std::uint64_t &word, const std::int32_t bit, const bool value)
+	{
+		const auto mask = std::uint64_t{1} << bit;
+		word = value ? word | mask : word & ~mask;
+	}
+
+	// max must not exceed the line
+	static std::int32_t GetFreeRun(const std::uint64_t *const line, const std::int32_t pos, const std::int32_t dir, const std::int32_t max)
+	{
+		std::int32_t count{0};
+		while (count < max)
+		{
+			const std::int32_t i{pos + dir * count};
+			const std::uint64_t word{line[i / WordBits]};
+			const std::int32_t bit{i % WordBits};
+			if (dir > 0)
+			{
+				// bits from the current pixel upwards
+				if (const std::uint64_t bits{word >> bit})
+				{
+					return std::min(max, count + std::countr_zero(bits));
+				}
+				count += WordBits - bit;
+			}
+			else
+			{
+				// bits from the current pixel downwards
+				if (const std::uint64_t bits{word << (WordBits - 1 - bit)})
+				{
+					return std::min(max, count + std::countl_zero(bits));
+				}
+				count += bit + 1;
+			}
+		}
+		return max;
+	}
+};
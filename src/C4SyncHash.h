@@ -0,0 +1,50 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// Hash functions for the game state checksum that is sent with sync checks.
+// The hashes only need to be equal on all clients and have to change with any
+// change of the hashed state; they are not meant to be secure.
+
+#pragma once
+
+#include <cstdint>
+
+namespace C4SyncHash
+{
+	// finalizer of splitmix64
+	constexpr std::uint64_t Mix(std::uint64_t value)
+	{
+		value ^= value >> 30;
+		value *= 0xbf58476d1ce4e5b9;
+		value ^= value >> 27;
+		value *= 0x94d049bb133111eb;
+		value ^= value >> 31;
+		return value;
+	}
+
+	// order dependent
+	constexpr std::uint64_t Combine(const std::uint64_t hash, const std::uint64_t value)
+	{
+		return Mix(hash + 0x9e3779b97f4a7c15 + value);
+	}
+
+	// Landscape hashes are XOR sums of pixel hashes, so changing a pixel is a matter of
+	// removing the old and adding the new pixel hash. Sky pixels don't contribute.
+	constexpr std::uint64_t Pixel(const std::int32_t x, const std::int32_t y, const std::uint8_t pix)
+	{
+		if (!pix) return 0;
+		return Mix((static_cast<std::uint64_t>(static_cast<std::uint32_t>(y)) << 32 | static_cast<std::uint32_t>(x)) ^ (static_cast<std::uint64_t>(pix) << 56));
+	}
+}
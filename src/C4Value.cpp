@@ -26,9 +26,7 @@
 #include <format>
 #include <string_view>
 
-#include <C4Game.h>
 #include <C4Object.h>
-#include <C4Log.h>
 
 const C4Value C4VNull{};
 const C4Value C4VTrue{C4VBool(true)};
@@ -84,23 +82,28 @@ void C4Value::AddDataRef()
 	case C4V_Array: case C4V_Map: Data.Container = Data.Container->IncRef(); break;
 	case C4V_String: Data.Str->IncRef(); break;
 	case C4V_C4Object:
-		Data.Obj->AddRef(this);
-#ifndef NDEBUG
-		// check if the object actually exists
-		if (!Game.Objects.ObjectNumber(Data.Obj))
+		// copies of removed objects are nil right away
+		if (!ObjectHandles.IsValid(Data.Obj))
 		{
-			LogNTr(spdlog::level::warn, "using wild object ptr {}!", static_cast<void *>(Data.Obj));
+			Data.Raw = 0;
+			Type = C4V_Any;
 		}
-		else if (!Data.Obj->Status)
-		{
-			LogNTr(spdlog::level::warn, "using ptr on deleted object {} ({})!", static_cast<void *>(Data.Obj), Data.Obj->GetName());
-		}
-#endif
 		break;
 	default: break;
 	}
 }
 
+C4V_Data C4Value::ObjectData(C4Object *const pObj)
+{
+	C4V_Data data;
+	data.Raw = 0;
+	if (pObj)
+	{
+		data.Obj = GetObjectHandle(pObj);
+	}
+	return data;
+}
+
 void C4Value::DelDataRef(C4V_Data Data, C4V_Type Type, C4Value *pNextRef, C4ValueContainer *pBaseContainer)
 {
 	// clean up
@@ -111,7 +114,6 @@ void C4Value::DelDataRef(C4V_Data Data, C4V_Type Type, C4Value *pNextRef, C4Valu
 		HasBaseContainer = false;
 		Data.Ref->DelRef(this, pNextRef, pBaseContainer);
 		break;
-	case C4V_C4Object: Data.Obj->DelRef(this, pNextRef); break;
 	case C4V_Array: case C4V_Map: Data.Container->DecRef(); break;
 	case C4V_String: Data.Str->DecRef(); break;
 	default: break;
@@ -191,7 +193,7 @@ void C4Value::GetContainerElement(C4Value *index, C4Value &target, C4AulContext
 		{
 			if (index->ConvertTo(C4V_String) && index->_getStr())
 			{
-				auto var = Ref.Data.Obj->LocalNamed.GetItem(index->_getStr()->Data.getData());
+				auto var = Ref._getObj()->LocalNamed.GetItem(index->_getStr()->Data.getData());
 				if (var) target.SetRef(var);
 				else target.Set0();
 			}
@@ -252,6 +254,7 @@ const C4Value &C4Value::GetRefVal() const
 	const C4Value *pVal = this;
 	while (pVal->Type == C4V_pC4Value)
 		pVal = pVal->Data.Ref;
+	if (pVal->IsRemovedObject()) return C4VNull;
 	return *pVal;
 }
 
@@ -260,6 +263,7 @@ C4Value &C4Value::GetRefVal()
 	C4Value *pVal = this;
 	while (pVal->Type == C4V_pC4Value)
 		pVal = pVal->Data.Ref;
+	if (pVal->IsRemovedObject()) pVal->Set0();
 	return *pVal;
 }
 
@@ -308,17 +312,15 @@ C4V_Type C4Value::GuessType()
 		return Type = C4V_C4ID;
 
 	// object?
-	if (Game.Objects.ObjectNumber(Data.Obj))
+	if (C4Object *const pObj{reinterpret_cast<C4Object *>(static_cast<std::intptr_t>(Data.Raw))}; GetObjectNumber(pObj))
 	{
-		Type = C4V_C4Object;
-		// With the type now known, the destructor will clean up the reference
-		// which only works if the reference is added first
-		AddDataRef();
-		return Type;
+		// objects are held by handle
+		Data = ObjectData(pObj);
+		return Type = C4V_C4Object;
 	}
 
 	// string?
-	if (Game.ScriptEngine.Strings.FindString(Data.Str))
+	if (GetStringTable().FindString(Data.Str))
 	{
 		Type = C4V_String;
 		// see above
@@ -623,16 +625,12 @@ std::string C4Value::GetDataString() const
 		return C4IdText(Data.ID);
 	case C4V_C4Object:
 	{
-		// obj exists?
-		if (!Game.Objects.ObjectNumber(Data.Obj) && !Game.Objects.InactiveObjects.ObjectNumber(Data.Obj))
-			return std::to_string(Data.Raw);
-		else if (Data.Obj)
-			if (Data.Obj->Status == C4OS_NORMAL)
-				return std::format("{} #{}", Data.Obj->GetName(), static_cast<int>(Data.Obj->Number));
-			else
-				return std::format("{{{} #{}}}", Data.Obj->GetName(), static_cast<int>(Data.Obj->Number));
+		// removed objects are nil, so the object still exists
+		C4Object *const pObj{_getObj()};
+		if (pObj->Status == C4OS_NORMAL)
+			return std::format("{} #{}", pObj->GetName(), static_cast<int>(pObj->Number));
 		else
-			return "0"; // (impossible)
+			return std::format("{{{} #{}}}", pObj->GetName(), static_cast<int>(pObj->Number));
 	}
 	case C4V_String:
 		return (Data.Str && Data.Str->Data.getData()) ? std::format("\"{}\"", Data.Str->Data.getData()) : "(nullstring)";
@@ -671,14 +669,14 @@ C4Value C4VString(const char *strString)
 {
 	// safety
 	if (!strString) return C4Value();
-	return C4Value(new C4String(strString, &Game.ScriptEngine.Strings));
+	return C4Value(new C4String(strString, &C4Value::GetStringTable()));
 }
 
 C4Value C4VString(StdStrBuf &&Str)
 {
 	// safety
 	if (Str.isNull()) return C4Value();
-	return C4Value(new C4String(std::forward<StdStrBuf>(Str), &Game.ScriptEngine.Strings));
+	return C4Value(new C4String(std::forward<StdStrBuf>(Str), &C4Value::GetStringTable()));
 }
 
 void C4Value::DenumeratePointer()
@@ -692,12 +690,10 @@ void C4Value::DenumeratePointer()
 	// object types only
 	if (Type != C4V_C4ObjectEnum && Type != C4V_Any) return;
 	// in range?
-	if (Type != C4V_C4ObjectEnum && !Inside<std::intptr_t>(Data.Raw, C4EnumPointer1, C4EnumPointer2)) return;
+	if (Type != C4V_C4ObjectEnum && !Inside<std::int64_t>(Data.Raw, C4EnumPointer1, C4EnumPointer2)) return;
 	// get obj id, search object
 	const auto iObjID = (Data.Int >= C4EnumPointer1 ? Data.Int - C4EnumPointer1 : Data.Int);
-	C4Object *pObj = Game.Objects.ObjectPointer(iObjID);
-	if (!pObj)
-		pObj = Game.Objects.InactiveObjects.ObjectPointer(iObjID);
+	C4Object *pObj = GetObjectByNumber(iObjID);
 	if (pObj)
 		// set
 		SetObject(pObj);
@@ -721,6 +717,7 @@ void C4Value::CompileFunc(StdCompiler *pComp)
 	if (!fCompiler)
 	{
 		// Get type
+		if (IsRemovedObject()) Set0();
 		if (Type == C4V_Any && Data) GuessType();
 		char cC4VID = GetC4VID(Type);
 		// Object reference is saved enumerated
@@ -768,7 +765,7 @@ void C4Value::CompileFunc(StdCompiler *pComp)
 	// object: save object number instead
 	case C4V_C4Object:
 		if (!fCompiler)
-			iTmp = Game.Objects.ObjectNumber(getObj());
+			iTmp = GetObjectNumber(getObj());
 	case C4V_C4ObjectEnum:
 		if (!fCompiler) if (Type == C4V_C4ObjectEnum)
 			iTmp = Data.Int;
@@ -787,7 +784,7 @@ void C4Value::CompileFunc(StdCompiler *pComp)
 		// search
 		if (fCompiler)
 		{
-			C4String *pString = Game.ScriptEngine.Strings.FindString(iTmp);
+			C4String *pString = GetStringTable().FindString(iTmp);
 			if (pString)
 			{
 				Data.Str = pString;
@@ -822,6 +819,10 @@ void C4Value::CompileFunc(StdCompiler *pComp)
 
 bool C4Value::Equals(const C4Value &other, C4AulScriptStrict strict) const
 {
+	// removed objects are nil
+	if (IsRemovedObject()) return C4VNull.Equals(other, strict);
+	if (other.IsRemovedObject()) return Equals(C4VNull, strict);
+
 	switch (strict)
 	{
 		case C4AulScriptStrict::NONSTRICT: case C4AulScriptStrict::STRICT1:
@@ -861,6 +862,10 @@ bool C4Value::Equals(const C4Value &other, C4AulScriptStrict strict) const
 
 bool C4Value::operator==(const C4Value &Value2) const
 {
+	// removed objects are nil
+	if (IsRemovedObject()) return C4VNull == Value2;
+	if (Value2.IsRemovedObject()) return *this == C4VNull;
+
 	switch (Type)
 	{
 	case C4V_Any:
@@ -962,9 +967,9 @@ namespace
 	}
 }
 
-std::size_t std::hash<C4Value>::operator()(C4Value value) const
+std::size_t std::hash<C4Value>::operator()(const C4Value &value) const
 {
-	C4Value &ref = value.GetRefVal();
+	const C4Value &ref = value.GetRefVal();
 	std::size_t hash = std::hash<C4V_Type>{}(ref.GetType());
 
 	if (ref.GetType() == C4V_C4ObjectEnum)
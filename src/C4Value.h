@@ -18,6 +18,7 @@
 
 #include "C4Id.h"
 #include "C4AulScriptStrict.h"
+#include "C4ObjectHandle.h"
 
 #include <concepts>
 #include <cstdint>
@@ -32,6 +33,7 @@ class C4String;
 class C4ValueArray;
 class C4ValueHash;
 class C4ValueContainer;
+class C4StringTable;
 
 // C4Value type
 enum C4V_Type
@@ -65,16 +67,16 @@ union C4V_Data
 {
 	C4ValueInt Int;
 	C4ID ID;
-	C4Object *Obj;
+	C4ObjectHandle Obj;
 	C4String *Str;
 	C4Value *Ref;
 	C4ValueContainer *Container;
 	C4ValueArray *Array;
 	C4ValueHash *Map;
-	std::intptr_t Raw;
-	// cheat a little - assume that all members have the same length
-	explicit operator bool() const noexcept { return Ref; }
-	bool operator==(C4V_Data b) const noexcept { return Ref == b.Ref; }
+	std::int64_t Raw;
+	// cheat a little - Raw is cleared before setting any shorter member
+	explicit operator bool() const noexcept { return Raw; }
+	bool operator==(C4V_Data b) const noexcept { return Raw == b.Raw; }
 	C4V_Data &operator=(C4Value *p) { Ref = p; return *this; }
 };
 // converter function, used in converter table
@@ -116,38 +118,32 @@ public:
 		Data.ID = id;
 	}
 
-	explicit C4Value(C4Object *pObj) : Type(pObj ? C4V_C4Object : C4V_Any), NextRef(nullptr), FirstRef(nullptr)
-	{
-		Data.Obj = pObj; AddDataRef();
-	}
+	explicit C4Value(C4Object *pObj) : Data(ObjectData(pObj)), Type(pObj ? C4V_C4Object : C4V_Any), NextRef(nullptr), FirstRef(nullptr) {}
 
 	explicit C4Value(C4String *pStr) : Type(pStr ? C4V_String : C4V_Any), NextRef(nullptr), FirstRef(nullptr)
 	{
+		Data.Raw = 0;
 		Data.Str = pStr; AddDataRef();
 	}
 
 	explicit C4Value(C4ValueArray *pArray) : Type(pArray ? C4V_Array : C4V_Any), NextRef(nullptr), FirstRef(nullptr)
 	{
+		Data.Raw = 0;
 		Data.Array = pArray; AddDataRef();
 	}
 
 	explicit C4Value(C4ValueHash *pMap) : Type(pMap ? C4V_Map : C4V_Any), NextRef(nullptr), FirstRef(nullptr)
 	{
+		Data.Raw = 0;
 		Data.Map = pMap; AddDataRef();
 	}
 
 	explicit C4Value(C4Value *pVal) : Type(pVal ? C4V_pC4Value : C4V_Any), NextRef(nullptr), FirstRef(nullptr)
 	{
+		Data.Raw = 0;
 		Data.Ref = pVal; AddDataRef();
 	}
 
-	static C4Value *OfMap(C4ValueHash *map)
-	{
-		auto ret = new C4Value;
-		ret->OwningMap = map;
-		return ret;
-	}
-
 	C4Value &operator=(const C4Value &nValue);
 
 	~C4Value();
@@ -160,7 +156,7 @@ public:
 	C4ValueInt getIntOrID()  { Deref(); if (Type == C4V_Int || Type == C4V_Bool) return Data.Int; else if (Type == C4V_C4ID) return static_cast<C4ValueInt>(Data.ID); else return 0; }
 	bool getBool()           { return ConvertTo(C4V_Bool)     ? !!Data.Int : false; }
 	C4ID getC4ID()           { return ConvertTo(C4V_C4ID)     ? Data.ID : C4ID_None; }
-	C4Object *getObj()       { return ConvertTo(C4V_C4Object) ? Data.Obj   : nullptr; }
+	C4Object *getObj()       { return ConvertTo(C4V_C4Object) ? _getObj()  : nullptr; }
 	C4String *getStr()       { return ConvertTo(C4V_String)   ? Data.Str   : nullptr; }
 	C4ValueArray *getArray() { return ConvertTo(C4V_Array)    ? Data.Array : nullptr; }
 	C4ValueHash *getMap()    { return ConvertTo(C4V_Map)      ? Data.Map   : nullptr; }
@@ -170,12 +166,12 @@ public:
 	C4ValueInt _getInt()      const { return Data.Int; }
 	bool _getBool()           const { return !!Data.Int; }
 	C4ID _getC4ID()           const { return Data.ID; }
-	C4Object *_getObj()       const { return Data.Obj; }
+	C4Object *_getObj()       const { return ObjectHandles.Get(Data.Obj); }
 	C4String *_getStr()       const { return Data.Str; }
 	C4ValueArray *_getArray() const { return Data.Array; }
 	C4ValueHash *_getMap()    const { return Data.Map; }
 	C4Value *_getRef()        const { return Data.Ref; }
-	std::intptr_t _getRaw()   const { return Data.Raw; }
+	std::int64_t _getRaw()    const { return IsRemovedObject() ? 0 : Data.Raw; }
 
 	// Template versions
 	template <typename T> inline T Get() { return C4ValueConv<T>::FromC4V(*this); }
@@ -192,15 +188,15 @@ public:
 
 	void SetC4ID(C4ID id) { C4V_Data d; d.Raw = 0; d.ID = id; Set(d, C4V_C4ID); }
 
-	void SetObject(C4Object *Obj) { C4V_Data d; d.Obj = Obj; Set(d, C4V_C4Object); }
+	void SetObject(C4Object *Obj) { Set(ObjectData(Obj), C4V_C4Object); }
 
-	void SetString(C4String *Str) { C4V_Data d; d.Str = Str; Set(d, C4V_String); }
+	void SetString(C4String *Str) { C4V_Data d; d.Raw = 0; d.Str = Str; Set(d, C4V_String); }
 
-	void SetArray(C4ValueArray *Array) { C4V_Data d; d.Array = Array; Set(d, C4V_Array); }
+	void SetArray(C4ValueArray *Array) { C4V_Data d; d.Raw = 0; d.Array = Array; Set(d, C4V_Array); }
 
-	void SetMap(C4ValueHash *Map) { C4V_Data d; d.Map = Map; Set(d, C4V_Map); }
+	void SetMap(C4ValueHash *Map) { C4V_Data d; d.Raw = 0; d.Map = Map; Set(d, C4V_Map); }
 
-	void SetRef(C4Value *nValue) { C4V_Data d; d.Ref = nValue; Set(d, C4V_pC4Value); }
+	void SetRef(C4Value *nValue) { C4V_Data d; d.Raw = 0; d.Ref = nValue; Set(d, C4V_pC4Value); }
 
 	void Set0();
 
@@ -247,6 +243,7 @@ public:
 
 	inline bool ConvertTo(C4V_Type vtToType, bool fStrict = true) // convert to dest type
 	{
+		if (IsRemovedObject()) Set0();
 		C4VCnvFn Fn = C4ScriptCnvMap[Type][vtToType];
 		if (Fn.Function)
 			return (*Fn.Function)(this, vtToType, fStrict);
@@ -258,6 +255,13 @@ public:
 	// Compilation
 	void CompileFunc(StdCompiler *pComp);
 
+	// objects and strings of the running game that values refer to
+	// defined with the game in C4Game.cpp, so values themselves don't depend on it
+	static C4ObjectHandle GetObjectHandle(C4Object *pObj);
+	static std::int32_t GetObjectNumber(C4Object *pObj); // 0 if pObj is no object of the game
+	static C4Object *GetObjectByNumber(std::int32_t iNumber);
+	static C4StringTable &GetStringTable();
+
 protected:
 	// data
 	C4V_Data Data;
@@ -279,6 +283,10 @@ protected:
 	C4Value *GetNextRef() { if (HasBaseContainer) return nullptr; else return NextRef; }
 	C4ValueContainer *GetBaseContainer() { if (HasBaseContainer) return BaseContainer; else return nullptr; }
 
+	// object values aren't reset when the object is removed, but read as nil
+	bool IsRemovedObject() const { return Type == C4V_C4Object && !ObjectHandles.IsValid(Data.Obj); }
+	static C4V_Data ObjectData(C4Object *pObj);
+
 	void Set(C4V_Data nData, C4V_Type nType);
 
 	void AddRef(C4Value *pRef);
@@ -296,8 +304,8 @@ protected:
 	static bool FnCnvInt2Id(C4Value *Val, C4V_Type toType, bool fStrict);
 	static bool FnCnvGuess(C4Value *Val, C4V_Type toType, bool fStrict);
 
-	friend class C4Object;
 	friend class C4AulDefFunc;
+	friend class C4ValueHash;
 };
 
 // converter
@@ -383,7 +391,7 @@ namespace std
 	template<>
 	struct hash<C4Value>
 	{
-		std::size_t operator()(C4Value value) const;
+		std::size_t operator()(const C4Value &value) const;
 	};
 }
 
@@ -17,9 +17,6 @@
 #include "C4ValueHash.h"
 #include "C4StringTable.h"
 
-#include <optional>
-#include <stdexcept>
-
 C4ValueHash::C4ValueHash() { }
 
 C4ValueHash::C4ValueHash(const C4ValueHash &other)
@@ -34,6 +31,7 @@ C4ValueHash::~C4ValueHash()
 
 void C4ValueHash::CompileFunc(StdCompiler *pComp)
 {
+	RemoveRemovedObjects();
 	pComp->Value(mkSTLMapAdapt(*this));
 }
 
@@ -46,52 +44,60 @@ void C4ValueHash::DenumeratePointers()
 	}
 }
 
-void C4ValueHash::removeValue(C4Value *value)
+void C4ValueHash::RemoveRemovedObjects() const
 {
-	const auto erase = [this](const auto &it)
-	{
-		keyOrder.erase(it->second.keyOrderIterator);
-		map.erase(it);
-	};
-	bool found = false;
-	auto keyIt = map.end();
-	for (auto it = map.begin(); it != map.end(); )
+	const std::uint32_t count{ObjectHandles.GetInvalidationCount()};
+	if (count == ObjectInvalidationCount) return;
+	ObjectInvalidationCount = count;
+
+	for (std::size_t i = map.NextLivePosition(0); i < map.EntryCount(); i = map.NextLivePosition(i + 1))
 	{
-		if (&it->first == value)
+		auto &entry = map.GetEntry(i);
+		if (entry.key.IsRemovedObject() || entry.value.IsRemovedObject())
 		{
-			keyIt = it;
-			emptyValues.push_front(it->second.value);
+			map.Erase(entry);
+			entry.key.OwningMap = entry.value.OwningMap = nullptr;
+			entry.key.Set0();
+			entry.value.Set0();
 		}
-		else if (it->second.value == value)
-		{
-			erase(it++);
-			found = true;
-			continue;
-		}
-		++it;
 	}
-	if (found) emptyValues.push_front(value);
-	if (keyIt != map.end()) erase(keyIt);
+}
+
+void C4ValueHash::removeValue(C4Value *value)
+{
+	// value is either the key or the value of an entry, which doesn't move until the next compaction
+	auto &entry = map.GetEntry(map.PositionOf(value));
+	if (entry.removed) return;
+	map.Erase(entry);
+
+	entry.key.OwningMap = entry.value.OwningMap = nullptr;
+	// release whatever the other half still holds
+	(value == &entry.key ? entry.value : entry.key).Set0();
 }
 
 bool C4ValueHash::contains(const C4Value &key) const
 {
-	return map.find(key) != map.end();
+	RemoveRemovedObjects();
+	return map.Find(key);
 }
 
 void C4ValueHash::clear()
 {
-	for (auto &[key, value] : map) delete value.value;
-	map.clear();
-	for (auto &value : emptyValues) delete value;
-	emptyValues.clear();
+	for (std::size_t i = 0; i < map.EntryCount(); ++i)
+	{
+		auto &entry = map.GetEntry(i);
+		entry.key.OwningMap = entry.value.OwningMap = nullptr;
+	}
+	map.Clear();
 }
 
 C4ValueHash &C4ValueHash::operator=(const C4ValueHash &other)
 {
-	for (const auto key : other.keyOrder)
+	other.RemoveRemovedObjects();
+	for (std::size_t i = other.map.NextLivePosition(0); i < other.map.EntryCount(); i = other.map.NextLivePosition(i + 1))
 	{
-		(*this)[*key].Set(*other.map.at(*key).value);
+		const auto &entry = other.map.GetEntry(i);
+		(*this)[entry.key].Set(entry.value);
 	}
 	return *this;
 }
@@ -99,10 +105,13 @@ C4ValueHash &C4ValueHash::operator=(const C4ValueHash &other)
 bool C4ValueHash::operator==(const C4ValueHash &other) const
 {
 	if (other.size() != size()) return false;
+	// both maps are free of removed objects now
 
-	for (const auto &it : map)
+	for (std::size_t i = map.NextLivePosition(0); i < map.EntryCount(); i = map.NextLivePosition(i + 1))
 	{
-		if (!other.contains(it.first) || other[it.first] != *it.second.value)
+		const auto &entry = map.GetEntry(i);
+		const auto *const otherEntry = other.map.Find(entry.key);
+		if (!otherEntry || otherEntry->value != entry.value)
 			return false;
 	}
 
@@ -116,58 +125,58 @@ bool C4ValueHash::hasIndex(const C4Value &key) const
 
 C4Value &C4ValueHash::operator[](const C4Value &key)
 {
-	try
+	RemoveRemovedObjects();
+	const auto [entry, inserted] = map.Insert(key);
+	if (inserted)
 	{
-		return *map.at(key).value;
-	}
-	catch (const std::out_of_range &)
-	{
-		C4Value *value;
-		if (emptyValues.empty()) value = C4Value::OfMap(this);
-		else
-		{
-			value = emptyValues.front();
-			emptyValues.pop_front();
-		}
-
-		const auto &inserted = map.emplace(std::piecewise_construct, std::forward_as_tuple(key, this), std::forward_as_tuple(MapEntry{value, {}})).first;
-		inserted->second.keyOrderIterator = keyOrder.insert(keyOrder.end(), &inserted->first);
-		return *value;
+		entry->key.OwningMap = entry->value.OwningMap = this;
 	}
+	return entry->value;
 }
 
 const C4Value &C4ValueHash::operator[](const C4Value &key) const
 {
-	try
-	{
-		return *map.at(key).value;
-	}
-	catch (const std::out_of_range &)
-	{
-		return C4VNull;
-	}
+	RemoveRemovedObjects();
+	const auto *const entry = map.Find(key);
+	return entry ? entry->value : C4VNull;
 }
 
 C4ValueHash::Iterator C4ValueHash::begin()
 {
-	return Iterator(this, keyOrder.begin(), keyOrder.end());
+	RemoveRemovedObjects();
+	return Iterator(this, map.NextLivePosition(0));
 }
 
 C4ValueHash::Iterator C4ValueHash::end()
 {
-	return Iterator(this, keyOrder.end(), keyOrder.end());
+	return Iterator(this, map.EntryCount());
+}
+
+bool C4ValueHash::ForeachNext(C4ValueInt &position, C4Value &key, C4Value &value)
+{
+	RemoveRemovedObjects();
+	// position is the sequence number of the last visited entry + 1, so compaction doesn't affect it
+	const auto i = map.PositionOfSequence(static_cast<std::uint32_t>(position));
+	if (i >= map.EntryCount()) return false;
+
+	const auto &entry = map.GetEntry(i);
+	position = static_cast<C4ValueInt>(entry.sequence + 1);
+	key = entry.key;
+	value = entry.value;
+	return true;
 }
 
-C4ValueHash::Iterator::Iterator(C4ValueHash *map, C4ValueHash::Iterator::iterator_type it, C4ValueHash::Iterator::iterator_type end) : it(it), end(end), map(map)
+C4ValueHash::Iterator::Iterator(C4ValueHash *map, std::size_t position) : map(map), position(position)
 {
 	update();
 }
 
 void C4ValueHash::Iterator::update()
 {
-	if (it != end)
+	if (position < map->map.EntryCount())
 	{
-		current.emplace(**it, (*map)[**it]);
+		auto &entry = map->map.GetEntry(position);
+		current.emplace(entry.key, entry.value);
 	}
 	else
 	{
@@ -177,7 +186,7 @@ void C4ValueHash::Iterator::update()
 
 C4ValueHash::Iterator &C4ValueHash::Iterator::operator++()
 {
-	++it;
+	position = map->map.NextLivePosition(position + 1);
 	update();
 	return *this;
 }
@@ -189,5 +198,5 @@ C4ValueHash::Iterator::pair_type &C4ValueHash::Iterator::operator*()
 
 bool C4ValueHash::Iterator::operator==(const C4ValueHash::Iterator &other) const
 {
-	return it == other.it;
+	return position == other.position;
 }
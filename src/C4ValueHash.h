@@ -15,13 +15,14 @@
 
 #pragma once
 
+#include "C4InsertionOrderedHashMap.h"
 #include "C4Value.h"
 #include "C4ValueStandardRefCountedContainer.h"
 
-#include <unordered_map>
-#include <forward_list>
-#include <list>
-#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
 
 class C4ValueHash : public C4ValueStandardRefCountedContainer<C4ValueHash>
 {
@@ -30,37 +31,46 @@ public:
 	using mapped_type = C4Value;
 
 private:
-	struct MapEntry
+	struct KeyEqual
 	{
-		C4Value *value;
-		std::list<const C4Value *>::iterator keyOrderIterator;
+		bool operator()(const C4Value &lhs, const C4Value &rhs) const noexcept { return lhs.Equals(rhs, C4AulScriptStrict::MAXSTRICT); }
 	};
 
-	struct KeyEqual
+	struct Relocate
 	{
-		bool operator()(const C4Value &lhs, const C4Value &rhs) const noexcept { return lhs.Equals(rhs, C4AulScriptStrict::MAXSTRICT); }
+		template<typename Entry>
+		void operator()(Entry &from, Entry &to) const
+		{
+			C4ValueHash *const owningMap{from.key.OwningMap};
+			// moving must not remove the entry from the map
+			from.key.OwningMap = from.value.OwningMap = nullptr;
+			from.key.Move(&to.key);
+			from.value.Move(&to.value);
+			to.key.OwningMap = to.value.OwningMap = owningMap;
+		}
 	};
 
-	std::unordered_map<key_type, MapEntry, std::hash<key_type>, KeyEqual> map;
-	std::forward_list<C4Value *> emptyValues;
+	// entries are kept in insertion order, which we need for network sync
+	using Map = C4InsertionOrderedHashMap<C4Value, C4Value, std::hash<C4Value>, KeyEqual, Relocate>;
+	mutable Map map;
+	mutable std::uint32_t ObjectInvalidationCount{0};
 
-	// we need a defined order for network sync
-	std::list<const C4Value *> keyOrder;
+	// entries holding an object are removed along with the object, which is done before the map is accessed
+	void RemoveRemovedObjects() const;
 
 public:
 
 	class Iterator
 	{
 		using pair_type = std::pair<const C4Value &, C4Value &>;
-		using iterator_type = decltype(keyOrder.begin());
-		iterator_type it, end;
 		C4ValueHash *map;
+		std::size_t position;
 		std::optional<pair_type> current;
 
 		void update();
 
 	public:
-		Iterator(C4ValueHash *map, iterator_type it, iterator_type end);
+		Iterator(C4ValueHash *map, std::size_t position);
 
 		Iterator &operator++();
 		pair_type &operator*();
@@ -83,8 +93,12 @@ public:
 	Iterator begin();
 	Iterator end();
 
+	// Script foreach support: assigns the entry following position to key and value and advances position.
+	// position starts at 0 and stays valid if entries are added or removed in between.
+	bool ForeachNext(C4ValueInt &position, C4Value &key, C4Value &value);
+
 	bool contains(const C4Value &key) const;
 	void removeValue(C4Value *value);
-	auto size() const { return map.size(); }
+	auto size() const { RemoveRemovedObjects(); return map.size(); }
 	void clear();
 };
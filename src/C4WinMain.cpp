@@ -48,6 +48,8 @@
 #include <libgen.h>
 #endif
 
+// objects release their handles on destruction, so the table must outlive the game
+C4ObjectHandleTable ObjectHandles;
 C4Application Application;
 C4Console Console;
 C4FullScreen FullScreen;
@@ -275,23 +275,49 @@ bool CStdFile::Rewind()
 bool CStdFile::Advance(size_t iOffset)
 {
 	if (ModeWrite) return false;
-	while (iOffset > 0)
+	// Valid data in the buffer: Skip as much as possible
+	const auto transfer = std::min(BufferLoad - BufferPtr, iOffset);
+	BufferPtr += transfer;
+	iOffset -= transfer;
+	if (!iOffset) return true;
+	// Skip the rest in bulk
+	return Seek(Tell() + iOffset);
+}
+
+bool CStdFile::Seek(size_t iOffset)
+{
+	if (ModeWrite) return false;
+	// Target in the buffer: Just move the buffer pointer
+	const size_t iBufferStart = Tell() - BufferPtr;
+	if (iOffset >= iBufferStart && iOffset <= iBufferStart + BufferLoad)
 	{
-		// Valid data in the buffer: Transfer as much as possible
-		if (BufferLoad > BufferPtr)
+		BufferPtr = iOffset - iBufferStart;
+		return true;
+	}
+	ClearBuffer();
+	if (hFile) return !fseek(hFile, iOffset, SEEK_SET);
+	if (readCompressedFile)
+	{
+		try
 		{
-			const auto transfer = std::min(BufferLoad - BufferPtr, iOffset);
-			BufferPtr += transfer;
-			iOffset -= transfer;
+			readCompressedFile->Seek(iOffset);
 		}
-		// Buffer empty: Load or skip
-		else
+		catch (const StdGzCompressedFile::Exception &)
 		{
-			if (hFile) return !fseek(hFile, iOffset, SEEK_CUR); // uncompressed: Just skip
-			if (LoadBuffer() <= 0) return false; // compressed: Read...
+			return false;
 		}
+		return true;
 	}
-	return true;
+	return false;
+}
+
+size_t CStdFile::Tell()
+{
+	// Position of the underlying file is at the end of the buffer
+	size_t iPos = 0;
+	if (hFile) iPos = static_cast<size_t>(ftell(hFile));
+	if (readCompressedFile) iPos = readCompressedFile->Tell();
+	return iPos - (BufferLoad - BufferPtr);
 }
 
 bool CStdFile::Save(const char *szFilename, const uint8_t *bpBuf,
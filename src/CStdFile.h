@@ -54,6 +54,8 @@ public:
 	bool WriteString(const char *szStr);
 	bool Rewind();
 	bool Advance(size_t iOffset);
+	bool Seek(size_t iOffset); // absolute; compressed files resume at the closest checkpoint instead of rewinding
+	size_t Tell();
 	// Single line commands
 	bool Load(const char *szFileName, uint8_t **lpbpBuf,
 		size_t *ipSize = nullptr, int iAppendZeros = 0,
@@ -26,6 +26,7 @@
 
 #include <concepts>
 #include <cstring>
+#include <memory>
 #include <utility>
 #include <type_traits>
 
@@ -376,6 +377,34 @@ public:
 	}
 };
 
+// Immutable buffer whose data is shared between all copies.
+// Copying only increases a (thread-safe) reference count, so the same data can be queued in several places at once.
+class StdSharedBuf
+{
+public:
+	StdSharedBuf() = default;
+
+	// takes the data if possible, copies it otherwise
+	explicit StdSharedBuf(StdBuf &&Buf)
+		: Data{std::make_shared<const StdBuf>(std::move(Buf), Buf.isRef())} {}
+	explicit StdSharedBuf(const StdBuf &Buf)
+		: Data{std::make_shared<const StdBuf>(Buf)} {}
+
+private:
+	std::shared_ptr<const StdBuf> Data;
+
+public:
+	bool        isNull()  const { return !Data || Data->isNull(); }
+	const void *getData() const { return Data ? Data->getData() : nullptr; }
+	size_t      getSize() const { return Data ? Data->getSize() : 0; }
+	long        getShareCount() const { return Data.use_count(); }
+
+	// the reference is valid as long as any copy of this buffer exists
+	StdBuf getRef() const { return Data ? Data->getRef() : StdBuf(); }
+
+	void Clear() { Data.reset(); }
+};
+
 // Stringbuffer (operates on null-terminated character buffers)
 class StdStrBuf : protected StdBuf
 {
@@ -19,6 +19,7 @@
 #include <cerrno>
 #include <cstring>
 #include <format>
+#include <iterator>
 #include <memory>
 
 namespace StdGzCompressedFile
@@ -152,12 +153,16 @@ size_t Read::UncompressedSize()
 size_t Read::ReadData(uint8_t *const toBuffer, const size_t size)
 {
 	size_t readSize = 0;
-	gzStream.next_out = toBuffer;
-	gzStream.avail_out = checked_cast<unsigned int>(size);
 	for (; size > readSize;)
 	{
-		if (!gzStreamValid && !(feof(file) && bufferedSize == 0))
+		if (!gzStreamValid)
 		{
+			SkipTrailer();
+			if (feof(file) && bufferedSize == 0)
+			{
+				break;
+			}
+
 			PrepareInflate();
 		}
 
@@ -177,15 +182,26 @@ size_t Read::ReadData(uint8_t *const toBuffer, const size_t size)
 			gzStream.avail_in = bufferedSize;
 		}
 
+		// inflate up to the next checkpoint, then stop at the next block boundary
+		const size_t nextCheckpoint = (checkpoints.empty() ? 0 : checkpoints.back().position) + CheckpointSpan;
+		const bool checkpointDue = position >= nextCheckpoint;
+		gzStream.next_out = toBuffer + readSize;
+		gzStream.avail_out = checked_cast<unsigned int>(checkpointDue ? size - readSize : std::min(size - readSize, nextCheckpoint - position));
+
 		const auto oldAvailIn = gzStream.avail_in;
 		const auto oldAvailOut = gzStream.avail_out;
 
-		if (const auto ret = inflate(&gzStream, Z_SYNC_FLUSH); ret != Z_OK)
+		if (const auto ret = inflate(&gzStream, checkpointDue ? Z_BLOCK : Z_SYNC_FLUSH); ret != Z_OK)
 		{
 			if (ret == Z_STREAM_END)
 			{
 				inflateEnd(&gzStream);
 				gzStreamValid = false;
+				if (rawStream)
+				{
+					trailerLeft = GzTrailerSize;
+					rawStream = false;
+				}
 			}
 			else if (ret != Z_BUF_ERROR && gzStream.avail_out != 0)
 			{
@@ -199,6 +215,12 @@ size_t Read::ReadData(uint8_t *const toBuffer, const size_t size)
 		const auto inProgress = oldAvailIn - gzStream.avail_in;
 		bufferPtr += inProgress;
 		bufferedSize -= inProgress;
+
+		// at the end of a block that isn't the last one
+		if (checkpointDue && gzStreamValid && (gzStream.data_type & 128) && !(gzStream.data_type & 64))
+		{
+			AddCheckpoint();
+		}
 	}
 
 	return readSize;
@@ -206,6 +228,7 @@ size_t Read::ReadData(uint8_t *const toBuffer, const size_t size)
 
 void Read::RefillBuffer()
 {
+	bufferFileOffset = ftell(file);
 	bufferedSize = static_cast<unsigned int>(fread(buffer.get(), 1, ChunkSize, file));
 	if (ferror(file)) throw Exception("fread failed");
 	bufferPtr = buffer.get();
@@ -221,9 +244,126 @@ void Read::Rewind()
 	gzStream.next_out = nullptr;
 	gzStream.avail_out = 0;
 	bufferedSize = 0;
+	rawStream = false;
+	trailerLeft = 0;
 	PrepareInflate();
 }
 
+void Read::Seek(const size_t offset)
+{
+	// last checkpoint at or before offset
+	const auto it = std::upper_bound(checkpoints.begin(), checkpoints.end(), offset, [](const size_t offset, const Checkpoint &checkpoint) { return offset < checkpoint.position; });
+	if (it != checkpoints.begin() && (offset < position || std::prev(it)->position > position))
+	{
+		RestoreCheckpoint(*std::prev(it));
+	}
+	else if (offset < position)
+	{
+		Rewind();
+	}
+
+	// decompress the rest
+	uint8_t skipBuffer[16 * 1024];
+	while (position < offset)
+	{
+		if (!ReadData(skipBuffer, std::min(sizeof(skipBuffer), offset - position)))
+		{
+			throw Exception("Seeking beyond the end of the file");
+		}
+	}
+}
+
+void Read::SkipTrailer()
+{
+	while (trailerLeft > 0)
+	{
+		if (bufferedSize == 0)
+		{
+			RefillBuffer();
+
+			if (bufferedSize == 0)
+			{
+				throw Exception("Unexpected end of file while skipping the gzip trailer");
+			}
+		}
+
+		const auto progress = std::min(trailerLeft, bufferedSize);
+		bufferPtr += progress;
+		bufferedSize -= progress;
+		trailerLeft -= progress;
+	}
+}
+
+void Read::AddCheckpoint()
+{
+	Checkpoint &checkpoint{checkpoints.emplace_back()};
+	checkpoint.position = position;
+	checkpoint.fileOffset = bufferFileOffset + static_cast<long>(bufferPtr - buffer.get());
+	checkpoint.bits = gzStream.data_type & 7;
+
+	checkpoint.window.resize(32768);
+	unsigned int windowSize = 0;
+	if (inflateGetDictionary(&gzStream, checkpoint.window.data(), &windowSize) != Z_OK)
+	{
+		checkpoints.pop_back();
+		return;
+	}
+	checkpoint.window.resize(windowSize);
+}
+
+void Read::RestoreCheckpoint(const Checkpoint &checkpoint)
+{
+	if (gzStreamValid)
+	{
+		inflateEnd(&gzStream);
+		gzStreamValid = false;
+	}
+	rawStream = false;
+	trailerLeft = 0;
+
+	// the first byte may be partially consumed already
+	if (fseek(file, checkpoint.fileOffset - (checkpoint.bits ? 1 : 0), SEEK_SET))
+	{
+		throw Exception("fseek failed");
+	}
+	bufferedSize = 0;
+	RefillBuffer();
+
+	gzStream.zalloc = nullptr;
+	gzStream.zfree = nullptr;
+	gzStream.opaque = nullptr;
+	gzStream.next_in = nullptr;
+	gzStream.avail_in = 0;
+
+	if (const auto ret = inflateInit2(&gzStream, -15); ret != Z_OK) // raw deflate; the gzip header is long gone
+	{
+		throw Exception(std::string{"inflateInit2 failed: "} + zError(ret));
+	}
+	gzStreamValid = true;
+	rawStream = true;
+
+	if (checkpoint.bits)
+	{
+		if (bufferedSize == 0)
+		{
+			throw Exception("Unexpected end of file while restoring a checkpoint");
+		}
+
+		inflatePrime(&gzStream, checkpoint.bits, *bufferPtr >> (8 - checkpoint.bits));
+		++bufferPtr;
+		--bufferedSize;
+	}
+
+	if (const auto ret = inflateSetDictionary(&gzStream, checkpoint.window.data(), static_cast<unsigned int>(checkpoint.window.size())); ret != Z_OK)
+	{
+		throw Exception(std::string{"inflateSetDictionary failed: "} + zError(ret));
+	}
+
+	gzStream.next_in = bufferPtr;
+	gzStream.avail_in = bufferedSize;
+	position = checkpoint.position;
+}
+
 Write::Write(const std::string &filename)
 {
 	file = fopen(filename.c_str(), "wb");
@@ -24,6 +24,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <zlib.h>
 
@@ -37,17 +38,37 @@ static constexpr auto ChunkSize = 1024 * 1024;
 
 class Read
 {
+	// A point in the stream where inflating can be resumed without the preceding data,
+	// so seeking doesn't have to decompress everything from the start of the file.
+	struct Checkpoint
+	{
+		size_t position; // uncompressed
+		long fileOffset; // of the first byte that hasn't been completely consumed
+		int bits; // number of bits of the byte before fileOffset that still belong to the next block
+		std::vector<uint8_t> window; // last uncompressed data up to the window size
+	};
+
+	// distance of checkpoints in uncompressed bytes
+	static constexpr size_t CheckpointSpan = 512 * 1024;
+	static constexpr unsigned int GzTrailerSize = 8;
+
 	std::unique_ptr<uint8_t[]> buffer{new uint8_t[ChunkSize]};
 	uint8_t *bufferPtr = nullptr;
 
 	// the gzip struct only has size fields of unsigned int
 	// and this value is bounded by ChunkSize anyway
 	unsigned int bufferedSize = 0;
+	long bufferFileOffset = 0;
 
 	FILE *file;
 	size_t position = 0;
 	z_stream gzStream;
 	bool gzStreamValid = false;
+	bool rawStream = false; // resumed at a checkpoint; the gzip trailer has to be skipped manually
+	unsigned int trailerLeft = 0;
+
+	// built while reading, in order of position
+	std::vector<Checkpoint> checkpoints;
 
 public:
 	Read(const std::string &filename);
@@ -55,11 +76,17 @@ public:
 	size_t UncompressedSize();
 	size_t ReadData(uint8_t *toBuffer, size_t size);
 	void Rewind();
+	void Seek(size_t offset); // continues at the closest checkpoint before offset, if that is closer than the current position
+	size_t Tell() const { return position; }
+	size_t CheckpointCount() const { return checkpoints.size(); }
 
 private:
 	void CheckMagicBytes();
 	void PrepareInflate();
 	void RefillBuffer();
+	void SkipTrailer();
+	void AddCheckpoint();
+	void RestoreCheckpoint(const Checkpoint &checkpoint);
 };
 
 class Write
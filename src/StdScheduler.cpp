@@ -44,6 +44,13 @@
 
 // *** StdScheduler
 
+StdScheduler::~StdScheduler()
+{
+#ifdef __linux__
+	CloseEpoll();
+#endif
+}
+
 void StdScheduler::Clear()
 {
 	procs.clear();
@@ -51,6 +58,14 @@ void StdScheduler::Clear()
 	eventHandles.clear();
 	eventProcs.clear();
 #endif
+#ifdef __linux__
+	for (const auto &[fd, proc] : epollOwners)
+	{
+		epoll_ctl(epollFD, EPOLL_CTL_DEL, fd, nullptr);
+	}
+	epollProcs.clear();
+	epollOwners.clear();
+#endif
 }
 
 void StdScheduler::Add(StdSchedulerProc *const proc)
@@ -61,6 +76,9 @@ void StdScheduler::Add(StdSchedulerProc *const proc)
 void StdScheduler::Remove(StdSchedulerProc *const proc)
 {
 	procs.erase(proc);
+#ifdef __linux__
+	UnregisterEpoll(proc);
+#endif
 }
 
 bool StdScheduler::Execute(int iTimeout)
@@ -119,6 +137,40 @@ bool StdScheduler::Execute(int iTimeout)
 	}
 
 #else
+	bool success;
+
+#ifdef __linux__
+	if (fEpoll && InitEpoll())
+	{
+		success = ExecuteEpoll(iTimeout);
+	}
+	else
+#endif
+	{
+		success = ExecutePoll(iTimeout);
+	}
+
+#endif
+
+	for (auto *const proc : procs)
+	{
+		if (proc->GetTimeout() == 0)
+		{
+			if (!proc->Execute())
+			{
+				OnError(proc);
+				success = false;
+			}
+		}
+	}
+
+	return success;
+}
+
+#ifndef _WIN32
+
+bool StdScheduler::ExecutePoll(const int timeout)
+{
 	fds.resize(1);
 	std::unordered_map<StdSchedulerProc *, std::span<pollfd>> fdMap;
 
@@ -134,7 +186,7 @@ bool StdScheduler::Execute(int iTimeout)
 	}
 
 	// Wait for something to happen
-	const int cnt{StdSync::Poll(fds, iTimeout)};
+	const int cnt{StdSync::Poll(fds, timeout)};
 
 	bool success{true};
 
@@ -163,23 +215,209 @@ bool StdScheduler::Execute(int iTimeout)
 		printf("StdScheduler::Execute: poll failed %s\n", strerror(errno));
 	}
 
+	return success;
+}
+
 #endif
 
+#ifdef __linux__
+
+// pollfd and epoll_event share their flags
+static_assert(POLLIN == EPOLLIN && POLLOUT == EPOLLOUT && POLLPRI == EPOLLPRI && POLLERR == EPOLLERR && POLLHUP == EPOLLHUP);
+
+void StdScheduler::SetEpoll(const bool enabled)
+{
+	if (!enabled)
+	{
+		CloseEpoll();
+	}
+
+	fEpoll = enabled;
+}
+
+bool StdScheduler::InitEpoll()
+{
+	if (epollFD != -1) return true;
+
+	if ((epollFD = epoll_create1(EPOLL_CLOEXEC)) == -1)
+	{
+		printf("StdScheduler: epoll_create1 failed (%s), using poll\n", strerror(errno));
+		fEpoll = false;
+		return false;
+	}
+
+	// the unblocker is the only FD without a process
+	epoll_event event{.events = EPOLLIN, .data = {.ptr = nullptr}};
+	if (epoll_ctl(epollFD, EPOLL_CTL_ADD, unblocker.GetFD(), &event) == -1)
+	{
+		printf("StdScheduler: could not register unblocker (%s), using poll\n", strerror(errno));
+		CloseEpoll();
+		fEpoll = false;
+		return false;
+	}
+
+	return true;
+}
+
+void StdScheduler::CloseEpoll()
+{
+	if (epollFD != -1)
+	{
+		close(epollFD);
+		epollFD = -1;
+	}
+
+	epollProcs.clear();
+	epollOwners.clear();
+}
+
+void StdScheduler::RegisterEpoll(StdSchedulerProc *const proc, const int revision)
+{
+	// FDs may have been closed and reopened with the same number,
+	// so everything is registered anew
+	UnregisterEpoll(proc);
+
+	auto &registration = epollProcs[proc];
+	registration.Revision = revision;
+	proc->GetFDs(registration.FDs);
+
+	for (const auto &fd : registration.FDs)
+	{
+		if (fd.fd < 0) continue;
+
+		epoll_event event{.events = static_cast<std::uint32_t>(static_cast<unsigned short>(fd.events)), .data = {.ptr = proc}};
+		if (epoll_ctl(epollFD, EPOLL_CTL_ADD, fd.fd, &event) == -1)
+		{
+			// Still registered by a process that has not noticed yet that its FD has been closed?
+			if (errno != EEXIST || epoll_ctl(epollFD, EPOLL_CTL_MOD, fd.fd, &event) == -1)
+			{
+				printf("StdScheduler: could not register FD %d: %s\n", fd.fd, strerror(errno));
+				continue;
+			}
+		}
+
+		epollOwners.insert_or_assign(fd.fd, proc);
+	}
+}
+
+void StdScheduler::UnregisterEpoll(StdSchedulerProc *const proc)
+{
+	const auto it = epollProcs.find(proc);
+	if (it == epollProcs.end()) return;
+
+	for (const auto &fd : it->second.FDs)
+	{
+		// the number might have been reused by another process in the meantime
+		if (const auto owner = epollOwners.find(fd.fd); owner != epollOwners.end() && owner->second == proc)
+		{
+			// fails if the FD has already been closed, which is fine
+			epoll_ctl(epollFD, EPOLL_CTL_DEL, fd.fd, nullptr);
+			epollOwners.erase(owner);
+		}
+	}
+
+	epollProcs.erase(it);
+}
+
+bool StdScheduler::ExecuteEpoll(const int timeout)
+{
+	// the epoll instance itself is polled along with the FDs of processes not tracking them
+	epollPollFDs.clear();
+	epollPollFDs.push_back({.fd = epollFD, .events = POLLIN});
+	epollPollProcs.clear();
+
 	for (auto *const proc : procs)
 	{
-		if (proc->GetTimeout() == 0)
+		if (const int revision{proc->GetFDsRevision()}; revision >= 0)
 		{
-			if (!proc->Execute())
+			if (const auto it = epollProcs.find(proc); it == epollProcs.end() || it->second.Revision != revision)
 			{
-				OnError(proc);
-				success = false;
+				RegisterEpoll(proc, revision);
 			}
 		}
+		else
+		{
+			UnregisterEpoll(proc);
+
+			const std::size_t oldSize{epollPollFDs.size()};
+			proc->GetFDs(epollPollFDs);
+
+			if (epollPollFDs.size() != oldSize)
+			{
+				epollPollProcs.push_back({proc, oldSize, epollPollFDs.size()});
+			}
+		}
+	}
+
+	epollEvents.resize(epollOwners.size() + 1);
+
+	// Wait for something to happen
+	int cnt;
+	if (epollPollFDs.size() == 1)
+	{
+		cnt = epoll_wait(epollFD, epollEvents.data(), static_cast<int>(epollEvents.size()), timeout);
+	}
+	else
+	{
+		cnt = StdSync::Poll(epollPollFDs, timeout);
+		if (cnt > 0)
+		{
+			cnt = (epollPollFDs[0].revents & POLLIN) ? epoll_wait(epollFD, epollEvents.data(), static_cast<int>(epollEvents.size()), 0) : 0;
+		}
+	}
+
+	if (cnt < 0)
+	{
+		if (errno != EINTR)
+		{
+			printf("StdScheduler::Execute: epoll_wait failed %s\n", strerror(errno));
+		}
+
+		return true;
+	}
+
+	readyProcs.clear();
+
+	for (const auto &event : std::span{epollEvents}.first(cnt))
+	{
+		if (auto *const proc = static_cast<StdSchedulerProc *>(event.data.ptr); !proc)
+		{
+			// Unblocker? Flush
+			unblocker.Reset();
+		}
+		else if (std::ranges::find(readyProcs, proc) == readyProcs.end())
+		{
+			readyProcs.push_back(proc);
+		}
+	}
+
+	for (const auto &[proc, begin, end] : epollPollProcs)
+	{
+		if (std::ranges::any_of(std::span{epollPollFDs}.subspan(begin, end - begin), std::identity{}, &pollfd::revents))
+		{
+			readyProcs.push_back(proc);
+		}
+	}
+
+	bool success{true};
+
+	for (auto *const proc : readyProcs)
+	{
+		// removed by another process?
+		if (!procs.contains(proc)) continue;
+
+		if (!proc->Execute(0))
+		{
+			OnError(proc);
+			success = false;
+		}
 	}
 
 	return success;
 }
 
+#endif
+
 void StdScheduler::UnBlock()
 {
 	unblocker.Set();
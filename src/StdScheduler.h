@@ -28,6 +28,12 @@
 #include <poll.h>
 #endif
 
+#ifdef __linux__
+#include <unordered_map>
+
+#include <sys/epoll.h>
+#endif
+
 #include <thread>
 #include <unordered_set>
 
@@ -52,6 +58,11 @@ public:
 	virtual HANDLE GetEvent() { return 0; }
 #else
 	virtual void GetFDs(std::vector<pollfd> &fds) {}
+
+	// Changes whenever the set returned by GetFDs() changes, including sockets being reopened.
+	// The scheduler then only needs to fetch the FDs again after a change.
+	// -1 means the process does not keep track, so its FDs are fetched every time.
+	virtual int GetFDsRevision() { return -1; }
 #endif
 
 	// Call Execute() after this time has elapsed (no garantuees regarding accuracy)
@@ -64,7 +75,7 @@ class StdScheduler
 {
 public:
 	StdScheduler() = default;
-	virtual ~StdScheduler() = default;
+	virtual ~StdScheduler();
 
 private:
 	// Process list
@@ -82,6 +93,31 @@ private:
 	std::vector<pollfd> fds{{.fd = unblocker.GetFD(), .events = POLLIN}};
 #endif
 
+#ifdef __linux__
+	// epoll backend: processes tracking their FDs stay registered
+	// with the epoll instance, all others are polled as usual
+	struct EpollRegistration
+	{
+		int Revision;
+		std::vector<pollfd> FDs;
+	};
+
+	struct PollRange
+	{
+		StdSchedulerProc *Proc;
+		std::size_t Begin, End;
+	};
+
+	bool fEpoll{true};
+	int epollFD{-1};
+	std::unordered_map<StdSchedulerProc *, EpollRegistration> epollProcs;
+	std::unordered_map<int, StdSchedulerProc *> epollOwners;
+	std::vector<epoll_event> epollEvents;
+	std::vector<pollfd> epollPollFDs;
+	std::vector<PollRange> epollPollProcs;
+	std::vector<StdSchedulerProc *> readyProcs;
+#endif
+
 public:
 	std::size_t getProcCnt() const { return procs.size(); }
 
@@ -92,6 +128,24 @@ public:
 	bool Execute(int iTimeout = -1);
 	void UnBlock();
 
+#ifdef __linux__
+	// the poll backend is used if disabled or if epoll is not available
+	void SetEpoll(bool enabled);
+	bool isEpoll() const { return fEpoll; }
+#endif
+
+private:
+#ifndef _WIN32
+	bool ExecutePoll(int timeout);
+#endif
+#ifdef __linux__
+	bool InitEpoll();
+	void CloseEpoll();
+	bool ExecuteEpoll(int timeout);
+	void RegisterEpoll(StdSchedulerProc *proc, int revision);
+	void UnregisterEpoll(StdSchedulerProc *proc);
+#endif
+
 protected:
 	// overridable
 	virtual void OnError(StdSchedulerProc *pProc) {}
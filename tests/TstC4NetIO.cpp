@@ -19,6 +19,7 @@ using namespace std;
 bool Log(char const *text) { std::cout << text << std::endl; return true; }
 
 bool fHost;
+bool fBatchIO = false;
 int iCnt = 0, iSize = 0;
 char DummyData[1024 * 1024];
 
@@ -50,7 +51,7 @@ public:
 	{
 		if (timeGetTime() > iTime + 1000)
 		{
-			cout << iPcks << " packets in " << timeGetTime() - iTime << " ms (" << iPcks * 1000 / (timeGetTime() - iTime) << " per second, " << (iPcks ? (timeGetTime() - iTime) * 1000 / iPcks : -1u) << "us per packet)" << endl;
+			cout << (fBatchIO ? "[batched] " : "[per packet] ") << iPcks << " packets in " << timeGetTime() - iTime << " ms (" << iPcks * 1000 / (timeGetTime() - iTime) << " per second, " << (iPcks ? (timeGetTime() - iTime) * 1000 / iPcks : -1u) << "us per packet)" << endl;
 			iTime = timeGetTime(); iPcks = 0;
 		}
 		if (!rPacket.getStatus())
@@ -110,6 +111,7 @@ int main(int argc, char *argv[])
 	addr.sin_port = htons(11111);
 	addr.sin_family = AF_INET;
 	short iPort = 0;
+	bool noBatch = false;
 
 	for (i = 1; i < argc; ++i)
 	{
@@ -125,6 +127,11 @@ int main(int argc, char *argv[])
 			std::istringstream stream(std::string(arg.begin() + n + sizeof("--port="), arg.end()));
 			stream >> iPort;
 		}
+		else if (arg == "--nobatch")
+		{
+			// compare with the per-packet syscall path
+			noBatch = true;
+		}
 		else if ((n = arg.find("--size=")) != -1)
 		{
 			std::istringstream stream(std::string(arg.begin() + n + sizeof("--size="), arg.end()));
@@ -139,7 +146,7 @@ int main(int argc, char *argv[])
 	if (argc == 1)
 	{
 #ifndef _WIN32
-		cout << "Possible usage: " << argv[0] << " [--server] [address[:port]] --port=port --size=size" << std::endl << std::endl;
+		cout << "Possible usage: " << argv[0] << " [--server] [--nobatch] [address[:port]] --port=port --size=size" << std::endl << std::endl;
 #endif
 
 		cout << "Server? (j/n)";
@@ -193,6 +200,11 @@ int main(int argc, char *argv[])
 			addr.sin_family = AF_INET;
 		}
 	}
+#ifdef USE_UDP
+	NetIO.SetBatchIO(!noBatch);
+	fBatchIO = NetIO.isBatchIO();
+#endif
+
 	cout << "\nC4NetIO Init...";
 
 	if (!NetIO.Init(iPort))
@@ -0,0 +1,548 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4AulOptimizer.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// The script engine can't run without a game, so the optimized byte code is
+	// checked against a small interpreter for the int subset of the chunk types.
+	// Like C4AulExec, it evaluates operators with C4AulOptimizer::ExecIntOp, and
+	// its superinstructions fall back to the original chunk.
+	struct Value
+	{
+		enum { Nil, Int, Bool, Var, Local } Kind;
+		std::int32_t Data;
+
+		bool operator==(const Value &other) const = default;
+	};
+
+	constexpr std::size_t VarCount{10};
+	constexpr std::size_t LocalCount{4};
+
+	struct State
+	{
+		std::array<Value, VarCount> Vars{};
+		std::array<Value, LocalCount> Locals{};
+		Value Result{};
+		bool Failed{false};
+
+		bool operator==(const State &other) const = default;
+
+		// stand-in for the sync checksum of the game
+		std::uint32_t Checksum() const
+		{
+			std::uint32_t checksum{Result.Data ^ (static_cast<std::uint32_t>(Result.Kind) << 28)};
+			for (const auto &values : {std::vector<Value>{Vars.begin(), Vars.end()}, std::vector<Value>{Locals.begin(), Locals.end()}})
+				for (const Value &value : values)
+					checksum = (checksum * 31 + static_cast<std::uint32_t>(value.Data)) ^ static_cast<std::uint32_t>(value.Kind);
+			return checksum;
+		}
+	};
+
+	std::int32_t ToInt(const Value &value)
+	{
+		return value.Kind == Value::Nil ? 0 : value.Data;
+	}
+
+	std::int32_t Wrap(std::int64_t value)
+	{
+		return static_cast<std::int32_t>(static_cast<std::uint32_t>(value));
+	}
+
+	// the operator chunks use the executor's operators
+	Value EvalOp(const C4AulBCCType type, const std::int32_t a, const std::int32_t b)
+	{
+		const auto result = C4AulOptimizer::ExecIntOp(type, a, b);
+		switch (result.Type)
+		{
+		case C4V_Int: return {Value::Int, result.Value};
+		case C4V_Bool: return {Value::Bool, result.Value != 0};
+		default: return {Value::Nil, 0};
+		}
+	}
+
+	State Run(const std::vector<C4AulBCC> &code, std::size_t entry)
+	{
+		State state;
+		std::vector<Value> stack;
+		const auto deref = [&state](const Value &value) -> Value &
+		{
+			return value.Kind == Value::Var ? state.Vars[value.Data] : state.Locals[value.Data];
+		};
+		const auto isPlainInt = [](const Value &value) { return value.Kind == Value::Int; };
+		// superinstruction fast path, see C4AulExec::ExecIntOp
+		const auto execIntOp = [&](std::size_t op, std::int32_t left, std::int32_t right, bool leftOnStack)
+		{
+			const C4AulBCCType type{code[op].bccType};
+			const std::int32_t result{C4AulOptimizer::EvalIntOp(type, left, right)};
+			const Value value{C4AulOptimizer::IsIntComparison(type) ? Value::Bool : Value::Int, result};
+			if (value.Kind == Value::Bool && code[op + 1].bccType == AB_CONDN)
+			{
+				if (leftOnStack) stack.pop_back();
+				return result ? op + 2 : op + 1 + code[op + 1].bccX;
+			}
+			if (leftOnStack)
+				stack.back() = value;
+			else
+				stack.push_back(value);
+			return op + 1;
+		};
+
+		std::size_t pos{entry};
+		for (int steps{0}; steps < 1'000'000; ++steps)
+		{
+			const C4AulBCC &bcc = code[pos];
+			std::size_t next{pos + 1};
+			switch (bcc.bccType)
+			{
+			case AB_INT_OP:
+				if (isPlainInt(stack.back()))
+				{
+					next = execIntOp(pos + 1, stack.back().Data, static_cast<std::int32_t>(bcc.bccX), true);
+					break;
+				}
+				[[fallthrough]];
+			case AB_INT:
+				stack.push_back({Value::Int, static_cast<std::int32_t>(bcc.bccX)});
+				break;
+
+			case AB_BOOL:
+				stack.push_back({Value::Bool, bcc.bccX != 0});
+				break;
+
+			case AB_STACK:
+				if (bcc.bccX < 0)
+					stack.resize(stack.size() + bcc.bccX);
+				else
+					stack.resize(stack.size() + bcc.bccX, Value{Value::Nil, 0});
+				break;
+
+			case AB_VARN_R_INC:
+				if (isPlainInt(state.Vars[bcc.bccX]))
+				{
+					const C4AulBCCType op{code[pos + 1].bccType};
+					state.Vars[bcc.bccX].Data = Wrap(static_cast<std::int64_t>(state.Vars[bcc.bccX].Data) + (op == AB_Inc1 || op == AB_Inc1_Postfix ? 1 : -1));
+					next = pos + 3;
+					break;
+				}
+				[[fallthrough]];
+			case AB_VARN_R:
+				stack.push_back({Value::Var, static_cast<std::int32_t>(bcc.bccX)});
+				break;
+
+			case AB_VARN_V_INT_OP:
+				if (isPlainInt(state.Vars[bcc.bccX]))
+				{
+					next = execIntOp(pos + 2, state.Vars[bcc.bccX].Data, static_cast<std::int32_t>(code[pos + 1].bccX), false);
+					break;
+				}
+				[[fallthrough]];
+			case AB_VARN_V:
+				stack.push_back(state.Vars[bcc.bccX]);
+				break;
+
+			case AB_LOCALN_R:
+				stack.push_back({Value::Local, static_cast<std::int32_t>(bcc.bccX)});
+				break;
+
+			case AB_LOCALN_V_INT_OP:
+				if (isPlainInt(state.Locals[bcc.bccX]))
+				{
+					next = execIntOp(pos + 2, state.Locals[bcc.bccX].Data, static_cast<std::int32_t>(code[pos + 1].bccX), false);
+					break;
+				}
+				[[fallthrough]];
+			case AB_LOCALN_V:
+				stack.push_back(state.Locals[bcc.bccX]);
+				break;
+
+			case AB_Inc1: case AB_Dec1: case AB_Inc1_Postfix: case AB_Dec1_Postfix:
+			{
+				Value &var = deref(stack.back());
+				const Value old{Value::Int, ToInt(var)};
+				const bool inc{bcc.bccType == AB_Inc1 || bcc.bccType == AB_Inc1_Postfix};
+				var = {Value::Int, Wrap(static_cast<std::int64_t>(old.Data) + (inc ? 1 : -1))};
+				stack.back() = bcc.bccType == AB_Inc1_Postfix || bcc.bccType == AB_Dec1_Postfix ? old : var;
+				break;
+			}
+
+			case AB_Set:
+			{
+				const Value value{stack.back()};
+				stack.pop_back();
+				deref(stack.back()) = value;
+				stack.back() = value;
+				break;
+			}
+
+			case AB_LessThan_CONDN: case AB_LessThanEqual_CONDN: case AB_GreaterThan_CONDN: case AB_GreaterThanEqual_CONDN:
+				if (isPlainInt(stack[stack.size() - 2]) && isPlainInt(stack.back()))
+				{
+					const C4AulBCCType op{bcc.bccType == AB_LessThan_CONDN ? AB_LessThan :
+						bcc.bccType == AB_LessThanEqual_CONDN ? AB_LessThanEqual :
+						bcc.bccType == AB_GreaterThan_CONDN ? AB_GreaterThan : AB_GreaterThanEqual};
+					const std::int32_t result{C4AulOptimizer::EvalIntOp(op, stack[stack.size() - 2].Data, stack.back().Data)};
+					stack.resize(stack.size() - 2);
+					next = result ? pos + 2 : pos + 1 + code[pos + 1].bccX;
+					break;
+				}
+				// fallback: the base comparison followed by the untouched AB_CONDN
+				{
+					const C4AulBCCType op{bcc.bccType == AB_LessThan_CONDN ? AB_LessThan :
+						bcc.bccType == AB_LessThanEqual_CONDN ? AB_LessThanEqual :
+						bcc.bccType == AB_GreaterThan_CONDN ? AB_GreaterThan : AB_GreaterThanEqual};
+					const Value result{EvalOp(op, ToInt(stack[stack.size() - 2]), ToInt(stack.back()))};
+					stack.pop_back();
+					stack.back() = result;
+				}
+				break;
+
+			case AB_Div: case AB_Mul: case AB_Mod: case AB_Sub: case AB_Sum: case AB_BitAnd: case AB_BitXOr: case AB_BitOr:
+			case AB_LessThan: case AB_LessThanEqual: case AB_GreaterThan: case AB_GreaterThanEqual:
+			{
+				const Value result{EvalOp(bcc.bccType, ToInt(stack[stack.size() - 2]), ToInt(stack.back()))};
+				stack.pop_back();
+				stack.back() = result;
+				break;
+			}
+
+			case AB_JUMP:
+				next = pos + bcc.bccX;
+				break;
+
+			case AB_CONDN:
+				if (!ToInt(stack.back())) next = pos + bcc.bccX;
+				stack.pop_back();
+				break;
+
+			case AB_RETURN:
+				state.Result = stack.back();
+				return state;
+
+			default:
+				state.Failed = true;
+				return state;
+			}
+			pos = next;
+		}
+		state.Failed = true;
+		return state;
+	}
+
+	// Emits byte code shaped like the parser's output for random statements
+	class ProgramBuilder
+	{
+	public:
+		explicit ProgramBuilder(std::uint32_t seed) : rng{seed} {}
+
+		std::vector<C4AulBCC> Code;
+		std::vector<std::size_t> Entries;
+
+		void Function()
+		{
+			Entries.push_back(Code.size());
+			for (int i{Random(3) + 2}; i; --i)
+				Statement(3);
+			Expression(2);
+			Add(AB_RETURN);
+			Add(AB_EOFN);
+		}
+
+		void Finish() { Add(AB_EOF); }
+
+	private:
+		std::mt19937 rng;
+		int loopDepth{0};
+
+		static constexpr std::array Operators{AB_Div, AB_Mul, AB_Mod, AB_Sub, AB_Sum, AB_BitAnd, AB_BitXOr, AB_BitOr,
+			AB_LessThan, AB_LessThanEqual, AB_GreaterThan, AB_GreaterThanEqual};
+
+		int Random(int count) { return std::uniform_int_distribution<int>{0, count - 1}(rng); }
+
+		std::size_t Add(C4AulBCCType type, std::intptr_t x = 0)
+		{
+			Code.push_back({type, x, nullptr});
+			return Code.size() - 1;
+		}
+
+		void SetJumpHere(std::size_t jump) { Code[jump].bccX = static_cast<std::intptr_t>(Code.size() - jump); }
+		void SetJump(std::size_t jump, std::size_t target) { Code[jump].bccX = static_cast<std::intptr_t>(target) - static_cast<std::intptr_t>(jump); }
+
+		std::intptr_t Constant()
+		{
+			switch (Random(8))
+			{
+			case 0: return 0;
+			case 1: return -1;
+			case 2: return std::numeric_limits<std::int32_t>::max() - Random(3);
+			case 3: return std::numeric_limits<std::int32_t>::min() + Random(3);
+			default: return Random(41) - 20;
+			}
+		}
+
+		void Expression(int depth)
+		{
+			switch (Random(depth > 0 ? 10 : 5))
+			{
+			case 0: Add(AB_INT, Constant()); break;
+			case 1: Add(AB_VARN_V, Random(VarCount)); break;
+			case 2: Add(AB_LOCALN_V, Random(LocalCount)); break;
+			case 3: Add(AB_BOOL, Random(2)); break;
+			case 4: Add(AB_STACK, 1); break;
+			case 5:
+			{
+				// conditional operator, the jumps end in the middle of the expression
+				Condition(depth - 1);
+				const std::size_t cond{Add(AB_CONDN)};
+				Expression(depth - 1);
+				const std::size_t jump{Add(AB_JUMP)};
+				SetJumpHere(cond);
+				Expression(depth - 1);
+				SetJumpHere(jump);
+				break;
+			}
+			case 6:
+				// var op constant
+				Add(Random(2) ? AB_VARN_V : AB_LOCALN_V, Random(LocalCount));
+				Add(AB_INT, Constant());
+				Add(Operators[Random(Operators.size())]);
+				break;
+			default:
+				Expression(depth - 1);
+				Expression(depth - 1);
+				Add(Operators[Random(Operators.size())]);
+				break;
+			}
+		}
+
+		void Condition(int depth = 2)
+		{
+			switch (Random(4))
+			{
+			case 0: Add(AB_BOOL, Random(2)); break;
+			case 1: Add(AB_STACK, 1); break;
+			default: Expression(depth); break;
+			}
+		}
+
+		void Block(int depth)
+		{
+			for (int i{Random(3)}; i; --i)
+				Statement(depth);
+		}
+
+		void Statement(int depth)
+		{
+			switch (Random(depth > 0 ? 7 : 3))
+			{
+			case 0:
+			{
+				// assignment to a var that isn't a loop counter
+				const bool local{Random(3) == 0};
+				Add(local ? AB_LOCALN_R : AB_VARN_R, Random(local ? LocalCount : VarCount - 3));
+				Expression(2);
+				Add(AB_Set);
+				Add(AB_STACK, -1);
+				break;
+			}
+			case 1:
+			{
+				static constexpr std::array IncDec{AB_Inc1, AB_Dec1, AB_Inc1_Postfix, AB_Dec1_Postfix};
+				Add(AB_VARN_R, Random(VarCount - 3));
+				Add(IncDec[Random(IncDec.size())]);
+				Add(AB_STACK, -1);
+				break;
+			}
+			case 2:
+				// the parser's jump over an empty else branch
+				Add(AB_JUMP, 1);
+				break;
+			case 3: case 4:
+			{
+				Condition();
+				const std::size_t cond{Add(AB_CONDN)};
+				Block(depth - 1);
+				if (Random(2))
+				{
+					const std::size_t jump{Add(AB_JUMP)};
+					SetJumpHere(cond);
+					Block(depth - 1);
+					SetJumpHere(jump);
+				}
+				else
+					SetJumpHere(cond);
+				break;
+			}
+			default:
+			{
+				if (loopDepth >= 3) break;
+				// for (counter = 0; counter < n; counter++)
+				const std::intptr_t counter{static_cast<std::intptr_t>(VarCount - 3 + loopDepth)};
+				++loopDepth;
+				Add(AB_VARN_R, counter);
+				Add(AB_INT, 0);
+				Add(AB_Set);
+				Add(AB_STACK, -1);
+				const std::size_t start{Add(AB_VARN_V, counter)};
+				Add(AB_INT, Random(5) + 1);
+				Add(Random(2) ? AB_LessThan : AB_LessThanEqual);
+				const std::size_t cond{Add(AB_CONDN)};
+				Block(depth - 1);
+				Add(AB_VARN_R, counter);
+				Add(AB_Inc1_Postfix);
+				Add(AB_STACK, -1);
+				SetJump(Add(AB_JUMP), start);
+				SetJumpHere(cond);
+				--loopDepth;
+				break;
+			}
+			}
+		}
+	};
+
+	std::vector<C4AulBCC> Optimize(std::vector<C4AulBCC> code, std::vector<std::size_t> &entries)
+	{
+		C4AulOptimizer optimizer{code.data(), code.size()};
+		code.resize(optimizer.Optimize());
+		for (auto &entry : entries)
+			entry = optimizer.GetNewPos(entry);
+		return code;
+	}
+
+	std::vector<C4AulBCC> MakeCode(std::initializer_list<std::pair<C4AulBCCType, std::intptr_t>> chunks)
+	{
+		std::vector<C4AulBCC> code;
+		for (const auto &[type, x] : chunks)
+			code.push_back({type, x, nullptr});
+		return code;
+	}
+}
+
+TEST_CASE("C4AulOptimizer folds constants", "[C4AulOptimizer]")
+{
+	std::vector<std::size_t> entries{0};
+	const auto code = Optimize(MakeCode({{AB_INT, 2}, {AB_INT, 3}, {AB_Mul, 0}, {AB_INT, 4}, {AB_Sum, 0}, {AB_INT, 11}, {AB_LessThan, 0}, {AB_RETURN, 0}, {AB_EOFN, 0}, {AB_EOF, 0}}), entries);
+	REQUIRE(code.size() == 4);
+	CHECK(code[0].bccType == AB_BOOL);
+	CHECK(code[0].bccX == 1);
+	CHECK(code[1].bccType == AB_RETURN);
+
+	SECTION("Division by zero results in nil at runtime")
+	{
+		std::vector<std::size_t> entries{0};
+		const auto code = Optimize(MakeCode({{AB_INT, 2}, {AB_INT, 0}, {AB_Div, 0}, {AB_RETURN, 0}, {AB_EOFN, 0}, {AB_EOF, 0}}), entries);
+		CHECK(code.size() == 6);
+		CHECK(Run(code, entries[0]).Result == Value{Value::Nil, 0});
+	}
+
+	SECTION("Division of the smallest int by -1 wraps around like at runtime")
+	{
+		constexpr std::intptr_t Min{std::numeric_limits<std::int32_t>::min()};
+		std::vector<std::size_t> entries{0};
+		const auto code = Optimize(MakeCode({{AB_INT, Min}, {AB_INT, -1}, {AB_Div, 0}, {AB_RETURN, 0}, {AB_EOFN, 0}, {AB_EOF, 0}}), entries);
+		REQUIRE(code.size() == 4);
+		CHECK(code[0].bccType == AB_INT);
+		CHECK(code[0].bccX == Min);
+		CHECK(EvalOp(AB_Div, Min, -1) == Value{Value::Int, static_cast<std::int32_t>(Min)});
+		CHECK(EvalOp(AB_Mod, Min, -1) == Value{Value::Int, 0});
+	}
+
+	SECTION("Operands that are jump targets are kept")
+	{
+		std::vector<std::size_t> entries{0};
+		// x = 7; return (x ? 1 : 2) + 3;
+		const auto code = Optimize(MakeCode({
+			{AB_VARN_R, 0}, {AB_INT, 7}, {AB_Set, 0}, {AB_STACK, -1},
+			{AB_VARN_V, 0}, {AB_CONDN, 3}, {AB_INT, 1}, {AB_JUMP, 2}, {AB_INT, 2},
+			{AB_INT, 3}, {AB_Sum, 0}, {AB_RETURN, 0}, {AB_EOFN, 0}, {AB_EOF, 0}}), entries);
+		CHECK(Run(code, entries[0]).Result == Value{Value::Int, 4});
+	}
+}
+
+TEST_CASE("C4AulOptimizer removes constant conditions and dead jumps", "[C4AulOptimizer]")
+{
+	std::vector<std::size_t> entries{0};
+	// if (false) x = 1; else x = 2; return x;
+	const auto code = Optimize(MakeCode({
+		{AB_BOOL, 0}, {AB_CONDN, 6},
+		{AB_VARN_R, 0}, {AB_INT, 1}, {AB_Set, 0}, {AB_STACK, -1}, {AB_JUMP, 5},
+		{AB_VARN_R, 0}, {AB_INT, 2}, {AB_Set, 0}, {AB_STACK, -1},
+		{AB_JUMP, 1},
+		{AB_VARN_V, 0}, {AB_RETURN, 0}, {AB_EOFN, 0}, {AB_EOF, 0}}), entries);
+	CHECK(code.size() == 14);
+	CHECK(code[0].bccType == AB_JUMP);
+	CHECK(code[0].bccX == 6);
+	CHECK(Run(code, entries[0]).Result == Value{Value::Int, 2});
+}
+
+TEST_CASE("C4AulOptimizer threads jumps", "[C4AulOptimizer]")
+{
+	std::vector<std::size_t> entries{0};
+	const auto code = Optimize(MakeCode({{AB_JUMP, 2}, {AB_EOFN, 0}, {AB_JUMP, 2}, {AB_EOFN, 0}, {AB_INT, 1}, {AB_RETURN, 0}, {AB_EOFN, 0}, {AB_EOF, 0}}), entries);
+	REQUIRE(code[0].bccType == AB_JUMP);
+	CHECK(code[0].bccX == 4);
+	CHECK(Run(code, entries[0]).Result == Value{Value::Int, 1});
+}
+
+TEST_CASE("C4AulOptimizer builds superinstructions", "[C4AulOptimizer]")
+{
+	std::vector<std::size_t> entries{0};
+	// for (i = 0; i < 10; i++) x = x + 3; return x;
+	const auto code = Optimize(MakeCode({
+		{AB_VARN_R, 0}, {AB_INT, 0}, {AB_Set, 0}, {AB_STACK, -1},
+		{AB_VARN_V, 0}, {AB_INT, 10}, {AB_LessThan, 0}, {AB_CONDN, 11},
+		{AB_VARN_R, 1}, {AB_VARN_V, 1}, {AB_INT, 3}, {AB_Sum, 0}, {AB_Set, 0}, {AB_STACK, -1},
+		{AB_VARN_R, 0}, {AB_Inc1_Postfix, 0}, {AB_STACK, -1}, {AB_JUMP, -13},
+		{AB_VARN_V, 1}, {AB_RETURN, 0}, {AB_EOFN, 0}, {AB_EOF, 0}}), entries);
+	CHECK(code[4].bccType == AB_VARN_V_INT_OP);
+	CHECK(code[9].bccType == AB_VARN_V_INT_OP);
+	CHECK(code[14].bccType == AB_VARN_R_INC);
+	// x starts as nil, so the first addition takes the fallback
+	CHECK(Run(code, entries[0]).Result == Value{Value::Int, 30});
+}
+
+TEST_CASE("C4AulOptimizer keeps the results of random programs", "[C4AulOptimizer]")
+{
+	for (std::uint32_t seed{0}; seed < 2000; ++seed)
+	{
+		ProgramBuilder builder{seed};
+		builder.Function();
+		builder.Function();
+		builder.Finish();
+
+		std::vector<std::size_t> entries{builder.Entries};
+		const auto optimized = Optimize(builder.Code, entries);
+		CHECK(optimized.size() <= builder.Code.size());
+
+		for (std::size_t i{0}; i < entries.size(); ++i)
+		{
+			INFO("seed " << seed << ", function " << i);
+			const State expected{Run(builder.Code, builder.Entries[i])};
+			const State actual{Run(optimized, entries[i])};
+			REQUIRE_FALSE(expected.Failed);
+			CHECK(actual == expected);
+			CHECK(actual.Checksum() == expected.Checksum());
+		}
+	}
+}
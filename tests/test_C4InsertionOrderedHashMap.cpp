@@ -0,0 +1,290 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4InsertionOrderedHashMap.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	// layout of the previous C4ValueHash: unordered_map to heap-allocated values plus a list for the key order
+	template<typename Key, typename Value>
+	class LegacyOrderedMap
+	{
+		struct MapEntry
+		{
+			std::unique_ptr<Value> value;
+			typename std::list<const Key *>::iterator keyOrderIterator;
+		};
+
+		std::unordered_map<Key, MapEntry> map;
+		std::list<const Key *> keyOrder;
+
+	public:
+		Value &operator[](const Key &key)
+		{
+			const auto [it, inserted] = map.try_emplace(key);
+			if (inserted)
+			{
+				it->second.value = std::make_unique<Value>();
+				it->second.keyOrderIterator = keyOrder.insert(keyOrder.end(), &it->first);
+			}
+			return *it->second.value;
+		}
+
+		const Value *Find(const Key &key) const
+		{
+			const auto it = map.find(key);
+			return it != map.end() ? it->second.value.get() : nullptr;
+		}
+
+		void Erase(const Key &key)
+		{
+			const auto it = map.find(key);
+			keyOrder.erase(it->second.keyOrderIterator);
+			map.erase(it);
+		}
+
+		template<typename Func>
+		void ForEach(Func &&func) const
+		{
+			for (const auto *const key : keyOrder) func(*key, *map.at(*key).value);
+		}
+	};
+
+	using Map = C4InsertionOrderedHashMap<std::int32_t, std::int32_t>;
+
+	// counts how often an entry has been relocated in its value
+	struct CountingRelocate
+	{
+		void operator()(auto &from, auto &to) const
+		{
+			to.key = from.key;
+			to.value = from.value + 1;
+		}
+	};
+
+	std::vector<std::int32_t> Keys(const Map &map)
+	{
+		std::vector<std::int32_t> keys;
+		for (std::size_t i{map.NextLivePosition(0)}; i < map.EntryCount(); i = map.NextLivePosition(i + 1))
+		{
+			keys.push_back(map.GetEntry(i).key);
+		}
+		return keys;
+	}
+
+	std::vector<std::string> MakeStringKeys(const std::int32_t count)
+	{
+		std::vector<std::string> keys;
+		keys.reserve(count);
+		for (std::int32_t i{0}; i < count; ++i)
+		{
+			keys.push_back("Key" + std::to_string(i * 7919));
+		}
+		return keys;
+	}
+}
+
+TEST_CASE("C4InsertionOrderedHashMap inserts and finds entries", "[C4InsertionOrderedHashMap]")
+{
+	Map map;
+	CHECK(map.empty());
+	CHECK(map.Find(1) == nullptr);
+
+	for (std::int32_t i{0}; i < 100; ++i)
+	{
+		const auto [entry, inserted] = map.Insert(i * 3);
+		REQUIRE(inserted);
+		entry->value = i;
+	}
+
+	CHECK(map.size() == 100);
+	for (std::int32_t i{0}; i < 100; ++i)
+	{
+		const auto *const entry = map.Find(i * 3);
+		REQUIRE(entry);
+		CHECK(entry->value == i);
+		CHECK(map.Find(i * 3 + 1) == nullptr);
+	}
+
+	const auto [entry, inserted] = map.Insert(30);
+	CHECK_FALSE(inserted);
+	CHECK(entry->value == 10);
+	CHECK(map.size() == 100);
+}
+
+TEST_CASE("C4InsertionOrderedHashMap keeps insertion order across erasure and compaction", "[C4InsertionOrderedHashMap]")
+{
+	Map map;
+	std::vector<std::int32_t> expected;
+	for (std::int32_t i{0}; i < 64; ++i)
+	{
+		map.Insert(63 - i);
+		expected.push_back(63 - i);
+	}
+
+	// erase every other entry; the entries stay in place until the next growth
+	for (std::int32_t i{0}; i < 64; i += 2)
+	{
+		map.Erase(*map.Find(i));
+		std::erase(expected, i);
+	}
+	CHECK(map.size() == 32);
+	CHECK(Keys(map) == expected);
+
+	// reinserting an erased key appends it
+	map.Insert(0);
+	expected.push_back(0);
+	CHECK(Keys(map) == expected);
+
+	for (std::int32_t i{100}; i < 300; ++i)
+	{
+		map.Insert(i);
+		expected.push_back(i);
+	}
+	CHECK(map.EntryCount() == map.size());
+	CHECK(Keys(map) == expected);
+	for (const auto key : expected) CHECK(map.Find(key));
+	CHECK(map.Find(2) == nullptr);
+}
+
+TEST_CASE("C4InsertionOrderedHashMap resumes iterations by sequence number", "[C4InsertionOrderedHashMap]")
+{
+	Map map;
+	for (std::int32_t i{0}; i < 4; ++i) map.Insert(i);
+
+	const auto second = map.GetEntry(1).sequence;
+	map.Erase(*map.Find(2));
+	// growth compacts the erased entry away
+	for (std::int32_t i{4}; i < 10; ++i) map.Insert(i);
+
+	CHECK(map.GetEntry(map.PositionOfSequence(second + 1)).key == 3);
+	CHECK(map.PositionOfSequence(map.GetEntry(map.EntryCount() - 1).sequence + 1) == map.EntryCount());
+}
+
+TEST_CASE("C4InsertionOrderedHashMap relocates entries on growth", "[C4InsertionOrderedHashMap]")
+{
+	C4InsertionOrderedHashMap<std::int32_t, std::int32_t, std::hash<std::int32_t>, std::equal_to<std::int32_t>, CountingRelocate> map;
+	for (std::int32_t i{0}; i < 5; ++i) map.Insert(i);
+
+	// the first four entries have been relocated once when the fifth was inserted
+	CHECK(map.Find(0)->value == 1);
+	CHECK(map.Find(3)->value == 1);
+	CHECK(map.Find(4)->value == 0);
+}
+
+TEST_CASE("C4InsertionOrderedHashMap benchmark", "[.][benchmark]")
+{
+	constexpr std::int32_t Count{10000};
+	const auto stringKeys = MakeStringKeys(Count);
+
+	BENCHMARK("Insert int, legacy layout")
+	{
+		LegacyOrderedMap<std::int32_t, std::int32_t> map;
+		for (std::int32_t i{0}; i < Count; ++i) map[i] = i;
+		return map.Find(Count / 2);
+	};
+
+	BENCHMARK("Insert int")
+	{
+		Map map;
+		for (std::int32_t i{0}; i < Count; ++i) map.Insert(i).first->value = i;
+		return map.size();
+	};
+
+	BENCHMARK("Insert string, legacy layout")
+	{
+		LegacyOrderedMap<std::string, std::int32_t> map;
+		for (std::int32_t i{0}; i < Count; ++i) map[stringKeys[i]] = i;
+		return map.Find(stringKeys[0]);
+	};
+
+	BENCHMARK("Insert string")
+	{
+		C4InsertionOrderedHashMap<std::string, std::int32_t> map;
+		for (std::int32_t i{0}; i < Count; ++i) map.Insert(stringKeys[i]).first->value = i;
+		return map.size();
+	};
+
+	LegacyOrderedMap<std::string, std::int32_t> legacyMap;
+	C4InsertionOrderedHashMap<std::string, std::int32_t> map;
+	for (std::int32_t i{0}; i < Count; ++i)
+	{
+		legacyMap[stringKeys[i]] = i;
+		map.Insert(stringKeys[i]).first->value = i;
+	}
+
+	BENCHMARK("Lookup string, legacy layout")
+	{
+		std::int64_t sum{0};
+		for (const auto &key : stringKeys) sum += *legacyMap.Find(key);
+		return sum;
+	};
+
+	BENCHMARK("Lookup string")
+	{
+		std::int64_t sum{0};
+		for (const auto &key : stringKeys) sum += map.Find(key)->value;
+		return sum;
+	};
+
+	BENCHMARK("Iterate, legacy layout")
+	{
+		std::int64_t sum{0};
+		legacyMap.ForEach([&sum](const auto &, const std::int32_t value) { sum += value; });
+		return sum;
+	};
+
+	BENCHMARK("Iterate")
+	{
+		std::int64_t sum{0};
+		for (std::size_t i{map.NextLivePosition(0)}; i < map.EntryCount(); i = map.NextLivePosition(i + 1))
+		{
+			sum += map.GetEntry(i).value;
+		}
+		return sum;
+	};
+
+	BENCHMARK("Insert and erase churn, legacy layout")
+	{
+		LegacyOrderedMap<std::int32_t, std::int32_t> churn;
+		for (std::int32_t i{0}; i < Count; ++i)
+		{
+			churn[i] = i;
+			if (i >= 64) churn.Erase(i - 64);
+		}
+		return churn.Find(Count - 1);
+	};
+
+	BENCHMARK("Insert and erase churn")
+	{
+		Map churn;
+		for (std::int32_t i{0}; i < Count; ++i)
+		{
+			churn.Insert(i).first->value = i;
+			if (i >= 64) churn.Erase(*churn.Find(i - 64));
+		}
+		return churn.size();
+	};
+}
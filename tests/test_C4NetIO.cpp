@@ -0,0 +1,261 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4NetIO.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	StdBuf MakeData(const std::size_t size)
+	{
+		StdBuf buf;
+		buf.New(size);
+		std::iota(buf.getMPtr<std::uint8_t>(), buf.getMPtr<std::uint8_t>() + size, std::uint8_t{0});
+		return buf;
+	}
+
+	bool SameContents(const StdBuf &buf, const StdBuf &other)
+	{
+		return buf.getSize() == other.getSize() && !buf.Compare(other);
+	}
+
+	// accepts all connections and keeps copies of all received packets
+	class Endpoint : public C4NetIO::CBClass
+	{
+	public:
+		explicit Endpoint(std::unique_ptr<C4NetIO> netIO) : NetIO{std::move(netIO)} { NetIO->SetCallback(this); }
+		~Endpoint() { NetIO->Close(); }
+
+		std::unique_ptr<C4NetIO> NetIO;
+		std::vector<C4NetIO::addr_t> Peers;
+		std::vector<StdBuf> Packets;
+
+		virtual bool OnConn(const C4NetIO::addr_t &AddrPeer, const C4NetIO::addr_t &AddrConnect, const C4NetIO::addr_t *pOwnAddr, C4NetIO *pNetIO) override
+		{
+			Peers.push_back(AddrPeer);
+			return true;
+		}
+
+		virtual void OnPacket(const C4NetIOPacket &rPacket, C4NetIO *pNetIO) override
+		{
+			Packets.push_back(rPacket.Duplicate());
+		}
+	};
+
+	// executes all endpoints until the condition is met or the time is up
+	bool ExecuteUntil(const std::vector<Endpoint *> &endpoints, const std::function<bool()> &condition)
+	{
+		for (int i{0}; i < 500 && !condition(); ++i)
+			for (Endpoint *const endpoint : endpoints)
+				endpoint->NetIO->Execute(10);
+		return condition();
+	}
+
+	// connects clientCount clients to a host and broadcasts an unshared and a shared packet from the host to all of them
+	template<typename NetIO>
+	void CheckBroadcast(const std::uint16_t hostPort, const std::size_t clientCount, const bool clientsNeedPort)
+	{
+		Endpoint host{std::make_unique<NetIO>()};
+		REQUIRE(host.NetIO->Init(hostPort));
+
+		std::vector<std::unique_ptr<Endpoint>> clients;
+		std::vector<Endpoint *> endpoints{&host};
+		for (std::size_t i{0}; i < clientCount; ++i)
+		{
+			auto &client = clients.emplace_back(std::make_unique<Endpoint>(std::make_unique<NetIO>()));
+			REQUIRE(client->NetIO->Init(clientsNeedPort ? static_cast<std::uint16_t>(hostPort + 1 + i) : C4NetIO::addr_t::IPPORT_NONE));
+			REQUIRE(client->NetIO->Connect(C4NetIO::addr_t{C4Network2HostAddress::Loopback, hostPort}));
+			endpoints.push_back(client.get());
+		}
+		REQUIRE(ExecuteUntil(endpoints, [&] { return host.Peers.size() == clientCount; }));
+		for (const auto &peer : host.Peers)
+			REQUIRE(host.NetIO->SetBroadcast(peer));
+
+		// big enough to be split into several UDP fragments
+		C4NetIOPacket packet{MakeData(5000)};
+		REQUIRE(host.NetIO->Broadcast(packet));
+		// the caller's packet is left alone
+		CHECK_FALSE(packet.isShared());
+		CHECK(SameContents(packet, MakeData(5000)));
+
+		// C4Network2IO shares the packet before passing it to all connections
+		const C4NetIOPacket shared{C4NetIOPacket{MakeData(3000)}.Share()};
+		const void *const sharedData{shared.getData()};
+		REQUIRE(host.NetIO->Broadcast(shared));
+		CHECK(shared.getData() == sharedData);
+
+		REQUIRE(ExecuteUntil(endpoints, [&]
+		{
+			return std::ranges::all_of(clients, [](const auto &client) { return client->Packets.size() >= 2; });
+		}));
+		for (const auto &client : clients)
+		{
+			REQUIRE(client->Packets.size() == 2);
+			CHECK(SameContents(client->Packets[0], packet));
+			CHECK(SameContents(client->Packets[1], shared));
+		}
+	}
+}
+
+TEST_CASE("C4NetIOPacket copies", "[C4NetIO]")
+{
+	SECTION("Copies of unshared packets duplicate the data")
+	{
+		const C4NetIOPacket packet{MakeData(100)};
+		const C4NetIOPacket copy{packet};
+		CHECK(copy.getData() != packet.getData());
+		CHECK(SameContents(copy, packet));
+		CHECK_FALSE(copy.isShared());
+
+		C4NetIOPacket assigned;
+		assigned = packet;
+		CHECK(assigned.getData() != packet.getData());
+		CHECK(SameContents(assigned, packet));
+	}
+
+	SECTION("Copies of shared packets reference the data")
+	{
+		const C4NetIOPacket packet{C4NetIOPacket{MakeData(100)}.Share()};
+		REQUIRE(packet.isShared());
+		const C4NetIOPacket copy{packet};
+		CHECK(copy.getData() == packet.getData());
+		CHECK(copy.isShared());
+
+		C4NetIOPacket assigned{MakeData(10)};
+		assigned = packet;
+		CHECK(assigned.getData() == packet.getData());
+		CHECK(assigned.isShared());
+	}
+
+	SECTION("Shared data lives as long as any copy")
+	{
+		C4NetIOPacket packet{C4NetIOPacket{MakeData(100)}.Share()};
+		const C4NetIOPacket copy{packet};
+		const void *const data{copy.getData()};
+		packet.Clear();
+		CHECK(packet.isNull());
+		CHECK_FALSE(packet.isShared());
+		CHECK(copy.getData() == data);
+		CHECK(SameContents(copy, MakeData(100)));
+	}
+
+	SECTION("Copies keep the address")
+	{
+		const C4NetIO::addr_t addr{C4Network2HostAddress::Loopback, 1234};
+		const C4NetIOPacket packet{MakeData(10), addr};
+		CHECK(C4NetIOPacket{packet}.getAddr() == addr);
+		CHECK(packet.Share().getAddr() == addr);
+		CHECK(C4NetIOPacket{packet.Share()}.getAddr() == addr);
+	}
+}
+
+TEST_CASE("C4NetIOPacket moves", "[C4NetIO]")
+{
+	SECTION("Moving an owning packet takes the data")
+	{
+		C4NetIOPacket packet{MakeData(100)};
+		const void *const data{packet.getData()};
+		const C4NetIOPacket moved{std::move(packet)};
+		CHECK(moved.getData() == data);
+		CHECK_FALSE(moved.isRef());
+	}
+
+	SECTION("Moving a referencing packet copies the data")
+	{
+		const StdBuf data{MakeData(100)};
+		C4NetIOPacket packet{data.getData(), data.getSize()};
+		REQUIRE(packet.isRef());
+		const C4NetIOPacket moved{std::move(packet)};
+		CHECK(moved.getData() != data.getData());
+		CHECK_FALSE(moved.isRef());
+		CHECK(SameContents(moved, data));
+
+		C4NetIOPacket assigned;
+		assigned = C4NetIOPacket{data.getData(), data.getSize()};
+		CHECK(assigned.getData() != data.getData());
+		CHECK_FALSE(assigned.isRef());
+	}
+
+	SECTION("Moving a shared packet takes the share")
+	{
+		C4NetIOPacket packet{C4NetIOPacket{MakeData(100)}.Share()};
+		const void *const data{packet.getData()};
+		C4NetIOPacket moved{std::move(packet)};
+		CHECK(moved.getData() == data);
+		CHECK(moved.isShared());
+		CHECK_FALSE(packet.isShared());
+		CHECK(packet.isNull());
+
+		C4NetIOPacket assigned;
+		assigned = std::move(moved);
+		CHECK(assigned.getData() == data);
+		CHECK(assigned.isShared());
+		CHECK_FALSE(moved.isShared());
+		CHECK(moved.isNull());
+	}
+}
+
+TEST_CASE("C4NetIOPacket::Share", "[C4NetIO]")
+{
+	SECTION("Sharing copies the data of an unshared packet once")
+	{
+		const C4NetIOPacket packet{MakeData(100)};
+		const C4NetIOPacket shared{packet.Share()};
+		CHECK(shared.isShared());
+		CHECK(shared.getData() != packet.getData());
+		CHECK(SameContents(shared, packet));
+		CHECK_FALSE(packet.isShared());
+
+		// sharing again doesn't copy
+		CHECK(shared.Share().getData() == shared.getData());
+	}
+
+	SECTION("Sharing a temporary takes its data")
+	{
+		C4NetIOPacket packet{MakeData(100)};
+		const void *const data{packet.getData()};
+		const C4NetIOPacket shared{std::move(packet).Share()};
+		CHECK(shared.isShared());
+		CHECK(shared.getData() == data);
+	}
+
+	SECTION("Packets referencing shared data aren't shared")
+	{
+		const C4NetIOPacket shared{C4NetIOPacket{MakeData(100)}.Share()};
+		const C4NetIOPacket ref{shared.getData(), shared.getSize()};
+		CHECK(ref.getData() == shared.getData());
+		CHECK_FALSE(ref.isShared());
+		CHECK(C4NetIOPacket{ref}.getData() != shared.getData());
+	}
+}
+
+TEST_CASE("C4NetIOTCP broadcasts to all clients", "[C4NetIO]")
+{
+	CheckBroadcast<C4NetIOTCP>(39510, 3, false);
+}
+
+TEST_CASE("C4NetIOUDP broadcasts to all clients", "[C4NetIO]")
+{
+	CheckBroadcast<C4NetIOUDP>(39520, 3, true);
+}
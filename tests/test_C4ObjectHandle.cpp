@@ -0,0 +1,82 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4ObjectHandle.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	// only the addresses are used
+	C4Object *FakeObject(const std::uintptr_t id)
+	{
+		return reinterpret_cast<C4Object *>(id * 16);
+	}
+}
+
+TEST_CASE("C4ObjectHandleTable resolves handles of existing objects")
+{
+	C4ObjectHandleTable table;
+	const std::uint32_t slot1{table.Register(FakeObject(1))};
+	const std::uint32_t slot2{table.Register(FakeObject(2))};
+
+	CHECK(slot1 != 0);
+	CHECK(slot2 != 0);
+	CHECK(slot1 != slot2);
+	CHECK(table.Get(table.GetHandle(slot1)) == FakeObject(1));
+	CHECK(table.Get(table.GetHandle(slot2)) == FakeObject(2));
+	CHECK(table.GetHandle(slot1) != table.GetHandle(slot2));
+	CHECK(table.GetInvalidationCount() == 0);
+}
+
+TEST_CASE("C4ObjectHandleTable invalidates handles taken before a removal")
+{
+	C4ObjectHandleTable table;
+	const std::uint32_t slot{table.Register(FakeObject(1))};
+	const C4ObjectHandle before{table.GetHandle(slot)};
+
+	table.Invalidate(slot);
+	CHECK_FALSE(table.IsValid(before));
+	CHECK(table.Get(before) == nullptr);
+	CHECK(table.GetInvalidationCount() == 1);
+
+	// the removed object can still be referenced until it is deleted
+	const C4ObjectHandle after{table.GetHandle(slot)};
+	CHECK(table.Get(after) == FakeObject(1));
+
+	table.Release(slot);
+	CHECK(table.Get(after) == nullptr);
+	CHECK(table.GetInvalidationCount() == 2);
+}
+
+TEST_CASE("C4ObjectHandleTable reuses slots without reviving old handles")
+{
+	C4ObjectHandleTable table;
+	const std::uint32_t slot{table.Register(FakeObject(1))};
+	const C4ObjectHandle old{table.GetHandle(slot)};
+	table.Release(slot);
+
+	const std::uint32_t reused{table.Register(FakeObject(2))};
+	REQUIRE(reused == slot);
+	CHECK(table.Get(old) == nullptr);
+	CHECK(table.Get(table.GetHandle(reused)) == FakeObject(2));
+}
+
+TEST_CASE("C4ObjectHandleTable rejects handles of unknown slots")
+{
+	C4ObjectHandleTable table;
+	CHECK(table.Get(C4ObjectHandle{0, 0}) == nullptr);
+	CHECK(table.Get(C4ObjectHandle{42, 1}) == nullptr);
+}
@@ -0,0 +1,237 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4ObjectTypeIndex.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <ranges>
+#include <vector>
+
+namespace
+{
+	struct Object
+	{
+		unsigned long id;
+		std::int32_t Category;
+	};
+
+	struct Link
+	{
+		Object *Obj;
+		Link *Prev{nullptr};
+		Link *Next{nullptr};
+	};
+
+	using Index = C4ObjectTypeIndex<Object, Link, unsigned long>;
+
+	constexpr unsigned long IDCount{5};
+	constexpr std::int32_t CategoryBits{6};
+
+	// a linked object list like C4ObjectList, which keeps the index up to date like C4GameObjects
+	class List
+	{
+		std::vector<std::unique_ptr<Object>> objects;
+		std::vector<std::unique_ptr<Link>> links;
+
+	public:
+		Link *First{nullptr};
+		Index TypeIndex;
+
+		std::size_t Size() const { return links.size(); }
+
+		Link *Get(std::size_t i) const
+		{
+			Link *link{First};
+			while (i--) link = link->Next;
+			return link;
+		}
+
+		// insert a new object before the given link, or at the end
+		Link *Insert(const unsigned long id, const std::int32_t category, Link *const before)
+		{
+			Object *const obj{objects.emplace_back(std::make_unique<Object>(Object{id, category})).get()};
+			Link *const link{links.emplace_back(std::make_unique<Link>(Link{obj})).get()};
+			Attach(link, before);
+			TypeIndex.Insert(link);
+			return link;
+		}
+
+		void Remove(Link *const link)
+		{
+			TypeIndex.Remove(link->Obj);
+			Detach(link);
+			std::erase_if(links, [link](const auto &other) { return other.get() == link; });
+		}
+
+		// move a link within the list and reindex its object, like SetObjectOrder does
+		void Move(Link *const link, Link *const before)
+		{
+			Detach(link);
+			Attach(link, before);
+			TypeIndex.Remove(link->Obj);
+			TypeIndex.Insert(link);
+		}
+
+		// change the category of an object and reindex it, like SetCategory does
+		void SetCategory(Link *const link, const std::int32_t category)
+		{
+			link->Obj->Category = category;
+			TypeIndex.Remove(link->Obj);
+			TypeIndex.Insert(link);
+		}
+
+		// rearrange all links directly and rebuild the index, like resorts do
+		void Shuffle(std::mt19937 &random)
+		{
+			std::vector<Link *> order;
+			for (Link *link{First}; link; link = link->Next) order.push_back(link);
+			std::ranges::shuffle(order, random);
+			First = nullptr;
+			for (Link *const link : order)
+			{
+				link->Prev = link->Next = nullptr;
+				Attach(link, nullptr);
+			}
+			TypeIndex.Rebuild(First);
+		}
+
+	private:
+		void Attach(Link *const link, Link *const before)
+		{
+			Link *const prev{before ? before->Prev : Last()};
+			link->Prev = prev;
+			link->Next = before;
+			(prev ? prev->Next : First) = link;
+			if (before) before->Prev = link;
+		}
+
+		void Detach(Link *const link)
+		{
+			(link->Prev ? link->Prev->Next : First) = link->Next;
+			if (link->Next) link->Next->Prev = link->Prev;
+			link->Prev = link->Next = nullptr;
+		}
+
+		Link *Last() const
+		{
+			Link *link{First};
+			while (link && link->Next) link = link->Next;
+			return link;
+		}
+	};
+
+	std::vector<Object *> Indexed(const Index::Objects &objects)
+	{
+		const auto values = std::views::values(objects);
+		return {values.begin(), values.end()};
+	}
+
+	template<typename Predicate>
+	std::vector<Object *> Scan(const List &list, Predicate &&predicate)
+	{
+		std::vector<Object *> result;
+		for (Link *link{list.First}; link; link = link->Next)
+			if (predicate(*link->Obj))
+				result.push_back(link->Obj);
+		return result;
+	}
+
+	// the index must contain the same objects in the same order as a linear scan of the list
+	void CheckIndex(const List &list)
+	{
+		REQUIRE(list.TypeIndex.Size() == list.Size());
+		for (unsigned long id{0}; id <= IDCount; ++id)
+			REQUIRE(Indexed(list.TypeIndex.ByID(id)) == Scan(list, [id](const Object &obj) { return obj.id == id; }));
+		for (std::int32_t bit{0}; bit < CategoryBits; ++bit)
+		{
+			const auto dwBit = std::uint32_t{1} << bit;
+			REQUIRE(Indexed(list.TypeIndex.ByCategory(dwBit)) == Scan(list, [dwBit](const Object &obj) { return (obj.Category & dwBit) != 0; }));
+		}
+	}
+}
+
+TEST_CASE("C4ObjectTypeIndex matches a linear scan", "[C4ObjectTypeIndex]")
+{
+	std::mt19937 random{1234};
+	const auto randomID = [&random] { return std::uniform_int_distribution<unsigned long>{0, IDCount}(random); };
+	const auto randomCategory = [&random] { return std::uniform_int_distribution<std::int32_t>{0, (1 << CategoryBits) - 1}(random); };
+	const auto randomLink = [&random](const List &list) -> Link *
+	{
+		return list.Size() ? list.Get(std::uniform_int_distribution<std::size_t>{0, list.Size() - 1}(random)) : nullptr;
+	};
+
+	List list;
+
+	SECTION("Inserting and removing")
+	{
+		for (int i{0}; i < 2000; ++i)
+		{
+			if (list.Size() > 50 && random() % 3 == 0)
+				list.Remove(randomLink(list));
+			else
+				list.Insert(randomID(), randomCategory(), random() % 4 ? randomLink(list) : nullptr);
+			if (i % 50 == 0) CheckIndex(list);
+		}
+		CheckIndex(list);
+	}
+
+	SECTION("Moving and changing categories")
+	{
+		for (int i{0}; i < 200; ++i)
+			list.Insert(randomID(), randomCategory(), randomLink(list));
+		for (int i{0}; i < 1000; ++i)
+		{
+			Link *const link{randomLink(list)};
+			if (random() % 2)
+				list.SetCategory(link, randomCategory());
+			else if (Link *const before{randomLink(list)}; before != link)
+				list.Move(link, before);
+			if (i % 50 == 0) CheckIndex(list);
+		}
+		CheckIndex(list);
+	}
+
+	SECTION("Resorting")
+	{
+		for (int i{0}; i < 200; ++i)
+			list.Insert(randomID(), randomCategory(), nullptr);
+		list.Shuffle(random);
+		CheckIndex(list);
+		// the rebuilt index keeps working with later insertions
+		for (int i{0}; i < 200; ++i)
+			list.Insert(randomID(), randomCategory(), randomLink(list));
+		CheckIndex(list);
+	}
+
+	SECTION("Inserting at the same position until labels run out")
+	{
+		for (int i{0}; i < 10; ++i)
+			list.Insert(randomID(), randomCategory(), nullptr);
+		Link *const before{list.Get(5)};
+		// each object is inserted right before the next one, halving the gap every time
+		for (int i{0}; i < 500; ++i)
+			list.Insert(randomID(), randomCategory(), before);
+		CheckIndex(list);
+		// the same at the start of the list
+		for (int i{0}; i < 500; ++i)
+			list.Insert(randomID(), randomCategory(), list.First);
+		CheckIndex(list);
+	}
+}
@@ -0,0 +1,122 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4ParallelRows.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct Rendering
+	{
+		std::vector<std::uint8_t> Pixels;
+		std::vector<std::uint8_t> Callbacks; // one bit per pixel, like the map creator callback arrays
+	};
+
+	// stand-in for an overlay tree: a pure function of the position
+	std::uint8_t RenderPix(const std::int32_t x, const std::int32_t y)
+	{
+		std::uint32_t value{static_cast<std::uint32_t>(x) * 2531011u ^ static_cast<std::uint32_t>(y) * 214013u};
+		value ^= value >> 13;
+		value *= 0x5bd1e995u;
+		return static_cast<std::uint8_t>((value >> 24) % 5);
+	}
+
+	Rendering Render(const std::int32_t width, const std::int32_t height, const std::int32_t pitch, const std::int32_t threadCount)
+	{
+		Rendering result{std::vector<std::uint8_t>(pitch * height, 0xff), std::vector<std::uint8_t>((width * height + 7) / 8)};
+		std::vector<std::jthread> workers;
+		C4ParallelRows(height, 16, threadCount,
+			[&workers](auto &&worker) { workers.emplace_back(std::forward<decltype(worker)>(worker)); },
+			[&](const std::int32_t firstRow, const std::int32_t rowCount)
+			{
+				for (std::int32_t y{firstRow}; y < firstRow + rowCount; ++y)
+				{
+					for (std::int32_t x{0}; x < width; ++x)
+					{
+						const std::uint8_t pix{RenderPix(x, y)};
+						result.Pixels[y * pitch + x] = pix;
+						if (pix == 3)
+						{
+							const std::int32_t index{x + y * width};
+							std::atomic_ref<std::uint8_t>{result.Callbacks[index / 8]}.fetch_or(static_cast<std::uint8_t>(1 << (index % 8)), std::memory_order_relaxed);
+						}
+					}
+				}
+			});
+		return result;
+	}
+}
+
+TEST_CASE("C4ParallelRows renders every row exactly once", "[C4ParallelRows]")
+{
+	for (const std::int32_t height : {0, 1, 15, 16, 17, 100, 257})
+	{
+		for (const std::int32_t threadCount : {1, 2, 8, 64})
+		{
+			std::vector<std::atomic<std::int32_t>> rendered(height);
+			std::vector<std::jthread> workers;
+			C4ParallelRows(height, 16, threadCount,
+				[&workers](auto &&worker) { workers.emplace_back(std::forward<decltype(worker)>(worker)); },
+				[&rendered](const std::int32_t firstRow, const std::int32_t rowCount)
+				{
+					CHECK(rowCount > 0);
+					CHECK(rowCount <= 16);
+					for (std::int32_t y{firstRow}; y < firstRow + rowCount; ++y) ++rendered[y];
+				});
+
+			INFO("height " << height << " threads " << threadCount);
+			for (const auto &count : rendered) REQUIRE(count == 1);
+			// the calling thread takes part, and there are never more threads than bands
+			CHECK(static_cast<std::int32_t>(workers.size()) == std::max(0, std::min(threadCount, (height + 15) / 16) - 1));
+		}
+	}
+}
+
+TEST_CASE("C4ParallelRows does not wait for workers to start", "[C4ParallelRows]")
+{
+	// workers that have not been started yet when all bands are done must neither be waited for nor render anything
+	std::vector<std::function<void()>> deferred;
+	std::int32_t rendered{0};
+	C4ParallelRows(100, 16, 4,
+		[&deferred](auto &&worker) { deferred.emplace_back(std::forward<decltype(worker)>(worker)); },
+		[&rendered](const std::int32_t, const std::int32_t rowCount) { rendered += rowCount; });
+
+	CHECK(deferred.size() == 3);
+	CHECK(rendered == 100);
+
+	for (const auto &worker : deferred) worker();
+	CHECK(rendered == 100);
+}
+
+TEST_CASE("C4ParallelRows renders the same map with one and multiple threads", "[C4ParallelRows]")
+{
+	constexpr std::int32_t Width{333}, Height{211}, Pitch{336};
+	const Rendering serial{Render(Width, Height, Pitch, 1)};
+	for (const std::int32_t threadCount : {2, 3, 8})
+	{
+		const Rendering parallel{Render(Width, Height, Pitch, threadCount)};
+		INFO("threads " << threadCount);
+		CHECK(parallel.Pixels == serial.Pixels);
+		CHECK(parallel.Callbacks == serial.Callbacks);
+	}
+}
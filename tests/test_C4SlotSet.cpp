@@ -0,0 +1,137 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4SlotSet.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+	struct Slot
+	{
+		std::int32_t Value;
+	};
+
+	// mirrors C4MassMoverSet: executing a slot may create a new slot after the last created one, growing the set if all slots are in use
+	class Set
+	{
+		C4SlotSet<Slot> slots;
+		std::int32_t createPtr{0};
+
+	public:
+		std::vector<std::int32_t> Executed;
+		std::int32_t Branches{1}; // number of slots created by each slot with a positive value
+
+		explicit Set(const std::int32_t size) { slots.Resize(size, Slot{-1}); }
+
+		C4SlotSet<Slot> &Slots() { return slots; }
+
+		std::int32_t Create(const std::int32_t value)
+		{
+			std::int32_t slot{slots.NextFree(createPtr + 1, slots.Size())};
+			if (slot == -1) slot = slots.NextFree(0, std::min(createPtr + 1, slots.Size()));
+			if (slot == -1)
+			{
+				slot = slots.Size();
+				slots.Resize(slot + 1, Slot{-1});
+			}
+			slots[slot].Value = value;
+			slots.SetUsed(slot, true);
+			createPtr = slot;
+			return slot;
+		}
+
+		// each slot with a positive value creates Branches slots with the next lower value
+		void Execute()
+		{
+			for (std::int32_t slot{slots.PrevUsed(slots.Size())}; slot >= 0; slot = slots.PrevUsed(slot))
+			{
+				Slot &current{slots[slot]};
+				if (current.Value > 0)
+					for (std::int32_t i{0}; i < Branches; ++i)
+						Create(current.Value - 1);
+				// the set may have grown, but current must still be valid
+				Executed.push_back(current.Value);
+				current.Value = -1;
+				slots.SetUsed(slot, false);
+			}
+		}
+	};
+}
+
+TEST_CASE("C4SlotSet finds used and free slots", "[C4SlotSet]")
+{
+	C4SlotSet<Slot> slots;
+	slots.Resize(200, Slot{-1});
+	CHECK(slots.PrevUsed(200) == -1);
+	CHECK(slots.NextFree(0, 200) == 0);
+
+	for (const std::int32_t slot : {0, 63, 64, 130, 199})
+		slots.SetUsed(slot, true);
+	CHECK(slots.PrevUsed(200) == 199);
+	CHECK(slots.PrevUsed(199) == 130);
+	CHECK(slots.PrevUsed(130) == 64);
+	CHECK(slots.PrevUsed(64) == 63);
+	CHECK(slots.PrevUsed(63) == 0);
+	CHECK(slots.PrevUsed(0) == -1);
+
+	CHECK(slots.NextFree(63, 200) == 65);
+	CHECK(slots.NextFree(130, 131) == -1);
+	CHECK(slots.NextFree(199, 200) == -1);
+
+	// shrinking drops the bits of the removed slots, so they are free when added again
+	slots.SetUsed(199, false);
+	slots.Resize(150, Slot{-1});
+	slots.Resize(200, Slot{-1});
+	CHECK(slots.PrevUsed(200) == 130);
+	CHECK(slots.NextFree(131, 200) == 131);
+}
+
+TEST_CASE("C4SlotSet keeps slots in place while growing during execution", "[C4SlotSet]")
+{
+	Set set{4};
+	for (std::int32_t i{0}; i < 4; ++i)
+		set.Create(100);
+	const Slot *const first{&set.Slots()[0]};
+
+	// the first executed slot has to add a slot at the end
+	set.Execute();
+	CHECK(set.Slots().Size() == 5);
+	CHECK(&set.Slots()[0] == first);
+	CHECK(set.Executed == std::vector<std::int32_t>{100, 100, 100, 100});
+
+	// every slot with a value creates two new slots, so the set keeps growing while being executed
+	set.Executed.clear();
+	set.Branches = 2;
+	std::int32_t slot{set.Slots().PrevUsed(set.Slots().Size())};
+	while (slot != -1)
+	{
+		set.Slots()[slot].Value = -1;
+		set.Slots().SetUsed(slot, false);
+		slot = set.Slots().PrevUsed(slot);
+	}
+	set.Create(10);
+	while (set.Slots().PrevUsed(set.Slots().Size()) != -1)
+		set.Execute();
+	// each slot is executed exactly once
+	CHECK(set.Executed.size() == 2047);
+	CHECK(std::ranges::count(set.Executed, 0) == 1024);
+	CHECK(set.Slots().Size() > 500);
+	CHECK(&set.Slots()[0] == first);
+}
@@ -0,0 +1,185 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4SolidityBitplane.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// reference landscape that is checked pixel by pixel
+	struct Grid
+	{
+		std::int32_t Width, Height;
+		std::vector<bool> Solid;
+
+		bool IsSolid(const std::int32_t x, const std::int32_t y) const
+		{
+			// the landscape border is solid here; GetFreeSpan must not report it as free either way
+			if (x < 0 || y < 0 || x >= Width || y >= Height) return true;
+			return Solid[y * Width + x];
+		}
+	};
+
+	Grid MakeGrid(std::mt19937 &rng, const std::int32_t width, const std::int32_t height, C4SolidityBitplane &plane)
+	{
+		Grid grid{width, height, std::vector<bool>(width * height)};
+		plane.Init(width, height);
+		// sparse noise plus some solid boxes, so there are both short and long free runs
+		std::bernoulli_distribution noise{0.02};
+		for (std::int32_t i{0}; i < width * height; ++i) grid.Solid[i] = noise(rng);
+		std::uniform_int_distribution<std::int32_t> posX{0, width - 1}, posY{0, height - 1}, size{1, 40};
+		for (std::int32_t box{0}; box < 20; ++box)
+		{
+			const std::int32_t x0{posX(rng)}, y0{posY(rng)}, w{size(rng)}, h{size(rng)};
+			for (std::int32_t y{y0}; y < std::min(height, y0 + h); ++y)
+				for (std::int32_t x{x0}; x < std::min(width, x0 + w); ++x)
+					grid.Solid[y * width + x] = true;
+		}
+		for (std::int32_t y{0}; y < height; ++y)
+			for (std::int32_t x{0}; x < width; ++x)
+				plane.Set(x, y, grid.Solid[y * width + x]);
+		return grid;
+	}
+
+	struct Shape
+	{
+		std::vector<std::int32_t> VtxX, VtxY;
+
+		bool Contact(const Grid &grid, const std::int32_t x, const std::int32_t y) const
+		{
+			for (std::size_t i{0}; i < VtxX.size(); ++i)
+				if (grid.IsSolid(x + VtxX[i], y + VtxY[i])) return true;
+			return false;
+		}
+
+		std::int32_t FreeSteps(const C4SolidityBitplane &plane, const std::int32_t x, const std::int32_t y, const std::int32_t dx, const std::int32_t dy, std::int32_t max) const
+		{
+			for (std::size_t i{0}; i < VtxX.size() && max; ++i)
+				max = plane.GetFreeSpan(x + VtxX[i] + dx, y + VtxY[i] + dy, dx, dy, max);
+			return max;
+		}
+	};
+
+	struct MoveResult
+	{
+		std::int32_t X, Y;
+		std::int32_t ContactChecks;
+
+		bool operator==(const MoveResult &other) const { return X == other.X && Y == other.Y; }
+	};
+
+	// mirrors the unattached movement loop of C4Object::DoMovement
+	MoveResult Move(const Grid &grid, const C4SolidityBitplane *const plane, const Shape &shape, std::int32_t x, std::int32_t y, std::int32_t tx, std::int32_t ty)
+	{
+		std::int32_t checks{0};
+		const auto step = [&](std::int32_t &pos, std::int32_t &target, const bool horizontal)
+		{
+			while (pos != target)
+			{
+				const std::int32_t dir{target > pos ? 1 : -1};
+				if (plane)
+				{
+					const std::int32_t skip{shape.FreeSteps(*plane, x, y, horizontal ? dir : 0, horizontal ? 0 : dir, std::abs(target - pos)) - 1};
+					if (skip > 0) pos += dir * skip;
+				}
+				++checks;
+				if (shape.Contact(grid, horizontal ? pos + dir : x, horizontal ? y : pos + dir))
+					target = pos;
+				else
+					pos += dir;
+			}
+		};
+		step(x, tx, true);
+		step(y, ty, false);
+		return {x, y, checks};
+	}
+}
+
+TEST_CASE("C4SolidityBitplane finds the same free spans as a pixel by pixel scan", "[C4SolidityBitplane]")
+{
+	std::mt19937 rng{4711};
+	C4SolidityBitplane plane;
+	const Grid grid{MakeGrid(rng, 317, 203, plane)};
+
+	for (std::int32_t y{0}; y < grid.Height; ++y)
+		for (std::int32_t x{0}; x < grid.Width; ++x)
+			REQUIRE(plane.Get(x, y) == grid.IsSolid(x, y));
+
+	std::uniform_int_distribution<std::int32_t> posX{-5, grid.Width + 4}, posY{-5, grid.Height + 4}, dir{0, 3}, max{0, 400};
+	for (std::int32_t i{0}; i < 20000; ++i)
+	{
+		const std::int32_t x{posX(rng)}, y{posY(rng)}, d{dir(rng)}, m{max(rng)};
+		const std::int32_t dx{d == 0 ? 1 : d == 1 ? -1 : 0}, dy{d == 2 ? 1 : d == 3 ? -1 : 0};
+
+		std::int32_t expected{0};
+		while (expected < m && !grid.IsSolid(x + dx * expected, y + dy * expected)) ++expected;
+
+		INFO("x " << x << " y " << y << " dx " << dx << " dy " << dy << " max " << m);
+		REQUIRE(plane.GetFreeSpan(x, y, dx, dy, m) == expected);
+	}
+}
+
+TEST_CASE("C4SolidityBitplane keeps rows and columns in sync", "[C4SolidityBitplane]")
+{
+	C4SolidityBitplane plane;
+	plane.Init(130, 70);
+	CHECK(plane.GetFreeSpan(0, 5, 1, 0, 1000) == 130);
+	CHECK(plane.GetFreeSpan(64, 69, 0, -1, 1000) == 70);
+
+	plane.Set(64, 5, true);
+	CHECK(plane.GetFreeSpan(0, 5, 1, 0, 1000) == 64);
+	CHECK(plane.GetFreeSpan(129, 5, -1, 0, 1000) == 65);
+	CHECK(plane.GetFreeSpan(64, 69, 0, -1, 1000) == 64);
+	CHECK(plane.GetFreeSpan(64, 0, 0, 1, 1000) == 5);
+
+	plane.Set(64, 5, false);
+	CHECK(plane.GetFreeSpan(0, 5, 1, 0, 1000) == 130);
+	CHECK(plane.GetFreeSpan(64, 0, 0, 1, 1000) == 70);
+}
+
+TEST_CASE("Movement that skips free spans ends where stepwise movement ends", "[C4SolidityBitplane]")
+{
+	std::mt19937 rng{815};
+	C4SolidityBitplane plane;
+	const Grid grid{MakeGrid(rng, 400, 300, plane)};
+
+	std::uniform_int_distribution<std::int32_t> posX{0, grid.Width - 1}, posY{0, grid.Height - 1}, vtx{-6, 6}, vtxCount{0, 6}, dist{-150, 150};
+	std::int32_t stepwiseChecks{0}, skippingChecks{0};
+	for (std::int32_t i{0}; i < 5000; ++i)
+	{
+		Shape shape;
+		for (std::int32_t n{vtxCount(rng)}; n > 0; --n)
+		{
+			shape.VtxX.push_back(vtx(rng));
+			shape.VtxY.push_back(vtx(rng));
+		}
+		const std::int32_t x{posX(rng)}, y{posY(rng)}, tx{x + dist(rng)}, ty{y + dist(rng)};
+
+		const MoveResult stepwise{Move(grid, nullptr, shape, x, y, tx, ty)};
+		const MoveResult skipping{Move(grid, &plane, shape, x, y, tx, ty)};
+		INFO("from " << x << "/" << y << " to " << tx << "/" << ty);
+		REQUIRE(stepwise == skipping);
+		stepwiseChecks += stepwise.ContactChecks;
+		skippingChecks += skipping.ContactChecks;
+	}
+	CHECK(skippingChecks < stepwiseChecks);
+}
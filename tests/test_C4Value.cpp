@@ -0,0 +1,216 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Value.h"
+#include "C4Aul.h"
+#include "C4Group.h"
+#include "C4Object.h"
+#include "C4ValueHash.h"
+#include "C4StringTable.h"
+#include "StdCompiler.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Values only refer to the game through the lookups defined below, so
+// objects are never constructed; only their addresses and numbers are used.
+C4ObjectHandleTable ObjectHandles;
+
+namespace
+{
+	struct alignas(C4Object) ObjectStorage
+	{
+		std::byte Data[sizeof(C4Object)];
+	};
+
+	std::deque<ObjectStorage> Objects;
+	std::map<C4Object *, std::uint32_t> ObjectSlots;
+
+	C4Object *FakeObject(const std::int32_t number)
+	{
+		C4Object *const obj{reinterpret_cast<C4Object *>(Objects.emplace_back().Data)};
+		obj->Number = number; // used as the hash of object values
+		ObjectSlots.emplace(obj, ObjectHandles.Register(obj));
+		return obj;
+	}
+
+	void RemoveObject(C4Object *const obj)
+	{
+		ObjectHandles.Invalidate(ObjectSlots.at(obj));
+	}
+
+	std::string Decompile(const C4Value &value)
+	{
+		return DecompileToBuf<StdCompilerINIWrite>(mkNamingAdapt(mkNamingAdapt(const_cast<C4Value &>(value), "Value"), "Test"));
+	}
+
+	// all entries in foreach order
+	std::vector<std::pair<C4Value, C4Value>> Entries(C4ValueHash &map)
+	{
+		std::vector<std::pair<C4Value, C4Value>> entries;
+		C4ValueInt position{0};
+		C4Value key, value;
+		while (map.ForeachNext(position, key, value))
+			entries.emplace_back(key, value);
+		return entries;
+	}
+}
+
+C4ObjectHandle C4Value::GetObjectHandle(C4Object *const pObj)
+{
+	return ObjectHandles.GetHandle(ObjectSlots.at(pObj));
+}
+
+std::int32_t C4Value::GetObjectNumber(C4Object *const pObj)
+{
+	const auto it = ObjectSlots.find(pObj);
+	return it != ObjectSlots.end() ? static_cast<std::int32_t>(it->second) : 0;
+}
+
+C4Object *C4Value::GetObjectByNumber(const std::int32_t iNumber)
+{
+	return ObjectHandles.Get(ObjectHandles.GetHandle(static_cast<std::uint32_t>(iNumber)));
+}
+
+C4StringTable &C4Value::GetStringTable()
+{
+	static C4StringTable strings;
+	return strings;
+}
+
+// the script engine, groups and objects aren't linked; none of these are reached by the tests
+C4AulError::C4AulError() {}
+void C4AulError::show() const {}
+C4AulExecError::C4AulExecError(C4Object *const pObj, const std::string_view error) : cObj{pObj} { message = error; }
+void C4AulExecError::show() const {}
+const char *C4Object::GetName() { return ""; }
+bool C4Group::LoadEntry(const char *, char **, size_t *, int) { return false; }
+bool C4Group::Add(const char *, void *, size_t, bool, bool, time_t, bool) { return false; }
+
+TEST_CASE("C4Value holding a removed object reads as nil", "[C4Value]")
+{
+	C4Object *const obj{FakeObject(1)};
+	C4Object *const other{FakeObject(2)};
+	const C4Value value{C4VObj(obj)};
+	REQUIRE(value.GetType() == C4V_C4Object);
+	REQUIRE(value);
+	REQUIRE(value.Equals(C4VObj(obj), C4AulScriptStrict::MAXSTRICT));
+
+	RemoveObject(obj);
+	CHECK(value.GetType() == C4V_Any);
+	CHECK_FALSE(value);
+	CHECK(value.Equals(C4Value{}, C4AulScriptStrict::MAXSTRICT));
+	CHECK(C4Value{}.Equals(value, C4AulScriptStrict::MAXSTRICT));
+	CHECK_FALSE(value.Equals(C4VObj(other), C4AulScriptStrict::NONSTRICT));
+	CHECK_FALSE(value.Equals(C4VInt(1), C4AulScriptStrict::NONSTRICT));
+
+	SECTION("Copies are nil")
+	{
+		const C4Value copy{value};
+		CHECK(copy.GetType() == C4V_Any);
+		CHECK_FALSE(copy);
+
+		C4Value assigned{C4VInt(1)};
+		assigned = value;
+		CHECK(assigned.GetType() == C4V_Any);
+		CHECK_FALSE(assigned);
+	}
+
+	SECTION("References read as nil")
+	{
+		C4Value variable{C4VObj(other)};
+		const C4Value ref{variable.GetRef()};
+		RemoveObject(other);
+		CHECK(ref.GetType() == C4V_Any);
+		CHECK_FALSE(ref);
+	}
+}
+
+TEST_CASE("C4Value writes removed objects as nil", "[C4Value]")
+{
+	C4Object *const obj{FakeObject(3)};
+	C4Value value{C4VObj(obj)};
+	REQUIRE(Decompile(value) != Decompile(C4Value{}));
+
+	RemoveObject(obj);
+	CHECK(Decompile(value) == Decompile(C4Value{}));
+}
+
+TEST_CASE("C4ValueHash drops entries holding removed objects", "[C4Value]")
+{
+	C4Object *const keyObj{FakeObject(4)};
+	C4Object *const valueObj{FakeObject(5)};
+	C4Object *const kept{FakeObject(6)};
+
+	const C4Value mapValue{C4VMap(new C4ValueHash)};
+	C4ValueHash &map{*mapValue._getMap()};
+	map[C4VInt(1)] = C4VInt(10);
+	map[C4VObj(keyObj)] = C4VInt(20);
+	map[C4VInt(3)] = C4VObj(valueObj);
+	map[C4VInt(4)] = C4VObj(kept);
+	map[C4VInt(5)] = C4VInt(50);
+	REQUIRE(map.size() == 5);
+
+	RemoveObject(keyObj);
+	RemoveObject(valueObj);
+
+	SECTION("size")
+	{
+		CHECK(map.size() == 3);
+	}
+
+	SECTION("operator[]")
+	{
+		const C4ValueHash &constMap{map};
+		CHECK_FALSE(constMap[C4VInt(3)]);
+		CHECK(map.size() == 3);
+		CHECK_FALSE(map.contains(C4VInt(3)));
+		CHECK(constMap[C4VInt(4)].Equals(C4VObj(kept), C4AulScriptStrict::MAXSTRICT));
+
+		// assigning a removed key again adds a new entry
+		map[C4VInt(3)] = C4VInt(30);
+		CHECK(map.size() == 4);
+	}
+
+	SECTION("ForeachNext")
+	{
+		const auto entries = Entries(map);
+		REQUIRE(entries.size() == 3);
+		CHECK(entries[0].first._getInt() == 1);
+		CHECK(entries[0].second._getInt() == 10);
+		CHECK(entries[1].first._getInt() == 4);
+		CHECK(entries[1].second.Equals(C4VObj(kept), C4AulScriptStrict::MAXSTRICT));
+		CHECK(entries[2].first._getInt() == 5);
+		CHECK(entries[2].second._getInt() == 50);
+	}
+
+	SECTION("Entries added later come last")
+	{
+		map[C4VInt(2)] = C4VInt(60);
+		const auto entries = Entries(map);
+		REQUIRE(entries.size() == 4);
+		CHECK(entries[0].first._getInt() == 1);
+		CHECK(entries[1].first._getInt() == 4);
+		CHECK(entries[2].first._getInt() == 5);
+		CHECK(entries[3].first._getInt() == 2);
+	}
+}
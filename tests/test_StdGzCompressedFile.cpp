@@ -0,0 +1,115 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "CStdFile.h"
+#include "StdGzCompressedFile.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// compressible, but not so much that the whole file is one deflate block
+	std::vector<std::uint8_t> MakeData(const std::size_t size)
+	{
+		std::mt19937 rng{1234};
+		std::vector<std::uint8_t> data(size);
+		for (std::size_t i{0}; i < size; ++i)
+		{
+			data[i] = static_cast<std::uint8_t>(rng() % 16 + (i / 4096) % 64);
+		}
+		return data;
+	}
+
+	struct TempFile
+	{
+		std::string Path{(std::filesystem::temp_directory_path() / "test_StdGzCompressedFile.c4g").string()};
+
+		explicit TempFile(const std::vector<std::uint8_t> &data)
+		{
+			StdGzCompressedFile::Write file{Path};
+			file.WriteData(data.data(), data.size());
+		}
+
+		~TempFile() { std::filesystem::remove(Path); }
+	};
+}
+
+TEST_CASE("StdGzCompressedFile::Read seeks to the same data as reading from the start", "[StdGzCompressedFile]")
+{
+	const auto data = MakeData(6 * 1024 * 1024 + 123);
+	const TempFile tempFile{data};
+
+	StdGzCompressedFile::Read file{tempFile.Path};
+	std::vector<std::uint8_t> read(data.size());
+	REQUIRE(file.ReadData(read.data(), read.size()) == data.size());
+	REQUIRE(read == data);
+	CHECK(file.CheckpointCount() > 4);
+
+	std::mt19937 rng{42};
+	std::uniform_int_distribution<std::size_t> offsets{0, data.size() - 1};
+	for (std::int32_t i{0}; i < 200; ++i)
+	{
+		const std::size_t offset{offsets(rng)};
+		const std::size_t size{std::min<std::size_t>(1000, data.size() - offset)};
+		file.Seek(offset);
+		REQUIRE(file.Tell() == offset);
+
+		std::vector<std::uint8_t> chunk(size);
+		INFO("offset " << offset);
+		REQUIRE(file.ReadData(chunk.data(), size) == size);
+		REQUIRE(std::equal(chunk.begin(), chunk.end(), data.begin() + offset));
+	}
+
+	// the end of the stream is still detected after resuming at a checkpoint
+	file.Seek(data.size() - 10);
+	std::uint8_t rest[20];
+	CHECK(file.ReadData(rest, sizeof(rest)) == 10);
+	CHECK_THROWS_AS(file.Seek(data.size() + 1), StdGzCompressedFile::Exception);
+}
+
+TEST_CASE("CStdFile seeks in compressed files", "[StdGzCompressedFile]")
+{
+	const auto data = MakeData(2 * 1024 * 1024);
+	const TempFile tempFile{data};
+
+	CStdFile file;
+	REQUIRE(file.Open(tempFile.Path.c_str(), true));
+
+	// the checkpoints are built while reading forwards
+	std::uint8_t byte;
+	REQUIRE(file.Advance(data.size() - 1));
+	REQUIRE(file.Read(&byte, 1));
+	CHECK(byte == data.back());
+
+	for (const std::size_t offset : {std::size_t{1500000}, std::size_t{10}, std::size_t{1000000}, std::size_t{1000001}, std::size_t{999999}})
+	{
+		REQUIRE(file.Seek(offset));
+		CHECK(file.Tell() == offset);
+		REQUIRE(file.Read(&byte, 1));
+		CHECK(byte == data[offset]);
+	}
+
+	REQUIRE(file.Seek(100));
+	REQUIRE(file.Advance(700000));
+	REQUIRE(file.Read(&byte, 1));
+	CHECK(byte == data[700100]);
+	file.Close();
+}
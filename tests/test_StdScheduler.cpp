@@ -0,0 +1,185 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "StdScheduler.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#ifdef __linux__
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+	// stand-in for a network peer: a pipe that becomes readable when "data arrives"
+	class PipeProc : public StdSchedulerProc
+	{
+	public:
+		explicit PipeProc(const bool tracked) : tracked{tracked} { Open(); }
+		~PipeProc() override { Close(); }
+
+		bool Execute(int = -1) override
+		{
+			char buf[64];
+			while (read(pipe[0], buf, sizeof(buf)) > 0);
+			++executed;
+			return true;
+		}
+
+		void GetFDs(std::vector<pollfd> &fds) override
+		{
+			fds.push_back({.fd = pipe[0], .events = POLLIN});
+		}
+
+		int GetFDsRevision() override { return tracked ? revision : -1; }
+
+		void Signal()
+		{
+			const char c{1};
+			REQUIRE(write(pipe[1], &c, 1) == 1);
+		}
+
+		// closes and reopens the pipe, most likely getting the same FD numbers again
+		void Reopen()
+		{
+			Close();
+			Open();
+		}
+
+		std::int32_t executed{0};
+
+	private:
+		void Open()
+		{
+			REQUIRE(pipe2(pipe, O_NONBLOCK | O_CLOEXEC) == 0);
+			++revision;
+		}
+
+		void Close()
+		{
+			close(pipe[0]);
+			close(pipe[1]);
+		}
+
+		bool tracked;
+		int pipe[2];
+		int revision{0};
+	};
+
+	struct Peers
+	{
+		StdScheduler Scheduler;
+		std::vector<std::unique_ptr<PipeProc>> Procs;
+
+		Peers(const std::size_t count, const bool epoll, const bool tracked)
+		{
+			Scheduler.SetEpoll(epoll);
+			for (std::size_t i{0}; i < count; ++i)
+			{
+				Scheduler.Add(Procs.emplace_back(std::make_unique<PipeProc>(tracked)).get());
+			}
+		}
+
+		std::int32_t TotalExecuted() const
+		{
+			std::int32_t total{0};
+			for (const auto &proc : Procs) total += proc->executed;
+			return total;
+		}
+	};
+
+	// time from a peer becoming readable until the scheduler has executed it
+	std::chrono::nanoseconds TimeWakeup(const std::size_t peerCount, const bool epoll, const bool tracked, const std::int32_t wakeupCount)
+	{
+		Peers peers{peerCount, epoll, tracked};
+		// let the epoll backend register everything
+		peers.Scheduler.Execute(0);
+
+		const auto start = std::chrono::steady_clock::now();
+		for (std::int32_t i{0}; i < wakeupCount; ++i)
+		{
+			peers.Procs[(i * 7919) % peerCount]->Signal();
+			peers.Scheduler.Execute(-1);
+		}
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+
+		REQUIRE(peers.TotalExecuted() == wakeupCount);
+		return elapsed / wakeupCount;
+	}
+}
+
+TEST_CASE("StdScheduler only executes signaled processes", "[StdScheduler]")
+{
+	const bool epoll{GENERATE(false, true)};
+	const bool tracked{GENERATE(false, true)};
+	Peers peers{64, epoll, tracked};
+
+	CHECK(peers.Scheduler.Execute(0));
+	CHECK(peers.TotalExecuted() == 0);
+
+	peers.Procs[3]->Signal();
+	peers.Procs[42]->Signal();
+	CHECK(peers.Scheduler.Execute(-1));
+	CHECK(peers.Procs[3]->executed == 1);
+	CHECK(peers.Procs[42]->executed == 1);
+	CHECK(peers.TotalExecuted() == 2);
+
+	SECTION("Reopened FDs are picked up")
+	{
+		peers.Procs[10]->Reopen();
+		peers.Procs[10]->Signal();
+		CHECK(peers.Scheduler.Execute(1000));
+		CHECK(peers.Procs[10]->executed == 1);
+	}
+
+	SECTION("Removed processes are not executed")
+	{
+		peers.Procs[5]->Signal();
+		peers.Scheduler.Remove(peers.Procs[5].get());
+		peers.Procs[6]->Signal();
+		CHECK(peers.Scheduler.Execute(-1));
+		CHECK(peers.Procs[5]->executed == 0);
+		CHECK(peers.Procs[6]->executed == 1);
+	}
+
+	SECTION("UnBlock wakes the scheduler")
+	{
+		peers.Scheduler.UnBlock();
+		CHECK(peers.Scheduler.Execute(-1));
+		CHECK(peers.TotalExecuted() == 2);
+	}
+}
+
+TEST_CASE("StdScheduler wakeup latency with many peers", "[StdScheduler][.][benchmark]")
+{
+	constexpr std::int32_t WakeupCount{20000};
+	for (const std::size_t peerCount : {8, 64, 256, 1024})
+	{
+		const auto poll = TimeWakeup(peerCount, false, true, WakeupCount);
+		const auto epollUntracked = TimeWakeup(peerCount, true, false, WakeupCount);
+		const auto epoll = TimeWakeup(peerCount, true, true, WakeupCount);
+		std::cout << peerCount << " peers: " << poll.count() << " ns per wakeup with poll, "
+			<< epollUntracked.count() << " ns with epoll (untracked FDs), " << epoll.count() << " ns with epoll" << std::endl;
+	}
+}
+
+#endif
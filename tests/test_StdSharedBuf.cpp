@@ -0,0 +1,116 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "StdBuf.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+	StdBuf MakePacket(const std::size_t size)
+	{
+		StdBuf buf;
+		buf.New(size);
+		std::iota(buf.getMPtr<std::uint8_t>(), buf.getMPtr<std::uint8_t>() + size, std::uint8_t{0});
+		return buf;
+	}
+
+	// stand-in for the per-peer outgoing packet lists of the host
+	template<typename Buf>
+	struct Peers
+	{
+		std::vector<std::vector<Buf>> Queues;
+
+		explicit Peers(const std::size_t count) : Queues(count) {}
+
+		void Broadcast(const Buf &packet)
+		{
+			for (auto &queue : Queues) queue.emplace_back(packet);
+		}
+
+		void Acknowledge()
+		{
+			for (auto &queue : Queues) queue.clear();
+		}
+	};
+
+	// host CPU time per broadcast, including the release of the queued packets
+	template<typename Buf>
+	std::chrono::nanoseconds TimeBroadcast(const std::size_t clientCount, const std::size_t packetSize, const std::int32_t broadcastCount)
+	{
+		Peers<Buf> peers{clientCount};
+		const StdBuf payload{MakePacket(packetSize)};
+		const auto start = std::chrono::steady_clock::now();
+		for (std::int32_t i{0}; i < broadcastCount; ++i)
+		{
+			// the packet is serialized once per broadcast in both cases
+			peers.Broadcast(Buf{payload});
+			if (i % 16 == 15) peers.Acknowledge();
+		}
+		peers.Acknowledge();
+		return (std::chrono::steady_clock::now() - start) / broadcastCount;
+	}
+}
+
+TEST_CASE("StdSharedBuf shares its data between all copies", "[StdSharedBuf]")
+{
+	StdBuf packet{MakePacket(5000)};
+	const void *const data{packet.getData()};
+
+	// owned data is taken over
+	const StdSharedBuf shared{std::move(packet)};
+	CHECK(shared.getData() == data);
+	CHECK(shared.getSize() == 5000);
+
+	Peers<StdSharedBuf> peers{64};
+	peers.Broadcast(shared);
+	CHECK(shared.getShareCount() == 65);
+	for (const auto &queue : peers.Queues)
+	{
+		REQUIRE(queue.size() == 1);
+		CHECK(queue.front().getData() == data);
+		CHECK(queue.front().getRef() == shared.getRef());
+	}
+
+	peers.Acknowledge();
+	CHECK(shared.getShareCount() == 1);
+
+	// referenced data is copied, as the shared buffer may outlive it
+	const StdBuf ref{shared.getRef()};
+	const StdSharedBuf copy{StdBuf{ref.getRef()}};
+	CHECK(copy.getData() != data);
+	CHECK(copy.getRef() == ref);
+
+	CHECK(StdSharedBuf{}.isNull());
+	CHECK(StdSharedBuf{}.getRef().isNull());
+}
+
+TEST_CASE("Broadcasting shared buffers to many clients", "[StdSharedBuf][.][benchmark]")
+{
+	constexpr std::size_t PacketSize{16 * 1024};
+	constexpr std::int32_t BroadcastCount{2000};
+	for (const std::size_t clientCount : {1, 4, 16, 64, 256})
+	{
+		const auto copied = TimeBroadcast<StdBuf>(clientCount, PacketSize, BroadcastCount);
+		const auto shared = TimeBroadcast<StdSharedBuf>(clientCount, PacketSize, BroadcastCount);
+		std::cout << clientCount << " clients: " << copied.count() << " ns per broadcast copied, " << shared.count() << " ns shared" << std::endl;
+	}
+}